@@ -0,0 +1,53 @@
+#
+# FILE: logitbench.py -- Compare Jacobian evaluations in gambit-logit
+#
+# DESCRIPTION:
+# This Python script traces the principal branch of the logit
+# equilibrium correspondence for each of a list of games, with and
+# without quasi-Newton updating in the corrector (the -u switch to
+# gambit-logit), and tabulates the number of Jacobian evaluations per
+# unit of path length for each.
+#
+# The script is invoked as
+# logitbench.py [-p path-to-gambit-logit] game1 game2 ...
+#
+
+import sys
+import getopt
+import subprocess
+
+def TraceStatistics(program, filename, options):
+    """
+    Run gambit-logit on the game in 'filename', returning a dictionary
+    of the statistics it reports on standard error.
+    """
+    args = [ program, "-q", "-e", "-v" ] + options
+    proc = subprocess.Popen(args, stdin=open(filename),
+                            stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+    (out, err) = proc.communicate()
+    stats = { }
+    for line in err.splitlines():
+        if ":" in line:
+            (key, value) = line.split(":", 1)
+            stats[key.strip()] = float(value)
+    return stats
+
+if __name__ == '__main__':
+    program = "gambit-logit"
+    opts, args = getopt.getopt(sys.argv[1:], "p:")
+    for (opt, value) in opts:
+        if opt == "-p":
+            program = value
+
+    print "%-24s %10s %12s %10s %12s" % ("Game", "Newton", "per length",
+                                          "Broyden", "per length")
+    for filename in args:
+        newton = TraceStatistics(program, filename, [ ])
+        broyden = TraceStatistics(program, filename, [ "-u" ])
+        key = "Jacobian evaluations"
+        rate = "Jacobian evaluations per unit length"
+        print "%-24s %10d %12g %10d %12g" % (filename,
+                                             newton.get(key, 0),
+                                             newton.get(rate, 0),
+                                             broyden.get(key, 0),
+                                             broyden.get(rate, 0))
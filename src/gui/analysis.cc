@@ -35,6 +35,178 @@
 
 using namespace Gambit;
 
+//=========================================================================
+//                       class gbtProfileValues
+//=========================================================================
+
+template <class T> 
+gbtProfileValues<T>::gbtProfileValues(const MixedBehavProfile<T> &p_profile)
+  : m_decimals(-1)
+{
+  Game game = p_profile.GetGame();
+  m_numPlayers = game->NumPlayers();
+  int numNodes = game->NumNodes();
+
+  // Every node but the root is reached by exactly one action
+  m_payoffStart = 1;
+  m_nodeStart = m_payoffStart + m_numPlayers;
+  m_nodeActions = Array<int>(numNodes);
+  m_actionStart = m_nodeStart + numNodes * NodeEntries() + 2 * (numNodes - 1);
+  m_strategyStart = m_actionStart + p_profile.Length();
+  Allocate(m_strategyStart - 1);
+
+  for (int pl = 1; pl <= m_numPlayers; pl++) {
+    SetValue(m_payoffStart + pl - 1, p_profile.GetPayoff(pl));
+  }
+
+  int next = m_nodeStart + numNodes * NodeEntries();
+  List<GameNode> nodes;
+  nodes.Append(game->GetRoot());
+  while (nodes.Length() > 0) {
+    GameNode node = nodes.Remove(1);
+    m_nodeActions[node->GetNumber()] = next;
+    SetNodeValues(p_profile, node);
+    next += 2 * node->NumChildren();
+    for (int i = 1; i <= node->NumChildren(); i++) {
+      nodes.Append(node->GetChild(i));
+    }
+  }
+
+  for (int i = 1; i <= p_profile.Length(); i++) {
+    if (p_profile.IsDefinedAt(game->GetAction(i)->GetInfoset())) {
+      SetValue(m_actionStart + i - 1, p_profile[i]);
+    }
+    else {
+      SetText(m_actionStart + i - 1, "*");
+    }
+  }
+}
+
+template <class T> 
+gbtProfileValues<T>::gbtProfileValues(const MixedStrategyProfile<T> &p_profile)
+  : m_decimals(-1)
+{
+  Game game = p_profile.GetGame();
+  m_numPlayers = game->NumPlayers();
+
+  m_payoffStart = 1;
+  m_nodeStart = m_actionStart = m_strategyStart = m_payoffStart + m_numPlayers;
+  Allocate(m_strategyStart - 1 + 2 * p_profile.Length());
+
+  for (int pl = 1; pl <= m_numPlayers; pl++) {
+    SetValue(m_payoffStart + pl - 1, p_profile.GetPayoff(pl));
+  }
+
+  for (int i = 1; i <= p_profile.Length(); i++) {
+    SetValue(m_strategyStart + 2 * (i - 1), p_profile[i]);
+    SetValue(m_strategyStart + 2 * (i - 1) + 1,
+	     p_profile.GetStrategyValue(game->GetStrategy(i)));
+  }
+}
+
+template <class T> void gbtProfileValues<T>::Allocate(int p_size)
+{
+  m_values = Array<T>(p_size);
+  m_isText = Array<bool>(p_size);
+  m_text = Array<std::string>(p_size);
+  m_formatted = Array<bool>(p_size);
+  for (int i = 1; i <= p_size; i++) {
+    m_values[i] = T(0);
+    m_isText[i] = false;
+    m_formatted[i] = false;
+  }
+}
+
+//
+// Fill in the entries for p_node and the actions at it, following the
+// conventions the profile list has always used for quantities which
+// are not defined ("*") or which do not apply to the node (blank).
+//
+template <class T> void 
+gbtProfileValues<T>::SetNodeValues(const MixedBehavProfile<T> &p_profile,
+				   const GameNode &p_node)
+{
+  SetValue(NodeIndex(p_node, 0), p_profile.GetRealizProb(p_node));
+  Vector<T> values = p_profile.GetNodeValue(p_node);
+  for (int pl = 1; pl <= m_numPlayers; pl++) {
+    SetValue(NodeIndex(p_node, 3 + pl), values[pl]);
+  }
+
+  int actions = m_nodeActions[p_node->GetNumber()];
+  if (!p_node->GetPlayer()) {
+    SetText(NodeIndex(p_node, 1), "");
+    SetText(NodeIndex(p_node, 2), "");
+    SetText(NodeIndex(p_node, 3), "");
+    return;
+  }
+
+  GameInfoset infoset = p_node->GetInfoset();
+  bool reached = (p_profile.GetInfosetProb(infoset) > Rational(0));
+
+  if (reached) {
+    SetValue(NodeIndex(p_node, 1), p_profile.GetBeliefProb(p_node));
+  }
+  else {
+    // We don't compute assessments yet!
+    SetText(NodeIndex(p_node, 1), "*");
+  }
+  SetValue(NodeIndex(p_node, 2), p_profile.GetInfosetProb(infoset));
+
+  if (p_node->GetPlayer()->IsChance()) {
+    SetText(NodeIndex(p_node, 3), "");
+    for (int act = 1; act <= p_node->NumChildren(); act++) {
+      SetText(actions + 2 * (act - 1), infoset->GetActionProb<std::string>(act));
+      SetText(actions + 2 * (act - 1) + 1, "");
+    }
+    return;
+  }
+
+  if (reached) {
+    SetValue(NodeIndex(p_node, 3), p_profile.GetInfosetValue(infoset));
+  }
+  else {
+    // In the absence of beliefs, this is not well-defined in general
+    SetText(NodeIndex(p_node, 3), "*");
+  }
+
+  bool defined = p_profile.IsDefinedAt(infoset);
+  for (int act = 1; act <= p_node->NumChildren(); act++) {
+    GameAction action = infoset->GetAction(act);
+    if (defined) {
+      SetValue(actions + 2 * (act - 1), p_profile.GetActionProb(action));
+    }
+    else {
+      SetText(actions + 2 * (act - 1), "*");
+    }
+    if (reached) {
+      SetValue(actions + 2 * (act - 1) + 1, p_profile.GetActionValue(action));
+    }
+    else {
+      SetText(actions + 2 * (act - 1) + 1, "*");
+    }
+  }
+}
+
+template <class T> const std::string &
+gbtProfileValues<T>::GetText(int p_index, int p_decimals) const
+{
+  if (p_decimals != m_decimals) {
+    for (int i = 1; i <= m_formatted.Length(); m_formatted[i++] = false);
+    m_decimals = p_decimals;
+  }
+
+  if (!m_isText[p_index] && !m_formatted[p_index]) {
+    m_text[p_index] = lexical_cast<std::string>(m_values[p_index], 
+						p_decimals);
+    m_formatted[p_index] = true;
+  }
+  return m_text[p_index];
+}
+
+// Explicit instantiations
+template class gbtProfileValues<double>;
+template class gbtProfileValues<Rational>;
+
 
 
 //=========================================================================
@@ -92,29 +264,74 @@ OutputToBehavProfile(gbtGameDocument *p_doc, const wxString &p_text)
 }  // end anonymous namespace
 
 
+template <class T> void
+gbtAnalysisProfileList<T>::Append(const MixedStrategyProfile<T> &p_profile)
+{
+  m_mixedProfiles.Append(p_profile);
+  if (m_doc->IsTree()) {
+    m_behavProfiles.Append(MixedBehavProfile<T>(p_profile));
+  }
+  m_current = m_mixedProfiles.Length();
+}
+
+template <class T> void
+gbtAnalysisProfileList<T>::Append(const MixedBehavProfile<T> &p_profile)
+{
+  m_behavProfiles.Append(p_profile);
+  m_mixedProfiles.Append(MixedStrategyProfile<T>(p_profile));
+  m_current = m_behavProfiles.Length();
+}
+
 template <class T> void
 gbtAnalysisProfileList<T>::AddOutput(const wxString &p_output)
 {
   try {
     if (m_isBehav) {
-      MixedBehavProfile<T> profile(OutputToBehavProfile<T>(m_doc, p_output));
-      m_behavProfiles.Append(profile);
-      m_mixedProfiles.Append(MixedStrategyProfile<T>(profile));
-      m_current = m_behavProfiles.Length();
+      Append(OutputToBehavProfile<T>(m_doc, p_output));
     }
     else {
-      MixedStrategyProfile<T> profile(OutputToMixedProfile<T>(m_doc,
-							      p_output));
-      m_mixedProfiles.Append(profile);
-      if (m_doc->IsTree()) {
-	m_behavProfiles.Append(MixedBehavProfile<T>(profile));
-      }
-      m_current = m_mixedProfiles.Length();
+      Append(OutputToMixedProfile<T>(m_doc, p_output));
     }
   }
   catch (gbtNotNashException &) { }
 }
 
+template <class T> template <class S> void
+gbtAnalysisProfileList<T>::AddMixed(const MixedStrategyProfile<S> &p_profile)
+{
+  MixedStrategyProfile<T> profile(m_doc->GetGame());
+  for (int i = 1; i <= profile.Length(); i++) {
+    profile[i] = p_profile[i];
+  }
+  Append(profile);
+}
+
+template <class T> template <class S> void
+gbtAnalysisProfileList<T>::AddBehav(const MixedBehavProfile<S> &p_profile)
+{
+  MixedBehavProfile<T> profile(m_doc->GetGame());
+  for (int i = 1; i <= profile.Length(); i++) {
+    profile[i] = p_profile[i];
+  }
+  Append(profile);
+}
+
+template <class T> void
+gbtAnalysisProfileList<T>::AddProfile(const MixedStrategyProfile<double> &p_profile)
+{ AddMixed(p_profile); }
+
+template <class T> void
+gbtAnalysisProfileList<T>::AddProfile(const MixedStrategyProfile<Rational> &p_profile)
+{ AddMixed(p_profile); }
+
+template <class T> void
+gbtAnalysisProfileList<T>::AddProfile(const MixedBehavProfile<double> &p_profile)
+{ AddBehav(p_profile); }
+
+template <class T> void
+gbtAnalysisProfileList<T>::AddProfile(const MixedBehavProfile<Rational> &p_profile)
+{ AddBehav(p_profile); }
+
 template <class T>
 void gbtAnalysisProfileList<T>::BuildNfg(void)
 {
@@ -139,6 +356,7 @@ void gbtAnalysisProfileList<T>::Clear(void)
 {
   m_behavProfiles = List<MixedBehavProfile<T> >();
   m_mixedProfiles = List<MixedStrategyProfile<T> >();
+  ClearValues();
   m_current = 0;
 }
 
@@ -188,7 +406,8 @@ void gbtAnalysisProfileList<T>::Load(TiXmlNode *p_analysis)
   Clear();
 
   TiXmlNode *description = p_analysis->FirstChild("description");
-  if (description) {
+  // An empty description is read back with no text child
+  if (description && description->FirstChild()) {
     m_description = wxString(description->FirstChild()->Value(),
 			     *wxConvCurrent);
   }
@@ -217,6 +436,58 @@ void gbtAnalysisProfileList<T>::Load(TiXmlNode *p_analysis)
   }
 }
 
+//-------------------------------------------------------------------------
+//           gbtAnalysisProfileList: Quantities for display
+//-------------------------------------------------------------------------
+
+template <class T> const gbtProfileValues<T> &
+gbtAnalysisProfileList<T>::GetBehavValues(int p_index) const
+{
+  if (p_index < 1 || p_index > m_behavProfiles.Length()) {
+    throw IndexException();
+  }
+  if (m_behavValues.Length() < m_behavProfiles.Length()) {
+    Array<gbtProfileValues<T> *> values(m_behavProfiles.Length());
+    for (int i = 1; i <= values.Length(); i++) {
+      values[i] = (i <= m_behavValues.Length()) ? m_behavValues[i] : 0;
+    }
+    m_behavValues = values;
+  }
+  if (!m_behavValues[p_index]) {
+    m_behavValues[p_index] = 
+      new gbtProfileValues<T>(m_behavProfiles[p_index]);
+  }
+  return *m_behavValues[p_index];
+}
+
+template <class T> const gbtProfileValues<T> &
+gbtAnalysisProfileList<T>::GetMixedValues(int p_index) const
+{
+  if (p_index < 1 || p_index > m_mixedProfiles.Length()) {
+    throw IndexException();
+  }
+  if (m_mixedValues.Length() < m_mixedProfiles.Length()) {
+    Array<gbtProfileValues<T> *> values(m_mixedProfiles.Length());
+    for (int i = 1; i <= values.Length(); i++) {
+      values[i] = (i <= m_mixedValues.Length()) ? m_mixedValues[i] : 0;
+    }
+    m_mixedValues = values;
+  }
+  if (!m_mixedValues[p_index]) {
+    m_mixedValues[p_index] = 
+      new gbtProfileValues<T>(m_mixedProfiles[p_index]);
+  }
+  return *m_mixedValues[p_index];
+}
+
+template <class T> void gbtAnalysisProfileList<T>::ClearValues(void)
+{
+  for (int i = 1; i <= m_behavValues.Length(); delete m_behavValues[i++]);
+  for (int i = 1; i <= m_mixedValues.Length(); delete m_mixedValues[i++]);
+  m_behavValues = Array<gbtProfileValues<T> *>();
+  m_mixedValues = Array<gbtProfileValues<T> *>();
+}
+
 template <class T> std::string
 gbtAnalysisProfileList<T>::GetPayoff(int pl, int p_index) const
 {
@@ -224,12 +495,12 @@ gbtAnalysisProfileList<T>::GetPayoff(int pl, int p_index) const
 
   try {
     if (m_doc->IsTree()) {
-      return lexical_cast<std::string>(m_behavProfiles[index].GetPayoff(pl),
-		    m_doc->GetStyle().NumDecimals());
+      return GetBehavValues(index).GetPayoff(pl,
+					      m_doc->GetStyle().NumDecimals());
     }
     else {
-      return lexical_cast<std::string>(m_mixedProfiles[index].GetPayoff(pl),
-		    m_doc->GetStyle().NumDecimals());
+      return GetMixedValues(index).GetPayoff(pl,
+					      m_doc->GetStyle().NumDecimals());
     }
   }
   catch (IndexException &) {
@@ -244,8 +515,8 @@ gbtAnalysisProfileList<T>::GetRealizProb(const GameNode &p_node,
   int index = (p_index == -1) ? m_current : p_index;
 
   try {
-    return lexical_cast<std::string>(m_behavProfiles[index].GetRealizProb(p_node),
-		  m_doc->GetStyle().NumDecimals());
+    return GetBehavValues(index).GetRealizProb(p_node,
+					       m_doc->GetStyle().NumDecimals());
   }
   catch (IndexException &) {
     return "";
@@ -258,17 +529,9 @@ gbtAnalysisProfileList<T>::GetBeliefProb(const GameNode &p_node,
 {
   int index = (p_index == -1) ? m_current : p_index;
 
-  if (!p_node->GetPlayer()) return "";
-
   try {
-    if (m_behavProfiles[index].GetInfosetProb(p_node->GetInfoset()) > Rational(0)) {
-      return lexical_cast<std::string>(m_behavProfiles[index].GetBeliefProb(p_node),
-		    m_doc->GetStyle().NumDecimals());
-    }
-    else {
-      // We don't compute assessments yet!
-      return "*";
-    }
+    return GetBehavValues(index).GetBeliefProb(p_node,
+					       m_doc->GetStyle().NumDecimals());
   }
   catch (IndexException &) {
     return "";
@@ -282,8 +545,8 @@ gbtAnalysisProfileList<T>::GetNodeValue(const GameNode &p_node,
   int index = (p_index == -1) ? m_current : p_index;
 
   try {
-    return lexical_cast<std::string>(m_behavProfiles[index].GetNodeValue(p_node)[p_player], 
-		  m_doc->GetStyle().NumDecimals());
+    return GetBehavValues(index).GetNodeValue(p_node, p_player,
+					      m_doc->GetStyle().NumDecimals());
   }
   catch (IndexException &) {
     return "";
@@ -296,11 +559,9 @@ gbtAnalysisProfileList<T>::GetInfosetProb(const GameNode &p_node,
 {
   int index = (p_index == -1) ? m_current : p_index;
 
-  if (!p_node->GetPlayer()) return "";
-
   try {
-    return lexical_cast<std::string>(m_behavProfiles[index].GetInfosetProb(p_node->GetInfoset()),
-		  m_doc->GetStyle().NumDecimals());
+    return GetBehavValues(index).GetInfosetProb(p_node,
+						m_doc->GetStyle().NumDecimals());
   }
   catch (IndexException &) {
     return "";
@@ -313,17 +574,9 @@ gbtAnalysisProfileList<T>::GetInfosetValue(const GameNode &p_node,
 {
   int index = (p_index == -1) ? m_current : p_index;
 
-  if (!p_node->GetPlayer() || p_node->GetPlayer()->IsChance())  return "";
-
   try {
-    if (m_behavProfiles[index].GetInfosetProb(p_node->GetInfoset()) > Rational(0)) {
-      return lexical_cast<std::string>(m_behavProfiles[index].GetInfosetValue(p_node->GetInfoset()),
-		    m_doc->GetStyle().NumDecimals());
-    }
-    else {
-      // In the absence of beliefs, this is not well-defined in general
-      return "*";
-    }
+    return GetBehavValues(index).GetInfosetValue(p_node,
+						 m_doc->GetStyle().NumDecimals());
   }
   catch (IndexException &) {
     return "";
@@ -344,14 +597,8 @@ gbtAnalysisProfileList<T>::GetActionProb(const GameNode &p_node, int p_act,
   if (!p_node->GetPlayer())  return "";
   
   try {
-    const MixedBehavProfile<T> &profile = m_behavProfiles[index];
-
-    if (!profile.IsDefinedAt(p_node->GetInfoset())) {
-      return "*";
-    }
-  
-    return lexical_cast<std::string>(profile.GetActionProb(p_node->GetInfoset()->GetAction(p_act)),
-		  m_doc->GetStyle().NumDecimals());
+    return GetBehavValues(index).GetActionProb(p_node, p_act,
+					       m_doc->GetStyle().NumDecimals());
   }
   catch (IndexException &) {
     return "";
@@ -364,13 +611,8 @@ gbtAnalysisProfileList<T>::GetActionProb(int p_action, int p_index) const
   int index = (p_index == -1) ? m_current : p_index;
 
   try {
-    const MixedBehavProfile<T> &profile = m_behavProfiles[index];
-
-    if (!profile.IsDefinedAt(profile.GetGame()->GetAction(p_action)->GetInfoset())) {
-      return "*";
-    }
-    
-    return lexical_cast<std::string>(profile[p_action], m_doc->GetStyle().NumDecimals());
+    return GetBehavValues(index).GetActionProb(p_action,
+					       m_doc->GetStyle().NumDecimals());
   }
   catch (IndexException &) {
     return "";
@@ -383,17 +625,11 @@ gbtAnalysisProfileList<T>::GetActionValue(const GameNode &p_node, int p_act,
 {
   int index = (p_index == -1) ? m_current : p_index;
 
-  if (!p_node->GetPlayer() || p_node->GetPlayer()->IsChance()) return "";
+  if (!p_node->GetPlayer()) return "";
   
   try {
-    if (m_behavProfiles[index].GetInfosetProb(p_node->GetInfoset()) > Rational(0)) {
-      return lexical_cast<std::string>(m_behavProfiles[index].GetActionValue(p_node->GetInfoset()->GetAction(p_act)),
-		    m_doc->GetStyle().NumDecimals());
-    }
-    else  {
-      // In the absence of beliefs, this is not well-defined
-      return "*";
-    }
+    return GetBehavValues(index).GetActionValue(p_node, p_act,
+						m_doc->GetStyle().NumDecimals());
   }
   catch (IndexException &) {
     return "";
@@ -406,8 +642,8 @@ gbtAnalysisProfileList<T>::GetStrategyProb(int p_strategy, int p_index) const
   int index = (p_index == -1) ? m_current : p_index;
 
   try {
-    const MixedStrategyProfile<T> &profile = m_mixedProfiles[index];
-    return lexical_cast<std::string>(profile[p_strategy], m_doc->GetStyle().NumDecimals());
+    return GetMixedValues(index).GetStrategyProb(p_strategy,
+						 m_doc->GetStyle().NumDecimals());
   }
   catch (IndexException &) {
     return "";
@@ -420,10 +656,8 @@ gbtAnalysisProfileList<T>::GetStrategyValue(int p_strategy, int p_index) const
   int index = (p_index == -1) ? m_current : p_index;
 
   try {
-    const MixedStrategyProfile<T> &profile = m_mixedProfiles[index];
-    GameStrategy strategy = profile.GetGame()->GetStrategy(p_strategy);
-    return lexical_cast<std::string>(profile.GetStrategyValue(strategy),
-		  m_doc->GetStyle().NumDecimals());
+    return GetMixedValues(index).GetStrategyValue(p_strategy,
+						  m_doc->GetStyle().NumDecimals());
   }
   catch (IndexException &) {
     return "";
@@ -23,8 +23,15 @@
 #ifndef ANALYSIS_H
 #define ANALYSIS_H
 
+#include "libgambit/nash.h"
+
 class gbtGameDocument;
 
+/// A solver which can be run inside the interface, on a worker thread,
+/// instead of as an external command-line tool.  It is passed a private
+/// copy of the game, and reports profiles to the observer as it finds them.
+typedef void (*gbtNashSolver)(const Gambit::Game &, Gambit::NashObserver &);
+
 //
 // This file contains classes which manage the output of analysis tools.
 // Currently, one class is supported, which is simply a list of profiles
@@ -40,12 +47,13 @@ class gbtAnalysisOutput {
 protected:
   gbtGameDocument *m_doc;
   wxString m_label, m_description, m_command;
+  gbtNashSolver m_solver;
 
 public:
   /// @name Lifecycle
   //@{
   /// Construct a new output group
-  gbtAnalysisOutput(gbtGameDocument *p_doc) : m_doc(p_doc) { }
+  gbtAnalysisOutput(gbtGameDocument *p_doc) : m_doc(p_doc), m_solver(0) { }
   /// Clean up an output group
   virtual ~gbtAnalysisOutput() { }
   //@}
@@ -70,6 +78,13 @@ public:
   /// Set the command used to generate the list
   void SetCommand(const wxString &p_command) { m_command = p_command; }
 
+  /// Get the in-process solver for the list (null if there is none,
+  /// in which case the command is run as an external process)
+  gbtNashSolver GetSolver(void) const { return m_solver; }
+
+  /// Set the in-process solver for the list
+  void SetSolver(gbtNashSolver p_solver) { m_solver = p_solver; }
+
   /// The number of profiles in the list
   virtual int NumProfiles(void) const = 0;
 
@@ -109,6 +124,16 @@ public:
 
   virtual void AddOutput(const wxString &) = 0;
 
+  /// @name Adding profiles computed by an in-process solver
+  /// The profiles must be on the document's game; they are converted
+  /// to the representation and number type of the list as needed.
+  //@{
+  virtual void AddProfile(const Gambit::MixedStrategyProfile<double> &) = 0;
+  virtual void AddProfile(const Gambit::MixedStrategyProfile<Gambit::Rational> &) = 0;
+  virtual void AddProfile(const Gambit::MixedBehavProfile<double> &) = 0;
+  virtual void AddProfile(const Gambit::MixedBehavProfile<Gambit::Rational> &) = 0;
+  //@}
+
   /// Map all behavior profiles to corresponding mixed profiles
   virtual void BuildNfg(void) = 0;
 
@@ -116,6 +141,95 @@ public:
   virtual void Save(std::ostream &) const = 0;
 };
 
+//!
+//! The quantities shown for one profile, computed together the first
+//! time the profile is displayed instead of once per label on every
+//! paint.  They are kept as numbers in one flat table; each number is
+//! formatted the first time it is asked for, and its text kept until
+//! the number of decimal places shown changes.  Quantities which are
+//! not numbers ("*" where a value is not defined, or blank) are stored
+//! directly as text.
+//!
+template <class T> class gbtProfileValues {
+private:
+  Gambit::Array<T> m_values;
+  Gambit::Array<bool> m_isText;
+  mutable Gambit::Array<std::string> m_text;
+  mutable Gambit::Array<bool> m_formatted;
+  mutable int m_decimals;
+
+  int m_numPlayers;
+  /// Where each group of quantities starts in the table
+  int m_payoffStart, m_nodeStart, m_actionStart, m_strategyStart;
+  /// Where the quantities for the actions at each node start in the table
+  Gambit::Array<int> m_nodeActions;
+
+  /// Number of entries for each node: realization probability, belief,
+  /// information set probability and value, then the node value for
+  /// each player
+  int NodeEntries(void) const { return 4 + m_numPlayers; }
+  int NodeIndex(const Gambit::GameNode &p_node, int p_field) const
+  { return m_nodeStart + (p_node->GetNumber() - 1) * NodeEntries() + p_field; }
+
+  void Allocate(int p_size);
+  void SetValue(int p_index, const T &p_value)
+  { m_values[p_index] = p_value; }
+  void SetText(int p_index, const std::string &p_text)
+  { m_isText[p_index] = true; m_text[p_index] = p_text; }
+
+  void SetNodeValues(const Gambit::MixedBehavProfile<T> &,
+		     const Gambit::GameNode &);
+
+  const std::string &GetText(int p_index, int p_decimals) const;
+
+public:
+  /// @name Lifecycle
+  //@{
+  /// Compute the quantities for the tree representation
+  gbtProfileValues(const Gambit::MixedBehavProfile<T> &);
+  /// Compute the quantities for the strategic representation
+  gbtProfileValues(const Gambit::MixedStrategyProfile<T> &);
+  //@}
+
+  /// @name Formatted quantities
+  //@{
+  const std::string &GetPayoff(int pl, int p_decimals) const
+  { return GetText(m_payoffStart + pl - 1, p_decimals); }
+
+  const std::string &GetRealizProb(const Gambit::GameNode &p_node,
+				   int p_decimals) const
+  { return GetText(NodeIndex(p_node, 0), p_decimals); }
+  const std::string &GetBeliefProb(const Gambit::GameNode &p_node,
+				   int p_decimals) const
+  { return GetText(NodeIndex(p_node, 1), p_decimals); }
+  const std::string &GetInfosetProb(const Gambit::GameNode &p_node,
+				    int p_decimals) const
+  { return GetText(NodeIndex(p_node, 2), p_decimals); }
+  const std::string &GetInfosetValue(const Gambit::GameNode &p_node,
+				     int p_decimals) const
+  { return GetText(NodeIndex(p_node, 3), p_decimals); }
+  const std::string &GetNodeValue(const Gambit::GameNode &p_node, int pl,
+				  int p_decimals) const
+  { return GetText(NodeIndex(p_node, 3 + pl), p_decimals); }
+
+  const std::string &GetActionProb(const Gambit::GameNode &p_node, int p_act,
+				   int p_decimals) const
+  { return GetText(m_nodeActions[p_node->GetNumber()] + 2 * (p_act - 1),
+		   p_decimals); }
+  const std::string &GetActionValue(const Gambit::GameNode &p_node, int p_act,
+				    int p_decimals) const
+  { return GetText(m_nodeActions[p_node->GetNumber()] + 2 * (p_act - 1) + 1,
+		   p_decimals); }
+  const std::string &GetActionProb(int p_action, int p_decimals) const
+  { return GetText(m_actionStart + p_action - 1, p_decimals); }
+
+  const std::string &GetStrategyProb(int p_strategy, int p_decimals) const
+  { return GetText(m_strategyStart + 2 * (p_strategy - 1), p_decimals); }
+  const std::string &GetStrategyValue(int p_strategy, int p_decimals) const
+  { return GetText(m_strategyStart + 2 * (p_strategy - 1) + 1, p_decimals); }
+  //@}
+};
+
 //!
 //! This class manages a list of profiles, computed, e.g., by an
 //! algorithm for finding Nash equilibria.  It maintains two lists
@@ -128,6 +242,16 @@ private:
   int m_current;
   Gambit::List<Gambit::MixedBehavProfile<T> > m_behavProfiles;
   Gambit::List<Gambit::MixedStrategyProfile<T> > m_mixedProfiles;
+  /// Displayed quantities for each profile, computed on first use
+  mutable Gambit::Array<gbtProfileValues<T> *> m_behavValues, m_mixedValues;
+
+  const gbtProfileValues<T> &GetBehavValues(int p_index) const;
+  const gbtProfileValues<T> &GetMixedValues(int p_index) const;
+  void ClearValues(void);
+  void Append(const Gambit::MixedStrategyProfile<T> &);
+  void Append(const Gambit::MixedBehavProfile<T> &);
+  template <class S> void AddMixed(const Gambit::MixedStrategyProfile<S> &);
+  template <class S> void AddBehav(const Gambit::MixedBehavProfile<S> &);
 
 public:
   //!
@@ -138,7 +262,7 @@ public:
   gbtAnalysisProfileList(gbtGameDocument *p_doc, bool p_isBehav)
     : gbtAnalysisOutput(p_doc), m_isBehav(p_isBehav), m_current(0) { }
   /// Cleanup the profile list
-  virtual ~gbtAnalysisProfileList() { }
+  virtual ~gbtAnalysisProfileList() { ClearValues(); }
   //@}
 
   //!
@@ -184,6 +308,10 @@ public:
   //!
   //@{
   void AddOutput(const wxString &);
+  void AddProfile(const Gambit::MixedStrategyProfile<double> &);
+  void AddProfile(const Gambit::MixedStrategyProfile<Gambit::Rational> &);
+  void AddProfile(const Gambit::MixedBehavProfile<double> &);
+  void AddProfile(const Gambit::MixedBehavProfile<Gambit::Rational> &);
   /// Map all behavior profiles to corresponding mixed profiles
   void BuildNfg(void);
 
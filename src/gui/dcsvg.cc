@@ -158,6 +158,7 @@ wxSVGFileDC::~wxSVGFileDC()
 {
     wxString s = wxT("</g> \n</svg> \n") ;
     write(s);
+    flush();
     delete m_outfile ;
 }
 
@@ -838,8 +839,18 @@ wxCoord wxSVGFileDC::LogicalToDeviceYRel(wxCoord y) const
 
 void wxSVGFileDC::write(const wxString &s)
 {
+    // Each primitive is only a few dozen bytes; writing them to the
+    // stream one at a time dominates the cost of exporting large drawings
     const wxWX2MBbuf buf = s.mb_str(wxConvUTF8);
-    m_outfile->Write(buf, strlen((const char *)buf));
+    m_buffer.append((const char *)buf);
+    if (m_buffer.size() >= 65536) flush();
+}
+
+void wxSVGFileDC::flush()
+{
+    if (m_buffer.empty()) return;
+    m_outfile->Write(m_buffer.data(), m_buffer.size());
+    m_buffer.clear();
     m_OK = m_outfile->Ok();
 }
 
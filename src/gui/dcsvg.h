@@ -2,6 +2,7 @@
 #define __DCSVG_H
 #include <wx/wfstream.h>
 #include <wx/string.h>
+#include <string>
 
 /*
 #ifdef WXMAKINGDLL_SVG
@@ -27,6 +28,8 @@ class WXDLLIMPEXP_SVG wxSVGFileDC : public wxDC
     private:
         wxFileOutputStream * m_outfile ;
         wxString m_filename ;
+        //output is collected here and written to m_outfile in large chunks
+        std::string m_buffer ;
         //holds number of png format images we have
         int m_sub_images ;
         bool m_OK, m_graphics_changed ;
@@ -185,6 +188,7 @@ class WXDLLIMPEXP_SVG wxSVGFileDC : public wxDC
         }
 
         void write(const wxString &s);
+        void flush();
 
     public:
 
@@ -28,10 +28,10 @@
 #endif  // WX_PRECOMP
 #include <wx/stdpaths.h>
 #include <wx/txtstrm.h>
-#include <wx/tokenzr.h>
 
 #include "wx/sheet/sheet.h"
 #include "dlefglogit.h"
+#include "logitrecords.h"
 
 class gbtLogitBehavList : public wxSheet {
 private:
@@ -65,7 +65,10 @@ public:
   gbtLogitBehavList(wxWindow *p_parent, gbtGameDocument *p_doc);
   virtual ~gbtLogitBehavList();
 
-  void AddProfile(const wxString &p_text, bool p_forceShow);
+  void AddProfile(const Gambit::Array<double> &p_values, bool p_forceShow);
+  // Show any profiles added but not yet shown
+  void ShowProfiles(void);
+  void WriteCSV(std::ostream &p_file);
 };
 
 gbtLogitBehavList::gbtLogitBehavList(wxWindow *p_parent, 
@@ -169,7 +172,11 @@ wxSheetCellAttr gbtLogitBehavList::GetAttr(const wxSheetCoords &p_coords,
   return attr;
 }
 
-void gbtLogitBehavList::AddProfile(const wxString &p_text,
+//
+// The values are lambda followed by the profile, as in the records
+// written by gambit-logit -b
+//
+void gbtLogitBehavList::AddProfile(const Gambit::Array<double> &p_values,
 				   bool p_forceShow)
 {
   if (GetNumberCols() == 0) {
@@ -178,24 +185,40 @@ void gbtLogitBehavList::AddProfile(const wxString &p_text,
 
   Gambit::MixedBehavProfile<double> profile(m_doc->GetGame());
 
-  wxStringTokenizer tok(p_text, wxT(","));
-
-  m_lambdas.Append((double) Gambit::lexical_cast<Gambit::Rational>(std::string((const char *) tok.GetNextToken().mb_str())));
-
+  m_lambdas.Append(p_values[1]);
   for (int i = 1; i <= profile.Length(); i++) {
-    profile[i] = Gambit::lexical_cast<Gambit::Rational>(std::string((const char *) tok.GetNextToken().mb_str()));
+    profile[i] = p_values[i+1];
   }
 
   m_profiles.Append(profile);
   if (p_forceShow || m_profiles.Length() - GetNumberRows() > 20) {
-    AppendRows(m_profiles.Length() - GetNumberRows());
-    MakeCellVisible(wxSheetCoords(GetNumberRows() - 1, 0));
+    ShowProfiles();
   }
 
   // Lambda tends to get large, so this column usually needs resized
   AutoSizeCol(0);
 }
 
+void gbtLogitBehavList::ShowProfiles(void)
+{
+  if (m_profiles.Length() > GetNumberRows()) {
+    AppendRows(m_profiles.Length() - GetNumberRows());
+    MakeCellVisible(wxSheetCoords(GetNumberRows() - 1, 0));
+  }
+}
+
+void gbtLogitBehavList::WriteCSV(std::ostream &p_file)
+{
+  int decimals = m_doc->GetStyle().NumDecimals();
+  for (int i = 1; i <= m_profiles.Length(); i++) {
+    p_file << Gambit::lexical_cast<std::string>(m_lambdas[i], decimals);
+    const Gambit::MixedBehavProfile<double> &profile = m_profiles[i];
+    for (int j = 1; j <= profile.Length(); j++) {
+      p_file << "," << Gambit::lexical_cast<std::string>(profile[j], decimals);
+    }
+    p_file << std::endl;
+  }
+}
 
 const int GBT_ID_TIMER = 1000;
 const int GBT_ID_PROCESS = 1001;
@@ -261,10 +284,10 @@ void gbtLogitBehavDialog::Start(void)
   m_process->Redirect();
 
 #ifdef __WXMAC__
-  m_pid = wxExecute(wxStandardPaths::Get().GetExecutablePath() + wxT("-logit"),
+  m_pid = wxExecute(wxStandardPaths::Get().GetExecutablePath() + wxT("-logit -b"),
 		    wxEXEC_ASYNC, m_process);
 #else	
-  m_pid = wxExecute(wxT("gambit-logit"), wxEXEC_ASYNC, m_process);
+  m_pid = wxExecute(wxT("gambit-logit -b"), wxEXEC_ASYNC, m_process);
 #endif // __WXMAC__
   
   std::ostringstream s;
@@ -294,19 +317,30 @@ void gbtLogitBehavDialog::Start(void)
   m_timer.Start(1000, false);
 }
 
+//
+// Reads up to p_maxBytes of the available output of the process
+// (or all of it, if p_maxBytes is zero), and adds the profiles in it.
+//
+void gbtLogitBehavDialog::ReadOutput(int p_maxBytes, bool p_forceShow)
+{
+  ReadAvailable(m_process, m_buffer, p_maxBytes);
+
+  Gambit::List<Gambit::Array<double> > records;
+  ReadRecords(m_buffer, records);
+  for (int i = 1; i <= records.Length(); i++) {
+    m_behavList->AddProfile(records[i], false);
+  }
+  if (p_forceShow) {
+    m_behavList->ShowProfiles();
+  }
+}
+
 void gbtLogitBehavDialog::OnIdle(wxIdleEvent &p_event)
 {
   if (!m_process)  return;
 
   if (m_process->IsInputAvailable()) {
-    wxTextInputStream tis(*m_process->GetInputStream());
-
-    wxString msg;
-    msg << tis.ReadLine();
-    m_behavList->AddProfile(msg, false);
-    m_output += msg;
-    m_output += wxT("\n");
-
+    ReadOutput(65536, false);
     p_event.RequestMore();
   }
   else {
@@ -324,18 +358,7 @@ void gbtLogitBehavDialog::OnEndProcess(wxProcessEvent &p_event)
   m_stopButton->Enable(false);
   m_timer.Stop();
 
-  while (m_process->IsInputAvailable()) {
-    wxTextInputStream tis(*m_process->GetInputStream());
-
-    wxString msg;
-    msg << tis.ReadLine();
-
-    if (msg != wxT("")) {
-      m_behavList->AddProfile(msg, true);
-      m_output += msg;
-      m_output += wxT("\n");
-    }
-  }
+  ReadOutput(0, true);
 
   if (p_event.GetExitCode() == 0) {
     m_statusText->SetLabel(wxT("The computation has completed."));
@@ -373,6 +396,6 @@ void gbtLogitBehavDialog::OnSave(wxCommandEvent &)
 
   if (dialog.ShowModal() == wxID_OK) {
     std::ofstream file((const char *) dialog.GetPath().mb_str());
-    file << ((const char *) m_output.mb_str());
+    m_behavList->WriteCSV(file);
   }
 }
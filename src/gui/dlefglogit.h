@@ -37,7 +37,7 @@ private:
   wxStaticText *m_statusText;
   wxButton *m_stopButton, *m_okButton, *m_saveButton;
   wxTimer m_timer;
-  wxString m_output;
+  std::string m_buffer;      // output not yet made into profiles
     
   void OnStop(wxCommandEvent &);
   void OnTimer(wxTimerEvent &);
@@ -46,6 +46,7 @@ private:
   void OnSave(wxCommandEvent &);
 
   void Start(void);
+  void ReadOutput(int p_maxBytes, bool p_forceShow);
 
 public:
   gbtLogitBehavDialog(wxWindow *p_parent, gbtGameDocument *p_doc);
@@ -29,6 +29,9 @@
 #include <wx/stdpaths.h>
 
 #include "dlnash.h"
+#include "tools/enumpure/purenash.h"
+#include "tools/lcp/nfglcp.h"
+#include "tools/lp/nfglp.h"
 
 static wxString s_recommended(wxT("with Gambit's recommended method"));
 static wxString s_enumpure(wxT("by looking for pure strategy equilibria"));
@@ -40,6 +43,24 @@ static wxString s_liap(wxT("by minimizing the Lyapunov function"));
 static wxString s_logit(wxT("by tracing logit equilibria"));
 static wxString s_simpdiv(wxT("by simplicial subdivision"));
 
+//
+// In-process versions of "gambit-lp -S" and "gambit-lcp -S", with the
+// tools' default options
+//
+static void LpSolve(const Gambit::Game &p_game, 
+		    Gambit::NashObserver &p_observer)
+{
+  p_game->BuildComputedValues();
+  LpStrategySolve<Gambit::Rational>(p_game, p_observer);
+}
+
+static void LcpSolve(const Gambit::Game &p_game, 
+		     Gambit::NashObserver &p_observer)
+{
+  p_game->BuildComputedValues();
+  LcpStrategySolve<Gambit::Rational>(p_game, 0, 0, p_observer);
+}
+
 gbtNashChoiceDialog::gbtNashChoiceDialog(wxWindow *p_parent, 
 					 gbtGameDocument *p_doc)
   : wxDialog(p_parent, -1, wxT("Compute Nash equilibria"), wxDefaultPosition),
@@ -185,6 +206,9 @@ gbtAnalysisOutput *gbtNashChoiceDialog::GetCommand(void) const
       if (m_doc->NumPlayers() == 2 && m_doc->IsConstSum()) {
 	cmd = new gbtAnalysisProfileList<Rational>(m_doc, useEfg);
 	cmd->SetCommand(prefix + wxT("lp") + options);
+	if (!useEfg) {
+	  cmd->SetSolver(LpSolve);
+	}
 	cmd->SetDescription(wxT("One equilibrium by solving a linear program ")
 			    + game);
       }
@@ -198,6 +222,9 @@ gbtAnalysisOutput *gbtNashChoiceDialog::GetCommand(void) const
       if (m_doc->NumPlayers() == 2) {
 	cmd = new gbtAnalysisProfileList<Rational>(m_doc, useEfg);
 	cmd->SetCommand(prefix + wxT("lcp") + options);
+	if (!useEfg) {
+	  cmd->SetSolver(LcpSolve);
+	}
 	cmd->SetDescription(wxT("Some equilibria by solving a linear ")
 			       wxT("complementarity program ") + game);
       }
@@ -226,6 +253,12 @@ gbtAnalysisOutput *gbtNashChoiceDialog::GetCommand(void) const
   else if (method == s_enumpure) {
     cmd = new gbtAnalysisProfileList<Rational>(m_doc, useEfg);
     cmd->SetCommand(prefix + wxT("enumpure") + options);
+    if (useEfg) {
+      cmd->SetSolver(EnumPureAgentSolve);
+    }
+    else {
+      cmd->SetSolver(EnumPureStrategySolve);
+    }
     cmd->SetDescription(count + wxT(" in pure strategies ") + game);
   }
   else if (method == s_enummixed) {
@@ -244,11 +277,17 @@ gbtAnalysisOutput *gbtNashChoiceDialog::GetCommand(void) const
   else if (method == s_lp) {
     cmd = new gbtAnalysisProfileList<Rational>(m_doc, useEfg);
     cmd->SetCommand(prefix + wxT("lp") + options);
+    if (!useEfg) {
+      cmd->SetSolver(LpSolve);
+    }
     cmd->SetDescription(count + wxT(" by solving a linear program ") + game);
   }
   else if (method == s_lcp) {
     cmd = new gbtAnalysisProfileList<Rational>(m_doc, useEfg);
     cmd->SetCommand(prefix + wxT("lcp") + options);
+    if (!useEfg) {
+      cmd->SetSolver(LcpSolve);
+    }
     cmd->SetDescription(count + wxT(" by solving a linear complementarity ")
 				   wxT("program ") + game);
   }
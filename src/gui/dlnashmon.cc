@@ -25,6 +25,7 @@
 #include <wx/wx.h>
 #endif  // WX_PRECOMP
 #include <wx/txtstrm.h>
+#include <wx/thread.h>
 
 #include "dlnashmon.h"
 #include "gamedoc.h"
@@ -34,9 +35,191 @@
 
 const int GBT_ID_TIMER = 1000;
 const int GBT_ID_PROCESS = 1001;
+const int GBT_ID_THREAD = 1002;
+
+DECLARE_EVENT_TYPE(GBT_EVT_NASH_OUTPUT, -1)
+DEFINE_EVENT_TYPE(GBT_EVT_NASH_OUTPUT)
+
+//=========================================================================
+//                          class gbtNashThread
+//=========================================================================
+
+//
+// Runs an in-process solver on its own copy of the game.  The values of
+// each profile found are queued for the dialog, which is sent an event
+// whenever the queue goes from empty to non-empty, and again when the
+// solver returns.  The dialog then builds the profiles on the document's
+// game; the profiles the solver reports cannot be handed over as they
+// are, since they refer to the thread's copy of the game, whose
+// reference counts are not safe to change from two threads at once.
+// Stopping the computation sets a flag which the solver polls.
+//
+class gbtNashThread : public wxThread, public Gambit::NashObserver {
+private:
+  wxEvtHandler *m_handler;
+  Gambit::Game m_game;
+  gbtNashSolver m_solver;
+  mutable wxCriticalSection m_lock;
+  Gambit::List<Gambit::Vector<double> > m_mixedDouble, m_behavDouble;
+  Gambit::List<Gambit::Vector<Gambit::Rational> > m_mixedRational;
+  Gambit::List<Gambit::Vector<Gambit::Rational> > m_behavRational;
+  bool m_cancelled, m_success;
+
+  void Notify(bool p_finished);
+  bool IsQueueEmpty(void) const;
+
+  template <class P, class T> 
+  void AddProfile(const P &p_profile, Gambit::List<Gambit::Vector<T> > &p_queue)
+  {
+    Gambit::Vector<T> values(p_profile.Length());
+    for (int i = 1; i <= p_profile.Length(); i++) {
+      values[i] = p_profile[i];
+    }
+    bool notify;
+    {
+      wxCriticalSectionLocker locker(m_lock);
+      notify = IsQueueEmpty();
+      p_queue.Append(values);
+    }
+    if (notify) {
+      Notify(false);
+    }
+  }
+
+protected:
+  void *Entry(void);
+
+public:
+  gbtNashThread(wxEvtHandler *p_handler, const Gambit::Game &p_game,
+		gbtNashSolver p_solver)
+    : wxThread(wxTHREAD_JOINABLE), m_handler(p_handler), 
+      m_game(p_game), m_solver(p_solver),
+      m_cancelled(false), m_success(false) { }
+
+  /// Add the profiles queued so far to p_output, building them on
+  /// the game of p_doc.  Returns the number of profiles taken.
+  int TakeProfiles(gbtGameDocument *p_doc, gbtAnalysisOutput &p_output);
+  /// Ask the solver to stop at its next opportunity
+  void Cancel(void);
+  /// Did the solver run to completion without an error?
+  bool Succeeded(void) const { return m_success; }
+
+  /// @name Overriding NashObserver members
+  //@{
+  void OnProfile(const Gambit::MixedStrategyProfile<double> &p_profile)
+  { AddProfile(p_profile, m_mixedDouble); }
+  void OnProfile(const Gambit::MixedStrategyProfile<Gambit::Rational> &p_profile)
+  { AddProfile(p_profile, m_mixedRational); }
+  void OnProfile(const Gambit::MixedBehavProfile<double> &p_profile)
+  { AddProfile(p_profile, m_behavDouble); }
+  void OnProfile(const Gambit::MixedBehavProfile<Gambit::Rational> &p_profile)
+  { AddProfile(p_profile, m_behavRational); }
+  bool IsCancelled(void) const;
+  //@}
+};
+
+void *gbtNashThread::Entry(void)
+{
+  try {
+    m_solver(m_game, *this);
+    m_success = true;
+  }
+  catch (...) {
+    m_success = false;
+  }
+  Notify(true);
+  return 0;
+}
+
+void gbtNashThread::Notify(bool p_finished)
+{
+  wxCommandEvent event(GBT_EVT_NASH_OUTPUT, GBT_ID_THREAD);
+  event.SetInt((p_finished) ? 1 : 0);
+  wxPostEvent(m_handler, event);
+}
+
+// Call only while holding m_lock
+bool gbtNashThread::IsQueueEmpty(void) const
+{
+  return (m_mixedDouble.Length() == 0 && m_behavDouble.Length() == 0 &&
+	  m_mixedRational.Length() == 0 && m_behavRational.Length() == 0);
+}
+
+namespace {
+
+template <class T> int
+AddMixedProfiles(gbtGameDocument *p_doc, gbtAnalysisOutput &p_output,
+		 const Gambit::List<Gambit::Vector<T> > &p_values)
+{
+  for (int i = 1; i <= p_values.Length(); i++) {
+    Gambit::MixedStrategyProfile<T> profile(p_doc->GetGame());
+    for (int j = 1; j <= profile.Length(); j++) {
+      profile[j] = p_values[i][j];
+    }
+    p_doc->DoAddOutput(p_output, profile);
+  }
+  return p_values.Length();
+}
+
+template <class T> int
+AddBehavProfiles(gbtGameDocument *p_doc, gbtAnalysisOutput &p_output,
+		 const Gambit::List<Gambit::Vector<T> > &p_values)
+{
+  for (int i = 1; i <= p_values.Length(); i++) {
+    Gambit::MixedBehavProfile<T> profile(p_doc->GetGame());
+    for (int j = 1; j <= profile.Length(); j++) {
+      profile[j] = p_values[i][j];
+    }
+    p_doc->DoAddOutput(p_output, profile);
+  }
+  return p_values.Length();
+}
+
+}  // end anonymous namespace
+
+int gbtNashThread::TakeProfiles(gbtGameDocument *p_doc,
+				gbtAnalysisOutput &p_output)
+{
+  Gambit::List<Gambit::Vector<double> > mixedDouble, behavDouble;
+  Gambit::List<Gambit::Vector<Gambit::Rational> > mixedRational, behavRational;
+  {
+    wxCriticalSectionLocker locker(m_lock);
+    mixedDouble = m_mixedDouble;
+    m_mixedDouble = Gambit::List<Gambit::Vector<double> >();
+    behavDouble = m_behavDouble;
+    m_behavDouble = Gambit::List<Gambit::Vector<double> >();
+    mixedRational = m_mixedRational;
+    m_mixedRational = Gambit::List<Gambit::Vector<Gambit::Rational> >();
+    behavRational = m_behavRational;
+    m_behavRational = Gambit::List<Gambit::Vector<Gambit::Rational> >();
+  }
+
+  return (AddMixedProfiles(p_doc, p_output, mixedDouble) +
+	  AddMixedProfiles(p_doc, p_output, mixedRational) +
+	  AddBehavProfiles(p_doc, p_output, behavDouble) +
+	  AddBehavProfiles(p_doc, p_output, behavRational));
+}
+
+void gbtNashThread::Cancel(void)
+{
+  wxCriticalSectionLocker locker(m_lock);
+  m_cancelled = true;
+}
+
+bool gbtNashThread::IsCancelled(void) const
+{
+  wxCriticalSectionLocker locker(m_lock);
+  return m_cancelled;
+}
+
+//=========================================================================
+//                       class gbtNashMonitorDialog
+//=========================================================================
 
 BEGIN_EVENT_TABLE(gbtNashMonitorDialog, wxDialog)
   EVT_END_PROCESS(GBT_ID_PROCESS, gbtNashMonitorDialog::OnEndProcess)
+  EVT_COMMAND(GBT_ID_THREAD, GBT_EVT_NASH_OUTPUT, 
+	      gbtNashMonitorDialog::OnThreadOutput)
   EVT_IDLE(gbtNashMonitorDialog::OnIdle)
   EVT_TIMER(GBT_ID_TIMER, gbtNashMonitorDialog::OnTimer)
 END_EVENT_TABLE()
@@ -49,7 +232,7 @@ gbtNashMonitorDialog::gbtNashMonitorDialog(wxWindow *p_parent,
   : wxDialog(p_parent, -1, wxT("Computing Nash equilibria"),
 	     wxDefaultPosition),
     m_doc(p_doc), 
-    m_process(0), m_timer(this, GBT_ID_TIMER),
+    m_process(0), m_thread(0), m_timer(this, GBT_ID_TIMER),
     m_output(p_command)
 {
   wxBoxSizer *sizer = new wxBoxSizer(wxVERTICAL);
@@ -97,6 +280,15 @@ gbtNashMonitorDialog::gbtNashMonitorDialog(wxWindow *p_parent,
   Start(p_command);
 }
 
+gbtNashMonitorDialog::~gbtNashMonitorDialog()
+{
+  if (m_thread) {
+    m_thread->Cancel();
+    m_thread->Wait();
+    delete m_thread;
+  }
+}
+
 void gbtNashMonitorDialog::Start(gbtAnalysisOutput *p_command)
 {
   if (!p_command->IsBehavior()) {
@@ -106,6 +298,25 @@ void gbtNashMonitorDialog::Start(gbtAnalysisOutput *p_command)
 
   m_doc->AddProfileList(p_command);
 
+  if (p_command->GetSolver()) {
+    // The solver is run in this process on a copy of the game, so
+    // there is no game file to write and no output to poll for;
+    // results arrive via OnThreadOutput().
+    m_thread = new gbtNashThread(this, m_doc->GetGame()->Copy(),
+				 p_command->GetSolver());
+    if (m_thread->Create() != wxTHREAD_NO_ERROR ||
+	m_thread->Run() != wxTHREAD_NO_ERROR) {
+      delete m_thread;
+      m_thread = 0;
+      m_statusText->SetLabel(wxT("The computation ended abnormally."));
+      m_statusText->SetForegroundColour(*wxRED);
+      m_okButton->Enable(true);
+      return;
+    }
+    m_stopButton->Enable(true);
+    return;
+  }
+
   m_process = new wxProcess(this, GBT_ID_PROCESS);
   m_process->Redirect();
 
@@ -156,7 +367,7 @@ void gbtNashMonitorDialog::OnIdle(wxIdleEvent &p_event)
     msg << tis.ReadLine();
 
     m_doc->DoAddOutput(*m_output, msg);
-    m_countText->SetLabel(wxString::Format(wxT("Number of equilibria found so far: %d"), m_output->NumProfiles()));
+    ShowCount();
 
     p_event.RequestMore();
   }
@@ -165,6 +376,11 @@ void gbtNashMonitorDialog::OnIdle(wxIdleEvent &p_event)
   }
 }
 
+void gbtNashMonitorDialog::ShowCount(void)
+{
+  m_countText->SetLabel(wxString::Format(wxT("Number of equilibria found so far: %d"), m_output->NumProfiles()));
+}
+
 void gbtNashMonitorDialog::OnTimer(wxTimerEvent &p_event)
 {
   wxWakeUpIdle();
@@ -183,7 +399,7 @@ void gbtNashMonitorDialog::OnEndProcess(wxProcessEvent &p_event)
 
     if (msg != wxT("")) {
       m_doc->DoAddOutput(*m_output, msg);
-      m_countText->SetLabel(wxString::Format(wxT("Number of equilibria found so far: %d"), m_output->NumProfiles()));
+      ShowCount();
     }
   }
 
@@ -199,8 +415,48 @@ void gbtNashMonitorDialog::OnEndProcess(wxProcessEvent &p_event)
   m_okButton->Enable(true);
 }
 
+void gbtNashMonitorDialog::OnThreadOutput(wxCommandEvent &p_event)
+{
+  if (!m_thread)  return;
+
+  if (m_thread->TakeProfiles(m_doc, *m_output) > 0) {
+    ShowCount();
+  }
+
+  if (p_event.GetInt() == 0)  return;
+
+  // The solver has returned, so the thread is about to exit
+  m_thread->Wait();
+  m_stopButton->Enable(false);
+
+  if (m_thread->IsCancelled()) {
+    m_statusText->SetLabel(wxT("The computation was stopped."));
+    m_statusText->SetForegroundColour(*wxRED);
+  }
+  else if (m_thread->Succeeded()) {
+    m_statusText->SetLabel(wxT("The computation has completed."));
+    m_statusText->SetForegroundColour(wxColour(0, 192, 0));
+  }
+  else {
+    m_statusText->SetLabel(wxT("The computation ended abnormally."));
+    m_statusText->SetForegroundColour(*wxRED);
+  }
+
+  delete m_thread;
+  m_thread = 0;
+  m_okButton->Enable(true);
+}
+
 void gbtNashMonitorDialog::OnStop(wxCommandEvent &p_event)
 {
+  if (m_thread) {
+    // The solver checks for cancellation as it goes; OnThreadOutput()
+    // cleans up once it has returned
+    m_stopButton->Enable(false);
+    m_thread->Cancel();
+    return;
+  }
+
   // Per the wxWidgets wiki, under Windows, programs that run
   // without a console window don't respond to the more polite
   // SIGTERM, so instead we must be rude and SIGKILL it.
@@ -27,11 +27,14 @@
 #include "wx/sheet/sheet.h"
 #include "gamedoc.h"
 
+class gbtNashThread;
+
 class gbtNashMonitorDialog : public wxDialog {
 private:
   gbtGameDocument *m_doc;
   int m_pid;
   wxProcess *m_process;
+  gbtNashThread *m_thread;
   wxWindow *m_profileList;
   wxStaticText *m_statusText, *m_countText;
   wxButton *m_stopButton, *m_okButton;
@@ -44,10 +47,14 @@ private:
   void OnTimer(wxTimerEvent &);
   void OnIdle(wxIdleEvent &);
   void OnEndProcess(wxProcessEvent &);
+  void OnThreadOutput(wxCommandEvent &);
+
+  void ShowCount(void);
 
 public:
   gbtNashMonitorDialog(wxWindow *p_parent, gbtGameDocument *p_doc,
 		       gbtAnalysisOutput *p_command);
+  virtual ~gbtNashMonitorDialog();
 
   DECLARE_EVENT_TABLE()
 };
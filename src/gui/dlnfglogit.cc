@@ -28,7 +28,6 @@
 #endif  // WX_PRECOMP
 #include <wx/stdpaths.h>
 #include <wx/txtstrm.h>
-#include <wx/tokenzr.h>
 #include <wx/process.h>
 #include <wx/print.h>
 
@@ -38,6 +37,7 @@
 
 #include "gamedoc.h"
 #include "menuconst.h"            // for tool IDs
+#include "logitrecords.h"
 
 using namespace Gambit;
 
@@ -60,7 +60,7 @@ private:
 public:
   LogitMixedBranch(gbtGameDocument *p_doc) : m_doc(p_doc) { }
 
-  void AddProfile(const wxString &p_text);
+  void AddProfile(const Array<double> &p_values);
 
   int NumPoints(void) const { return m_lambdas.Length(); }
   double GetLambda(int p_index) const { return m_lambdas[p_index]; }
@@ -71,16 +71,15 @@ public:
   { return m_profiles; }
 };
   
-void LogitMixedBranch::AddProfile(const wxString &p_text)
+/// The values are lambda followed by the profile, as in the records
+/// written by gambit-logit -b
+void LogitMixedBranch::AddProfile(const Array<double> &p_values)
 {
   MixedStrategyProfile<double> profile(m_doc->GetGame());
 
-  wxStringTokenizer tok(p_text, wxT(","));
-
-  m_lambdas.Append((double) lexical_cast<Rational>(std::string((const char *) tok.GetNextToken().mb_str())));
-
+  m_lambdas.Append(p_values[1]);
   for (int i = 1; i <= profile.Length(); i++) {
-    profile[i] = lexical_cast<Rational>(std::string((const char *) tok.GetNextToken().mb_str()));
+    profile[i] = p_values[i+1];
   }
 
   m_profiles.Append(profile);
@@ -469,8 +468,8 @@ private:
 public:
   LogitPlotPanel(wxWindow *p_parent, gbtGameDocument *p_doc);
 
-  void AddProfile(const wxString &p_text)
-  { m_branch.AddProfile(p_text); }
+  void AddProfile(const Array<double> &p_values)
+  { m_branch.AddProfile(p_values); }
 
   void SetScaleFactor(double p_scale);
   void FitZoom(void);
@@ -587,7 +586,7 @@ private:
   wxStaticText *m_statusText;
   wxButton *m_stopButton, *m_okButton;
   wxTimer m_timer;
-  wxString m_output;
+  std::string m_buffer;      // output not yet made into profiles
 
   void OnStop(wxCommandEvent &);
   void OnTimer(wxTimerEvent &);
@@ -601,6 +600,7 @@ private:
   void OnViewData(wxCommandEvent &);
 
   void Start(void);
+  void ReadOutput(int p_maxBytes);
 
 public:
   LogitMixedDialog(wxWindow *p_parent, gbtGameDocument *p_doc);
@@ -719,10 +719,10 @@ void LogitMixedDialog::Start(void)
 
 #ifdef __WXMAC__
   m_pid = wxExecute(wxStandardPaths::Get().GetExecutablePath() + 
-		    wxT("-logit -S"),
+		    wxT("-logit -S -b"),
                     wxEXEC_ASYNC, m_process);
 #else
-  m_pid = wxExecute(wxT("gambit-logit -S"), wxEXEC_ASYNC, m_process);
+  m_pid = wxExecute(wxT("gambit-logit -S -b"), wxEXEC_ASYNC, m_process);
 #endif // __WXMAC__
   
   std::ostringstream s;
@@ -752,20 +752,27 @@ void LogitMixedDialog::Start(void)
   m_timer.Start(1000, false);
 }
 
+//
+// Reads up to p_maxBytes of the available output of the process
+// (or all of it, if p_maxBytes is zero), and adds the profiles in it.
+//
+void LogitMixedDialog::ReadOutput(int p_maxBytes)
+{
+  ReadAvailable(m_process, m_buffer, p_maxBytes);
+
+  List<Array<double> > records;
+  ReadRecords(m_buffer, records);
+  for (int i = 1; i <= records.Length(); i++) {
+    m_plot->AddProfile(records[i]);
+  }
+}
+
 void LogitMixedDialog::OnIdle(wxIdleEvent &p_event)
 {
   if (!m_process)  return;
 
   if (m_process->IsInputAvailable()) {
-    wxTextInputStream tis(*m_process->GetInputStream());
-
-    wxString msg;
-    msg << tis.ReadLine();
-    m_plot->AddProfile(msg);
-    //m_mixedList->AddProfile(msg, false);
-    m_output += msg;
-    m_output += wxT("\n");
-
+    ReadOutput(65536);
     p_event.RequestMore();
   }
   else {
@@ -783,19 +790,7 @@ void LogitMixedDialog::OnEndProcess(wxProcessEvent &p_event)
   m_stopButton->Enable(false);
   m_timer.Stop();
 
-  while (m_process->IsInputAvailable()) {
-    wxTextInputStream tis(*m_process->GetInputStream());
-
-    wxString msg;
-    msg << tis.ReadLine();
-
-    if (msg != wxT("")) {
-      m_plot->AddProfile(msg);
-      //m_mixedList->AddProfile(msg, true);
-      m_output += msg;
-      m_output += wxT("\n");
-    }
-  }
+  ReadOutput(0);
 
   if (p_event.GetExitCode() == 0) {
     m_statusText->SetLabel(wxT("The computation has completed."));
@@ -835,7 +830,16 @@ void LogitMixedDialog::OnSave(wxCommandEvent &)
 
   if (dialog.ShowModal() == wxID_OK) {
     std::ofstream file((const char *) dialog.GetPath().mb_str());
-    file << ((const char *) m_output.mb_str());
+    LogitMixedBranch &branch = m_plot->GetBranch();
+    int decimals = m_doc->GetStyle().NumDecimals();
+    for (int i = 1; i <= branch.NumPoints(); i++) {
+      file << lexical_cast<std::string>(branch.GetLambda(i), decimals);
+      const MixedStrategyProfile<double> &profile = branch.GetProfile(i);
+      for (int j = 1; j <= profile.Length(); j++) {
+	file << "," << lexical_cast<std::string>(profile[j], decimals);
+      }
+      file << std::endl;
+    }
   }
 }
 
@@ -661,7 +661,16 @@ void gbtEfgDisplay::OnDraw(wxDC &p_dc)
 #endif
   p_dc.Clear();
   int maxX = m_layout.MaxX();
-  m_layout.Render(p_dc, false);
+  // Only the part of the tree in the window needs to be drawn; find
+  // it in the coordinates of the layout
+  int width, height, x, y;
+  GetClientSize(&width, &height);
+  CalcUnscrolledPosition(0, 0, &x, &y);
+  double scale = .01 * m_zoom;
+  m_layout.Render(p_dc, 
+		  wxRect((int) (x / scale), (int) (y / scale),
+			 (int) (width / scale) + 1, (int) (height / scale) + 1),
+		  false);
 #if !wxCHECK_VERSION(2,7,0)
   p_dc.EndDrawing();
 #endif
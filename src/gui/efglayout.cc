@@ -21,7 +21,8 @@
 //
 
 #include <cmath>
-#include <algorithm>    // for std::min, std::max
+#include <climits>      // for INT_MAX
+#include <algorithm>    // for std::min, std::max, std::sort
 
 #include <wx/wxprec.h>
 #ifndef WX_PRECOMP
@@ -41,7 +42,7 @@ gbtNodeEntry::gbtNodeEntry(Gambit::GameNode p_node)
     m_size(20), m_token(GBT_NODE_TOKEN_CIRCLE),
     m_branchStyle(GBT_BRANCH_STYLE_LINE), m_branchLabel(GBT_BRANCH_LABEL_HORIZONTAL),
     m_branchLength(0),
-    m_sublevel(0), m_actionProb(0)
+    m_sublevel(0), m_actionProb(0), m_labelsValid(false)
 { }
 
 int gbtNodeEntry::GetChildNumber(void) const
@@ -347,21 +348,36 @@ bool gbtNodeEntry::NodeHitTest(int p_x, int p_y) const
   }
 }
 
+//
+// Forgets the label and outcome rectangles computed when the entry
+// was last drawn.  Only entries which are drawn again get new ones,
+// so after a relayout the old ones would refer to stale positions.
+//
+void gbtNodeEntry::ClearExtents(void) const
+{
+  m_outcomeRect = wxRect();
+  m_payoffRect = Gambit::Array<wxRect>();
+  m_branchAboveRect = wxRect();
+  m_branchBelowRect = wxRect();
+}
+
 //-----------------------------------------------------------------------
 //                class gbtTreeLayout: Member functions
 //-----------------------------------------------------------------------
 
 gbtTreeLayout::gbtTreeLayout(gbtEfgDisplay *p_parent, gbtGameDocument *p_doc)
   : gbtGameView(p_doc), 
-    m_parent(p_parent), m_infosetSpacing(40),
-    c_leftMargin(20), c_topMargin(40)
+    m_parent(p_parent), m_maxX(0), m_maxY(0), m_maxLevel(0),
+    m_infosetSpacing(40), m_gridCols(0), m_gridRows(0), m_stamp(0),
+    c_leftMargin(20), c_topMargin(40), c_gridSize(200)
 { }
 
 Gambit::GameNode gbtTreeLayout::NodeHitTest(int p_x, int p_y) const
 {
-  for (int i = 1; i <= m_nodeList.Length(); i++) {
-    if (m_nodeList[i]->NodeHitTest(p_x, p_y)) {
-      return m_nodeList[i]->GetNode();
+  int count = FindEntries(wxRect(p_x, p_y, 1, 1));
+  for (int i = 1; i <= count; i++) {
+    if (m_nodeList[m_found[i]]->NodeHitTest(p_x, p_y)) {
+      return m_nodeList[m_found[i]]->GetNode();
     }
   }
   return 0;
@@ -369,9 +385,10 @@ Gambit::GameNode gbtTreeLayout::NodeHitTest(int p_x, int p_y) const
 
 Gambit::GameNode gbtTreeLayout::OutcomeHitTest(int p_x, int p_y) const
 {
-  for (int i = 1; i <= m_nodeList.Length(); i++) {
-    if (m_nodeList[i]->OutcomeHitTest(p_x, p_y)) {
-      return m_nodeList[i]->GetNode();
+  int count = FindEntries(wxRect(p_x, p_y, 1, 1));
+  for (int i = 1; i <= count; i++) {
+    if (m_nodeList[m_found[i]]->OutcomeHitTest(p_x, p_y)) {
+      return m_nodeList[m_found[i]]->GetNode();
     }
   }
   return 0;
@@ -379,9 +396,10 @@ Gambit::GameNode gbtTreeLayout::OutcomeHitTest(int p_x, int p_y) const
 
 Gambit::GameNode gbtTreeLayout::BranchAboveHitTest(int p_x, int p_y) const
 {
-  for (int i = 1; i <= m_nodeList.Length(); i++) {
-    if (m_nodeList[i]->BranchAboveHitTest(p_x, p_y)) {
-      return m_nodeList[i]->GetNode()->GetParent();
+  int count = FindEntries(wxRect(p_x, p_y, 1, 1));
+  for (int i = 1; i <= count; i++) {
+    if (m_nodeList[m_found[i]]->BranchAboveHitTest(p_x, p_y)) {
+      return m_nodeList[m_found[i]]->GetNode()->GetParent();
     }
   }
   return 0;
@@ -389,9 +407,10 @@ Gambit::GameNode gbtTreeLayout::BranchAboveHitTest(int p_x, int p_y) const
 
 Gambit::GameNode gbtTreeLayout::BranchBelowHitTest(int p_x, int p_y) const
 {
-  for (int i = 1; i <= m_nodeList.Length(); i++) {
-    if (m_nodeList[i]->BranchAboveHitTest(p_x, p_y)) {
-      return m_nodeList[i]->GetNode()->GetParent();
+  int count = FindEntries(wxRect(p_x, p_y, 1, 1));
+  for (int i = 1; i <= count; i++) {
+    if (m_nodeList[m_found[i]]->BranchAboveHitTest(p_x, p_y)) {
+      return m_nodeList[m_found[i]]->GetNode()->GetParent();
     }
   }
   return 0;
@@ -399,8 +418,9 @@ Gambit::GameNode gbtTreeLayout::BranchBelowHitTest(int p_x, int p_y) const
 
 Gambit::GameNode gbtTreeLayout::InfosetHitTest(int p_x, int p_y) const
 {
-  for (int i = 1; i <= m_nodeList.Length(); i++) {
-    gbtNodeEntry *entry = m_nodeList[i];
+  int count = FindEntries(wxRect(p_x, p_y, 1, 1));
+  for (int i = 1; i <= count; i++) {
+    gbtNodeEntry *entry = m_nodeList[m_found[i]];
     if (entry->GetNextMember() && entry->GetNode()->GetInfoset()) {
       if (p_x > entry->X() + entry->GetSublevel() * m_infosetSpacing - 2 &&
 	  p_x < entry->X() + entry->GetSublevel() * m_infosetSpacing + 2) {
@@ -418,6 +438,167 @@ Gambit::GameNode gbtTreeLayout::InfosetHitTest(int p_x, int p_y) const
   return 0;
 }
 
+//-----------------------------------------------------------------------
+//              class gbtTreeLayout: Spatial index of entries
+//-----------------------------------------------------------------------
+
+int gbtTreeLayout::GridColumn(int p_x) const
+{
+  // Coordinates off the grid are assigned to the nearest edge cell
+  return std::max(0, std::min(m_gridCols - 1, p_x / c_gridSize));
+}
+
+int gbtTreeLayout::GridRow(int p_y) const
+{
+  return std::max(0, std::min(m_gridRows - 1, p_y / c_gridSize));
+}
+
+//
+// Computes the drawing extent of each entry (its token and labels,
+// incoming branch, outcome and information set connector) and buckets
+// the entries into the cells of a uniform grid covering the layout.
+// Labels and outcomes are only measured when drawn, so the extents
+// are padded by an allowance based on the label font, and an entry
+// with an outcome is taken to extend to the right edge of the layout.
+//
+void gbtTreeLayout::BuildIndex(void)
+{
+  const gbtStyle &settings = m_doc->GetStyle();
+  int fontSize = settings.GetFont().GetPointSize();
+  int padX = 10 * fontSize, padY = 3 * fontSize + 10;
+  int numEntries = m_nodeList.Length();
+
+  m_extents = Gambit::Array<wxRect>(numEntries);
+  m_drawn = Gambit::Array<bool>(numEntries);
+  m_mark = Gambit::Array<int>(numEntries);
+  m_found = Gambit::Array<int>(numEntries);
+  m_stamp = 0;
+
+  // The outcome labels are measured again as they are drawn, and
+  // extend the right margin then
+  m_maxX = 0;
+  for (int pos = 1; pos <= numEntries; pos++) {
+    gbtNodeEntry *entry = m_nodeList[pos];
+    entry->ClearExtents();
+    m_mark[pos] = 0;
+    m_maxX = std::max(m_maxX, entry->X() + entry->GetSize());
+
+    // Entries are drawn along with their first child; since the node
+    // list is in preorder, that child immediately follows its parent.
+    m_drawn[pos] = (entry->GetNode()->NumChildren() == 0 ||
+		    (pos < numEntries &&
+		     m_nodeList[pos+1]->GetParent() == entry &&
+		     m_nodeList[pos+1]->GetChildNumber() == 1));
+
+    int left = entry->X(), right = entry->X() + entry->GetSize() + 20;
+    int top = entry->Y() - entry->GetSize() / 2;
+    int bottom = entry->Y() + entry->GetSize() / 2;
+
+    gbtNodeEntry *parent = entry->GetParent();
+    if (parent && parent != entry) {
+      left = std::min(left, parent->X() + parent->GetSize());
+      top = std::min(top, parent->Y());
+      bottom = std::max(bottom, parent->Y());
+    }
+
+    gbtNodeEntry *next = entry->GetNextMember();
+    if (next) {
+      left = std::min(left, entry->X() - m_infosetSpacing);
+      right = std::max(right, entry->X() + entry->GetSize() +
+		       (entry->GetSublevel() + 1) * m_infosetSpacing);
+      top = std::min(top, next->Y());
+      bottom = std::max(bottom, next->Y());
+    }
+
+    left -= padX;
+    top -= padY;
+    bottom += padY;
+    if (entry->GetNode()->GetOutcome()) {
+      right = INT_MAX / 2;
+    }
+    else {
+      right += padX;
+    }
+    m_extents[pos] = wxRect(left, top, right - left + 1, bottom - top + 1);
+  }
+
+  // One extra column beyond the layout catches the outcome labels
+  m_gridCols = m_maxX / c_gridSize + 2;
+  m_gridRows = m_maxY / c_gridSize + 1;
+  int numCells = m_gridCols * m_gridRows;
+
+  // Count the entries in each cell, then lay the cells out one after
+  // another in m_cellEntries
+  m_cellStart = Gambit::Array<int>(0, numCells);
+  for (int cell = 0; cell <= numCells; m_cellStart[cell++] = 0);
+  for (int pos = 1; pos <= numEntries; pos++) {
+    const wxRect &extent = m_extents[pos];
+    for (int row = GridRow(extent.GetTop()); 
+	 row <= GridRow(extent.GetBottom()); row++) {
+      for (int col = GridColumn(extent.GetLeft());
+	   col <= GridColumn(extent.GetRight()); col++) {
+	m_cellStart[row * m_gridCols + col + 1]++;
+      }
+    }
+  }
+  for (int cell = 1; cell <= numCells; cell++) {
+    m_cellStart[cell] += m_cellStart[cell-1];
+  }
+
+  m_cellEntries = Gambit::Array<int>(0, m_cellStart[numCells] - 1);
+  Gambit::Array<int> fill(m_cellStart);
+  for (int pos = 1; pos <= numEntries; pos++) {
+    const wxRect &extent = m_extents[pos];
+    for (int row = GridRow(extent.GetTop()); 
+	 row <= GridRow(extent.GetBottom()); row++) {
+      for (int col = GridColumn(extent.GetLeft());
+	   col <= GridColumn(extent.GetRight()); col++) {
+	m_cellEntries[fill[row * m_gridCols + col]++] = pos;
+      }
+    }
+  }
+}
+
+//
+// Collects into m_found the positions of the entries whose extent
+// intersects p_rect, in increasing order (that is, in the order they
+// appear in the node list), and returns how many there are.
+//
+int gbtTreeLayout::FindEntries(const wxRect &p_rect) const
+{
+  if (m_gridCols == 0 || m_extents.Length() != m_nodeList.Length()) {
+    return 0;
+  }
+
+  if (++m_stamp == INT_MAX) {
+    for (int pos = 1; pos <= m_mark.Length(); m_mark[pos++] = 0);
+    m_stamp = 1;
+  }
+
+  int count = 0;
+  for (int row = GridRow(p_rect.GetTop()); 
+       row <= GridRow(p_rect.GetBottom()); row++) {
+    for (int col = GridColumn(p_rect.GetLeft());
+	 col <= GridColumn(p_rect.GetRight()); col++) {
+      int cell = row * m_gridCols + col;
+      for (int i = m_cellStart[cell]; i < m_cellStart[cell+1]; i++) {
+	int pos = m_cellEntries[i];
+	if (m_mark[pos] != m_stamp) {
+	  m_mark[pos] = m_stamp;
+	  if (m_extents[pos].Intersects(p_rect)) {
+	    m_found[++count] = pos;
+	  }
+	}
+      }
+    }
+  }
+
+  if (count > 1) {
+    std::sort(&m_found[1], &m_found[1] + count);
+  }
+  return count;
+}
+
 wxString gbtTreeLayout::CreateNodeLabel(const gbtNodeEntry *p_entry,
 					int p_which) const
 {
@@ -551,12 +732,8 @@ gbtNodeEntry *gbtTreeLayout::GetValidChild(Gambit::GameNode e)
 
 gbtNodeEntry *gbtTreeLayout::GetEntry(Gambit::GameNode p_node) const
 {
-  for (int i = 1; i <= m_nodeList.Length(); i++) {
-    if (m_nodeList[i]->GetNode() == p_node) {
-      return m_nodeList[i];
-    }
-  }
-  return 0;
+  gbtEntryMap::const_iterator entry = m_entries.find(p_node);
+  return (entry != m_entries.end()) ? entry->second : 0;
 }
 
 Gambit::GameNode gbtTreeLayout::PriorSameLevel(Gambit::GameNode p_node) const
@@ -592,6 +769,7 @@ int gbtTreeLayout::LayoutSubtree(Gambit::GameNode p_node, const Gambit::BehavSup
     
   gbtNodeEntry *entry = GetEntry(p_node);
   entry->SetNextMember(0);
+  entry->SetInSupport(true);
   if (m_doc->GetStyle().RootReachable() &&
       p_node->GetInfoset() && !p_node->GetInfoset()->GetPlayer()->IsChance()) {
     Gambit::GameInfoset infoset = p_node->GetInfoset();
@@ -615,7 +793,7 @@ int gbtTreeLayout::LayoutSubtree(Gambit::GameNode p_node, const Gambit::BehavSup
 	
 	if (!p_node->GetPlayer()->IsChance() &&
 	    !p_support.Contains(p_node->GetInfoset()->GetAction(i))) {
-	  m_nodeList[p_node->GetChild(i)->GetNumber()]->SetInSupport(false);
+	  GetEntry(p_node->GetChild(i))->SetInSupport(false);
 	}
       }
       entry->SetY((y1 + yn) / 2);
@@ -663,26 +841,15 @@ int gbtTreeLayout::LayoutSubtree(Gambit::GameNode p_node, const Gambit::BehavSup
 }
 
 //
-// Checks if there are any nodes in the same infoset as e that are either
-// on the same level (if SHOWISET_SAME) or on any level (if SHOWISET_ALL)
+// Returns the next entry (in the order of the node list) in the same
+// infoset as e, either on the same level (if SHOWISET_SAME) or on
+// any level (if SHOWISET_ALL).  These are found in Layout().
 //
 gbtNodeEntry *gbtTreeLayout::NextInfoset(gbtNodeEntry *e)
 {
-  const gbtStyle &draw_settings = m_doc->GetStyle();
-  
-  for (int pos = m_nodeList.Find(e) + 1; pos <= m_nodeList.Length(); pos++) {
-    gbtNodeEntry *e1 = m_nodeList[pos];
-    // infosets are the same and the nodes are on the same level
-    if (e->GetNode()->GetInfoset() == e1->GetNode()->GetInfoset()) {
-      if (draw_settings.InfosetConnect() == GBT_INFOSET_CONNECT_ALL) {
-	return e1;
-      }
-      else if (e->GetLevel() == e1->GetLevel()) {
-	return e1;
-      }
-    }
-  }
-  return 0;
+  std::map<gbtNodeEntry *, gbtNodeEntry *>::const_iterator next = 
+    m_nextInfoset.find(e);
+  return (next != m_nextInfoset.end()) ? next->second : 0;
 }
 
 //
@@ -693,41 +860,31 @@ gbtNodeEntry *gbtTreeLayout::NextInfoset(gbtNodeEntry *e)
 //
 void gbtTreeLayout::CheckInfosetEntry(gbtNodeEntry *e)
 {
-  int pos;
-  gbtNodeEntry *infoset_entry, *e1;
+  gbtNodeEntry *infoset_entry = NextInfoset(e);
+  std::pair<Gambit::GameInfosetRep *, int> key(e->GetNode()->GetInfoset(),
+					       e->GetLevel());
+
   // Check if the infoset this entry belongs to (on this level) has already
   // been processed.  If so, make this entry->num the same as the one already
   // processed and return
-  infoset_entry = NextInfoset(e);
-  for (pos = 1; pos <= m_nodeList.Length(); pos++) {
-    e1 = m_nodeList[pos];
-    // if the infosets are the same and they are on the same level and e1 has been processed
-    if (e->GetNode()->GetInfoset() == e1->GetNode()->GetInfoset() && 
-	e->GetLevel() == e1->GetLevel() && e1->GetSublevel() > 0) {
-      e->SetSublevel(e1->GetSublevel());
-      if (infoset_entry) {
-	e->SetNextMember(infoset_entry);
-      }
-      return;
+  std::map<std::pair<Gambit::GameInfosetRep *, int>, int>::const_iterator 
+    sublevel = m_sublevels.find(key);
+  if (sublevel != m_sublevels.end()) {
+    e->SetSublevel(sublevel->second);
+    if (infoset_entry) {
+      e->SetNextMember(infoset_entry);
     }
+    return;
   }
     
   // If we got here, this entry does not belong to any processed infoset yet.
   // Check if it belongs to ANY infoset, if not just return
   if (!infoset_entry) return;
     
-  // If we got here, then this entry is new and is connected to other entries
-  // find the entry on the same level with the maximum num.
-  // This entry will have num = num+1.
-  int num = 0;
-  for (pos = 1; pos <= m_nodeList.Length(); pos++) {
-    e1 = m_nodeList[pos];
-    // Find the max num for this level
-    if (e->GetLevel() == e1->GetLevel())  {
-      num = std::max(e1->GetSublevel(), num);
-    }
-  }
-  num++;
+  // If we got here, then this entry is new and is connected to other entries.
+  // It goes one past the maximum num on this level.
+  int num = ++m_maxSublevel[e->GetLevel()];
+  m_sublevels[key] = num;
   e->SetSublevel(num);
   e->SetNextMember(infoset_entry);
 }
@@ -810,7 +967,28 @@ void gbtTreeLayout::Layout(const Gambit::BehavSupport &p_support)
 
   const gbtStyle &draw_settings = m_doc->GetStyle();
   if (draw_settings.InfosetConnect() != GBT_INFOSET_CONNECT_NONE) {
-    // FIXME! This causes lines to disappear... sometimes.
+    // Find the next member of each entry's information set by scanning
+    // the node list backwards
+    typedef std::pair<Gambit::GameInfosetRep *, int> InfosetKey;
+    std::map<InfosetKey, gbtNodeEntry *> following;
+    m_nextInfoset.clear();
+    for (int pos = m_nodeList.Length(); pos >= 1; pos--) {
+      gbtNodeEntry *entry = m_nodeList[pos];
+      entry->SetSublevel(0);
+      InfosetKey key(entry->GetNode()->GetInfoset(),
+		     (draw_settings.InfosetConnect() == GBT_INFOSET_CONNECT_ALL) ?
+		     -1 : entry->GetLevel());
+      std::map<InfosetKey, gbtNodeEntry *>::iterator next = following.find(key);
+      if (next != following.end()) {
+	m_nextInfoset[entry] = next->second;
+      }
+      following[key] = entry;
+    }
+
+    m_sublevels.clear();
+    m_maxSublevel = Gambit::Array<int>(0, m_maxLevel);
+    for (int i = 0; i <= m_maxLevel; m_maxSublevel[i++] = 0);
+
     FillInfosetTable(m_doc->GetGame()->GetRoot(), p_support);
     UpdateTableInfosets();
   }
@@ -819,180 +997,217 @@ void gbtTreeLayout::Layout(const Gambit::BehavSupport &p_support)
   GenerateLabels();
 
   m_maxY = maxy + 25;
+  BuildIndex();
 }
 
 void gbtTreeLayout::BuildNodeList(Gambit::GameNode p_node, const Gambit::BehavSupport &p_support,
-				  int p_level)
+				  int p_level, gbtEntryMap &p_oldEntries,
+				  int &p_numEntries)
 {
-  gbtNodeEntry *entry = new gbtNodeEntry(p_node);
+  gbtNodeEntry *entry;
+  gbtEntryMap::iterator old = p_oldEntries.find(p_node);
+  if (old != p_oldEntries.end()) {
+    entry = old->second;
+    p_oldEntries.erase(old);
+  }
+  else {
+    entry = new gbtNodeEntry(p_node);
+  }
   entry->SetStyle(&m_doc->GetStyle());
-  m_nodeList.Append(entry);
+  m_entries[p_node] = entry;
+  m_nodeList[++p_numEntries] = entry;
   entry->SetLevel(p_level);
   if (m_doc->GetStyle().RootReachable()) {
     Gambit::GameInfoset infoset = p_node->GetInfoset();
     if (infoset) {
       if (infoset->GetPlayer()->IsChance()) {
 	for (int i = 1; i <= p_node->NumChildren(); i++) {
-	  BuildNodeList(p_node->GetChild(i), p_support, p_level + 1);
+	  BuildNodeList(p_node->GetChild(i), p_support, p_level + 1,
+			p_oldEntries, p_numEntries);
 	}
       }
       else {
 	for (int i = 1; i <= p_support.NumActions(infoset); i++) {
 	  BuildNodeList(p_node->GetChild(p_support.GetAction(infoset, i)->GetNumber()),
-			p_support, p_level + 1);
+			p_support, p_level + 1, p_oldEntries, p_numEntries);
 	}
       }
     }
   }
   else {
     for (int i = 1; i <= p_node->NumChildren(); i++) {
-      BuildNodeList(p_node->GetChild(i), p_support, p_level + 1);
+      BuildNodeList(p_node->GetChild(i), p_support, p_level + 1,
+		    p_oldEntries, p_numEntries);
     }
   }
   m_maxLevel = std::max(p_level, m_maxLevel);
 }
 
+//
+// Rebuilds the list of entries for the nodes to be drawn.  Entries
+// are kept for nodes which are still in the tree, so that edits do not
+// require recreating the entries (and their labels) for the whole tree;
+// entries for nodes which have gone away are deleted.
+//
 void gbtTreeLayout::BuildNodeList(const Gambit::BehavSupport &p_support)
 {
-  while (m_nodeList.Length() > 0) {
-    delete m_nodeList.Remove(1);
-  }
+  gbtEntryMap oldEntries;
+  oldEntries.swap(m_entries);
 
   m_maxLevel = 0;
-  BuildNodeList(m_doc->GetGame()->GetRoot(), p_support, 0);
+  int numEntries = 0;
+  m_nodeList = Gambit::Array<gbtNodeEntry *>(m_doc->GetGame()->NumNodes());
+  BuildNodeList(m_doc->GetGame()->GetRoot(), p_support, 0,
+		oldEntries, numEntries);
+
+  if (numEntries < m_nodeList.Length()) {
+    // Some nodes are not reachable in the support; trim the list
+    Gambit::Array<gbtNodeEntry *> nodeList(numEntries);
+    for (int pos = 1; pos <= numEntries; pos++) {
+      nodeList[pos] = m_nodeList[pos];
+    }
+    m_nodeList = nodeList;
+  }
+
+  for (gbtEntryMap::iterator entry = oldEntries.begin();
+       entry != oldEntries.end(); ++entry) {
+    delete entry->second;
+  }
 }
 
 
+//
+// Labels are generated only when an entry is drawn; this marks the
+// labels of all entries as needing to be regenerated.
+//
 void gbtTreeLayout::GenerateLabels(void)
 {
-  const gbtStyle &settings = m_doc->GetStyle();
   for (int i = 1; i <= m_nodeList.Length(); i++) {
-    gbtNodeEntry *entry = m_nodeList[i];
-    entry->SetNodeAboveLabel(CreateNodeLabel(entry,
+    m_nodeList[i]->SetLabelsValid(false);
+  }
+}
+
+void gbtTreeLayout::GenerateLabels(gbtNodeEntry *p_entry) const
+{
+  const gbtStyle &settings = m_doc->GetStyle();
+  p_entry->SetNodeAboveLabel(CreateNodeLabel(p_entry,
 					     settings.NodeAboveLabel()));
-    entry->SetNodeAboveFont(settings.GetFont());
-    entry->SetNodeBelowLabel(CreateNodeLabel(entry,
+  p_entry->SetNodeAboveFont(settings.GetFont());
+  p_entry->SetNodeBelowLabel(CreateNodeLabel(p_entry,
 					     settings.NodeBelowLabel()));
-    entry->SetNodeBelowFont(settings.GetFont());
-    if (entry->GetChildNumber() > 0) {
-      entry->SetBranchAboveLabel(CreateBranchLabel(entry,
+  p_entry->SetNodeBelowFont(settings.GetFont());
+  if (p_entry->GetChildNumber() > 0) {
+    p_entry->SetBranchAboveLabel(CreateBranchLabel(p_entry,
 						   settings.BranchAboveLabel()));
-      entry->SetBranchAboveFont(settings.GetFont());
-      entry->SetBranchBelowLabel(CreateBranchLabel(entry,
+    p_entry->SetBranchAboveFont(settings.GetFont());
+    p_entry->SetBranchBelowLabel(CreateBranchLabel(p_entry,
 						   settings.BranchBelowLabel()));
-      entry->SetBranchBelowFont(settings.GetFont());
+    p_entry->SetBranchBelowFont(settings.GetFont());
 
-      Gambit::GameNode parent = entry->GetNode()->GetParent();
-      if (parent->GetPlayer()->IsChance()) {
-	entry->SetActionProb(parent->GetInfoset()->GetActionProb<double>(entry->GetChildNumber()));
+    Gambit::GameNode parent = p_entry->GetNode()->GetParent();
+    if (parent->GetPlayer()->IsChance()) {
+      p_entry->SetActionProb(parent->GetInfoset()->GetActionProb<double>(p_entry->GetChildNumber()));
+    }
+    else {
+      int profile = m_doc->GetCurrentProfile();
+      if (profile > 0) {
+	try {
+	  p_entry->SetActionProb((double) Gambit::lexical_cast<Gambit::Rational>(m_doc->GetProfiles().GetActionProb(parent, p_entry->GetChildNumber())));
+	}
+	catch (ValueException &) {
+	  // This occurs when the probability is undefined
+	  p_entry->SetActionProb(0.0);
+	}
       }
       else {
-	int profile = m_doc->GetCurrentProfile();
-	if (profile > 0) {
-	  try {
-	    entry->SetActionProb((double) Gambit::lexical_cast<Gambit::Rational>(m_doc->GetProfiles().GetActionProb(parent, entry->GetChildNumber())));
-	  }
-	  catch (ValueException &) {
-	    // This occurs when the probability is undefined
-	    entry->SetActionProb(0.0);
-	  }
-	}
+	p_entry->SetActionProb(0.0);
       }
     }
   }
+  p_entry->SetLabelsValid(true);
 }
 
 //
 // RenderSubtree: Render branches and labels
 //
-// The following speed optimizations have been added:
-// The algorithm now traverses the tree as a linear linked list, eliminating
-// expensive searches.
+// Only the entries whose extent intersects p_region are drawn; these
+// are located using the grid built by BuildIndex().  The extents
+// include the information set connectors, so these are drawn correctly
+// while scrolling even if neither end is in view.
 //
-// There was some clipping code in here, but it didn't correctly
-// deal with drawing information sets while scrolling.  So, the code
-// has temporarily been removed.  It remains to be seen whether
-// performance will require a more sophisticated solution to the
-// problem.  (TLT 5/2001)
-//
-void gbtTreeLayout::RenderSubtree(wxDC &p_dc, bool p_noHints) const
+void gbtTreeLayout::RenderSubtree(wxDC &p_dc, const wxRect &p_region,
+				  bool p_noHints) const
 {
   const gbtStyle &settings = m_doc->GetStyle();
 
-  for (int pos = 1; pos <= m_nodeList.Length(); pos++) {
-    gbtNodeEntry *entry = m_nodeList[pos];  
-    gbtNodeEntry *parentEntry = entry->GetParent();
-        
-    if (entry->GetChildNumber() == 1) {
-      parentEntry->Draw(p_dc, m_doc->GetSelectNode(), p_noHints);
+  int count = FindEntries(p_region);
+  for (int i = 1; i <= count; i++) {
+    if (!m_drawn[m_found[i]])  continue;
+    gbtNodeEntry *entry = m_nodeList[m_found[i]];  
+
+    if (!entry->LabelsValid()) {
+      GenerateLabels(entry);
+    }
+    entry->Draw(p_dc, m_doc->GetSelectNode(), p_noHints);
 
-      if (m_doc->GetStyle().InfosetConnect() != GBT_INFOSET_CONNECT_NONE &&
-	  parentEntry->GetNextMember()) {
-	int nextX = parentEntry->GetNextMember()->X();
-	int nextY = parentEntry->GetNextMember()->Y();
+    if (entry->GetNode()->NumChildren() > 0 &&
+	m_doc->GetStyle().InfosetConnect() != GBT_INFOSET_CONNECT_NONE &&
+	entry->GetNextMember()) {
+      int nextX = entry->GetNextMember()->X();
+      int nextY = entry->GetNextMember()->Y();
 
-	if ((m_doc->GetStyle().InfosetConnect() !=
-	     GBT_INFOSET_CONNECT_SAMELEVEL) ||
-	    parentEntry->X() == nextX) {
+      if ((m_doc->GetStyle().InfosetConnect() !=
+	   GBT_INFOSET_CONNECT_SAMELEVEL) ||
+	  entry->X() == nextX) {
 #ifdef __WXGTK__
-	  // A problem with using styled pens and user scaling on wxGTK
-	  p_dc.SetPen(wxPen(parentEntry->GetColor(), 1, wxSOLID));
+	// A problem with using styled pens and user scaling on wxGTK
+	p_dc.SetPen(wxPen(entry->GetColor(), 1, wxSOLID));
 #else
-	  p_dc.SetPen(wxPen(parentEntry->GetColor(), 1, wxDOT));
+	p_dc.SetPen(wxPen(entry->GetColor(), 1, wxDOT));
 #endif   // __WXGTK__
-	  p_dc.DrawLine(parentEntry->X(), parentEntry->Y(), 
-			parentEntry->X(), nextY);
-	  if (settings.InfosetJoin() == GBT_INFOSET_JOIN_CIRCLES) {
-	    p_dc.DrawLine(parentEntry->X() + parentEntry->GetSize(), 
-			  parentEntry->Y(),
-			  parentEntry->X() + parentEntry->GetSize(), 
-			  nextY);
-	  }
+	p_dc.DrawLine(entry->X(), entry->Y(), entry->X(), nextY);
+	if (settings.InfosetJoin() == GBT_INFOSET_JOIN_CIRCLES) {
+	  p_dc.DrawLine(entry->X() + entry->GetSize(), entry->Y(),
+			entry->X() + entry->GetSize(), nextY);
+	}
 
-	  if (parentEntry->GetNextMember()->X() != parentEntry->X()) {
-	    // Draw a little arrow in the direction of the iset.
-	    int startX, endX; 
-	    if (settings.InfosetJoin() == GBT_INFOSET_JOIN_LINES) {
-	      startX = parentEntry->X();
-	      endX = (startX + m_infosetSpacing * 
-		      ((parentEntry->GetNextMember()->X() > 
-			parentEntry->X()) ? 1 : -1));
-	    }
-	    else {
-	      if (parentEntry->GetNextMember()->X() < parentEntry->X()) {
-		// information set is continued to the left
-		startX = parentEntry->X() + parentEntry->GetSize();
-		endX = parentEntry->X() - m_infosetSpacing;
-	      }
-	      else {
-		// information set is continued to the right
-		startX = parentEntry->X();
-		endX = (parentEntry->X() + parentEntry->GetSize() + 
-			m_infosetSpacing);
-	      }
-	    }
-	    p_dc.DrawLine(startX, nextY, endX, nextY);
-	    if (startX > endX) {
-	      p_dc.DrawLine(endX, nextY, endX + m_infosetSpacing / 2,
-			    nextY + m_infosetSpacing / 2);
-	      p_dc.DrawLine(endX, nextY, endX + m_infosetSpacing / 2,
-			    nextY - m_infosetSpacing / 2);
+	if (entry->GetNextMember()->X() != entry->X()) {
+	  // Draw a little arrow in the direction of the iset.
+	  int startX, endX; 
+	  if (settings.InfosetJoin() == GBT_INFOSET_JOIN_LINES) {
+	    startX = entry->X();
+	    endX = (startX + m_infosetSpacing * 
+		    ((entry->GetNextMember()->X() > entry->X()) ? 1 : -1));
+	  }
+	  else {
+	    if (entry->GetNextMember()->X() < entry->X()) {
+	      // information set is continued to the left
+	      startX = entry->X() + entry->GetSize();
+	      endX = entry->X() - m_infosetSpacing;
 	    }
 	    else {
-	      p_dc.DrawLine(endX, nextY, endX - m_infosetSpacing / 2,
-			    nextY + m_infosetSpacing / 2);
-	      p_dc.DrawLine(endX, nextY, endX - m_infosetSpacing / 2,
-			    nextY - m_infosetSpacing / 2);
+	      // information set is continued to the right
+	      startX = entry->X();
+	      endX = entry->X() + entry->GetSize() + m_infosetSpacing;
 	    }
 	  }
+	  p_dc.DrawLine(startX, nextY, endX, nextY);
+	  if (startX > endX) {
+	    p_dc.DrawLine(endX, nextY, endX + m_infosetSpacing / 2,
+			  nextY + m_infosetSpacing / 2);
+	    p_dc.DrawLine(endX, nextY, endX + m_infosetSpacing / 2,
+			  nextY - m_infosetSpacing / 2);
+	  }
+	  else {
+	    p_dc.DrawLine(endX, nextY, endX - m_infosetSpacing / 2,
+			  nextY + m_infosetSpacing / 2);
+	    p_dc.DrawLine(endX, nextY, endX - m_infosetSpacing / 2,
+			  nextY - m_infosetSpacing / 2);
+	  }
 	}
       }
     }
 
-    if (entry->GetNode()->NumChildren() == 0) {
-      entry->Draw(p_dc, m_doc->GetSelectNode(), p_noHints);
-    }
-
     // As we draw, we determine the outcome label extents.  Adjust the
     // overall size of the plot accordingly.
     if (entry->GetOutcomeExtent().GetRight() > m_maxX) {
@@ -1003,6 +1218,12 @@ void gbtTreeLayout::RenderSubtree(wxDC &p_dc, bool p_noHints) const
 
 void gbtTreeLayout::Render(wxDC &p_dc, bool p_noHints) const
 { 
-  RenderSubtree(p_dc, p_noHints);
+  RenderSubtree(p_dc, wxRect(INT_MIN / 4, INT_MIN / 4, INT_MAX / 2, INT_MAX / 2),
+		p_noHints);
 }
 
+void gbtTreeLayout::Render(wxDC &p_dc, const wxRect &p_region,
+			   bool p_noHints) const
+{ 
+  RenderSubtree(p_dc, p_region, p_noHints);
+}
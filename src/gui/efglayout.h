@@ -23,6 +23,8 @@
 #ifndef EFGLAYOUT_H
 #define EFGLAYOUT_H
 
+#include <map>
+
 #include "libgambit/libgambit.h"
 #include "style.h"
 #include "gamedoc.h"
@@ -54,6 +56,7 @@ private:
 
   wxFont m_nodeAboveFont, m_nodeBelowFont;
   wxFont m_branchAboveFont, m_branchBelowFont;
+  bool m_labelsValid;  // false if labels must be regenerated before drawing
 
   const gbtStyle *m_style;
 
@@ -132,6 +135,9 @@ public:
   const wxFont &GetBranchBelowFont(void) const { return m_branchBelowFont; }
   void SetBranchBelowFont(const wxFont &p_font) { m_branchBelowFont = p_font; }
 
+  bool LabelsValid(void) const { return m_labelsValid; }
+  void SetLabelsValid(bool p_valid) { m_labelsValid = p_valid; }
+
   const double &GetActionProb(void) const { return m_actionProb; }
   void SetActionProb(const double &p_prob) { m_actionProb = p_prob; }
 
@@ -154,6 +160,7 @@ public:
   { return (m_branchBelowRect.Inside(p_x, p_y)); }
 #endif
 
+  void ClearExtents(void) const;
   const wxRect &GetOutcomeExtent(void) const { return m_outcomeRect; }
   const wxRect &GetPayoffExtent(int pl) const { return m_payoffRect[pl]; }
 
@@ -166,19 +173,41 @@ class gbtEfgDisplay;
 
 class gbtTreeLayout : public gbtGameView {
 private:
+  typedef std::map<Gambit::GameNodeRep *, gbtNodeEntry *> gbtEntryMap;
+
   gbtEfgDisplay *m_parent;
-  Gambit::Array<gbtNodeEntry *> m_nodeList;
+  Gambit::Array<gbtNodeEntry *> m_nodeList;  // entries in preorder
+  gbtEntryMap m_entries;                     // entries keyed by node
   mutable int m_maxX, m_maxY, m_maxLevel;
   int m_infosetSpacing;
 
-  const int c_leftMargin, c_topMargin;
+  // A uniform grid over the layout, used to cull rendering to the
+  // visible region and to locate candidates for hit tests.  Each cell
+  // lists (in m_cellEntries, starting at m_cellStart) the positions in
+  // m_nodeList of the entries whose drawing extent overlaps it.
+  Gambit::Array<wxRect> m_extents;
+  Gambit::Array<bool> m_drawn;
+  Gambit::Array<int> m_cellStart, m_cellEntries;
+  int m_gridCols, m_gridRows;
+  mutable Gambit::Array<int> m_mark, m_found;
+  mutable int m_stamp;
+
+  const int c_leftMargin, c_topMargin, c_gridSize;
+
+  // Tables used while assigning information set sublevels: the next
+  // member of each entry's information set, the sublevel assigned to
+  // each (information set, level) pair, and the largest on each level
+  std::map<gbtNodeEntry *, gbtNodeEntry *> m_nextInfoset;
+  std::map<std::pair<Gambit::GameInfosetRep *, int>, int> m_sublevels;
+  Gambit::Array<int> m_maxSublevel;
 
   gbtNodeEntry *GetEntry(Gambit::GameNode) const;
 
   gbtNodeEntry *NextInfoset(gbtNodeEntry *);
   void CheckInfosetEntry(gbtNodeEntry *);
 
-  void BuildNodeList(Gambit::GameNode, const Gambit::BehavSupport &, int);
+  void BuildNodeList(Gambit::GameNode, const Gambit::BehavSupport &, int,
+		     gbtEntryMap &, int &);
 
   int LayoutSubtree(Gambit::GameNode, const Gambit::BehavSupport &, int &, int &, int &);
   void FillInfosetTable(Gambit::GameNode, const Gambit::BehavSupport &);
@@ -187,8 +216,14 @@ private:
 
   wxString CreateNodeLabel(const gbtNodeEntry *, int) const;
   wxString CreateBranchLabel(const gbtNodeEntry *, int) const;
+  void GenerateLabels(gbtNodeEntry *) const;
+
+  void BuildIndex(void);
+  int GridColumn(int p_x) const;
+  int GridRow(int p_y) const;
+  int FindEntries(const wxRect &) const;
 
-  void RenderSubtree(wxDC &dc, bool p_noHints) const;
+  void RenderSubtree(wxDC &dc, const wxRect &p_region, bool p_noHints) const;
 
   // Overriding gbtGameView members
   void OnUpdate(void) { }
@@ -220,6 +255,7 @@ public:
   Gambit::GameNode InfosetHitTest(int, int) const;
 
   void Render(wxDC &, bool p_noHints) const;
+  void Render(wxDC &, const wxRect &p_region, bool p_noHints) const;
 };
 
 #endif  // EFGLAYOUT_H
@@ -725,19 +725,49 @@ wxPrintout *gbtEfgPanel::GetPrintout(void)
 				     *wxConvCurrent));
 }
 
-bool gbtEfgPanel::GetBitmap(wxBitmap &p_bitmap, int p_marginX, int p_marginY)
+//
+// The largest image, in pixels, we will attempt to export.  Images are
+// stored with three bytes per pixel, so this is about 400MB.
+//
+const double c_maxImagePixels = 134217728.0;
+
+bool gbtEfgPanel::GetImage(wxImage &p_image, int p_marginX, int p_marginY)
 {
-  if (m_treeWindow->GetLayout().MaxX() > 65000 ||
-      m_treeWindow->GetLayout().MaxY() > 65000) {
+  const gbtTreeLayout &layout = m_treeWindow->GetLayout();
+  int width = layout.MaxX() + 2 * p_marginX;
+  int height = layout.MaxY() + 2 * p_marginY;
+
+  if ((double) width * (double) height > c_maxImagePixels) {
     // This is just too huge to export to graphics
     return false;
   }
 
-  wxMemoryDC dc;
-  p_bitmap = wxBitmap(m_treeWindow->GetLayout().MaxX() + 2 * p_marginX,
-		      m_treeWindow->GetLayout().MaxY() + 2 * p_marginY);
-  dc.SelectObject(p_bitmap);
-  RenderGame(dc, p_marginX, p_marginY);
+  p_image.Create(width, height, false);
+  if (!p_image.Ok())  return false;
+
+  // The tree is drawn one tile at a time into a single small bitmap,
+  // and each tile copied into the image.  Device-dependent bitmaps are
+  // limited in size on most platforms, and only the nodes in the region
+  // of each tile need to be visited.
+  const int tileSize = 1024;
+  wxBitmap tile(tileSize, tileSize);
+
+  for (int y = 0; y < height; y += tileSize) {
+    for (int x = 0; x < width; x += tileSize) {
+      wxMemoryDC dc;
+      dc.SelectObject(tile);
+      dc.SetBackground(*wxWHITE_BRUSH);
+      dc.SetUserScale(1.0, 1.0);
+      dc.SetDeviceOrigin(p_marginX - x, p_marginY - y);
+      dc.Clear();
+      layout.Render(dc, wxRect(x - p_marginX, y - p_marginY,
+			       tileSize, tileSize), true);
+      dc.SelectObject(wxNullBitmap);
+      // Paste() clips the tiles along the right and bottom edges
+      p_image.Paste(tile.ConvertToImage(), x, y);
+    }
+  }
+
   return true;
 }
 
@@ -777,8 +807,6 @@ void gbtEfgPanel::RenderGame(wxDC &p_dc, int p_marginX, int p_marginY)
   double posY = (double) ((h - (maxY * scale)) / 2.0);
   p_dc.SetDeviceOrigin((int) posX, (int) posY);
 
-  printf("Drawing with scale %f\n", scale);
-
   // Draw!
   m_treeWindow->OnDraw(p_dc, scale);
 }
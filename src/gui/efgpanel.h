@@ -26,6 +26,7 @@
 #include "gamedoc.h"
 
 class wxPrintout;
+class wxImage;
 class gbtEfgDisplay;
 
 class gbtEfgPanel : public wxPanel, public gbtGameView {
@@ -53,8 +54,8 @@ public:
   //@{
   /// Creates a printout object of the game as currently displayed
   wxPrintout *GetPrintout(void);
-  /// Creates a bitmap of the game as currently displayed
-  bool GetBitmap(wxBitmap &, int marginX, int marginY);
+  /// Creates an image of the game as currently displayed
+  bool GetImage(wxImage &, int marginX, int marginY);
   /// Outputs the game as currently displayed to a SVG file
   void GetSVG(const wxString &p_filename, int marginX, int marginY);
   /// Prints the game as currently displayed, centered on the DC
@@ -20,6 +20,8 @@
 // Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 //
 
+#include <cstdlib>
+#include <cctype>
 #include <sstream>
 #include <fstream>
 
@@ -41,7 +43,7 @@
 
 gbtBehavDominanceStack::gbtBehavDominanceStack(gbtGameDocument *p_doc,
 					       bool p_strict)
-  : m_doc(p_doc), m_strict(p_strict), m_noFurther(false)
+  : m_doc(p_doc), m_strict(p_strict), m_noFurther(false), m_eliminator(0)
 {
   Reset();
 }
@@ -49,21 +51,30 @@ gbtBehavDominanceStack::gbtBehavDominanceStack(gbtGameDocument *p_doc,
 gbtBehavDominanceStack::~gbtBehavDominanceStack()
 {
   for (int i = 1; i <= m_supports.Length(); delete m_supports[i++]);
+  if (m_eliminator)  delete m_eliminator;
 }
 
 void gbtBehavDominanceStack::SetStrict(bool p_strict)
 {
-  if (m_strict != p_strict)  Reset();
-  m_strict = p_strict;
+  if (m_strict != p_strict) {
+    m_strict = p_strict;
+    Reset();
+  }
 }
 
 void gbtBehavDominanceStack::Reset(void)
 {
   for (int i = 1; i <= m_supports.Length(); delete m_supports[i++]);
   m_supports = Gambit::Array<Gambit::BehavSupport *>();
+  if (m_eliminator) {
+    delete m_eliminator;
+    m_eliminator = 0;
+  }
   if (m_doc->IsTree()) {
     m_supports.Append(new Gambit::BehavSupport(m_doc->GetGame()));
     m_current = 1;
+    m_eliminator = new Gambit::ActionEliminator(*m_supports[1], 
+						m_strict, true);
   }
   m_noFurther = false;
 }
@@ -79,17 +90,8 @@ bool gbtBehavDominanceStack::NextLevel(void)
     return false;
   }
 
-  Gambit::Array<int> players;
-  for (int pl = 1; pl <= m_doc->GetGame()->NumPlayers(); pl++) {
-    players.Append(pl);
-  }
-  
-  std::ostringstream gnull;
-  Gambit::BehavSupport newSupport = 
-    m_supports[m_current]->Undominated(m_strict, true, players, gnull);
-
-  if (newSupport != *m_supports[m_current]) {
-    m_supports.Append(new Gambit::BehavSupport(newSupport));
+  if (m_eliminator->NextRound()) {
+    m_supports.Append(new Gambit::BehavSupport(m_eliminator->GetSupport()));
     m_current++;
     return true;
   }
@@ -116,7 +118,8 @@ bool gbtBehavDominanceStack::PreviousLevel(void)
 
 gbtStrategyDominanceStack::gbtStrategyDominanceStack(gbtGameDocument *p_doc,
 						     bool p_strict)
-  : m_doc(p_doc), m_strict(p_strict), m_noFurther(false)
+  : m_doc(p_doc), m_strict(p_strict), m_noFurther(false), m_eliminator(0),
+    m_dominanceLevel(0)
 {
   Reset();
 }
@@ -124,23 +127,32 @@ gbtStrategyDominanceStack::gbtStrategyDominanceStack(gbtGameDocument *p_doc,
 gbtStrategyDominanceStack::~gbtStrategyDominanceStack()
 {
   for (int i = 1; i <= m_supports.Length(); delete m_supports[i++]);
+  if (m_eliminator)  delete m_eliminator;
 }
 
 void gbtStrategyDominanceStack::SetStrict(bool p_strict)
 {
-  if (m_strict != p_strict)  Reset();
-  m_strict = p_strict;
+  if (m_strict != p_strict) {
+    m_strict = p_strict;
+    Reset();
+  }
 }
 
 void gbtStrategyDominanceStack::Reset(void)
 {
   for (int i = 1; i <= m_supports.Length(); delete m_supports[i++]);
   m_supports = Gambit::Array<Gambit::StrategySupport *>();
+  m_dominanceLevel = 0;
+  if (m_eliminator) {
+    delete m_eliminator;
+    m_eliminator = 0;
+  }
 
   if (m_doc->GetGame()->HasComputedValues()) {
     m_supports.Append(new Gambit::StrategySupport(m_doc->GetGame()));
     m_current = 1;
     m_noFurther = false;
+    m_eliminator = new Gambit::StrategyEliminator(*m_supports[1], m_strict);
   }
 }
 
@@ -155,16 +167,8 @@ bool gbtStrategyDominanceStack::NextLevel(void)
     return false;
   }
 
-  Gambit::Array<int> players;
-  for (int pl = 1; pl <= m_doc->GetGame()->NumPlayers(); pl++) {
-    players.Append(pl);
-  }
-
-  Gambit::StrategySupport newSupport = 
-    m_supports[m_current]->Undominated(m_strict, players);
-
-  if (newSupport != *m_supports[m_current]) {
-    m_supports.Append(new Gambit::StrategySupport(newSupport));
+  if (m_eliminator->NextRound()) {
+    m_supports.Append(new Gambit::StrategySupport(m_eliminator->GetSupport()));
     m_current++;
     return true;
   }
@@ -185,6 +189,35 @@ bool gbtStrategyDominanceStack::PreviousLevel(void)
   }
 }
 
+//
+// Supports in the stack are never changed once created, and the whole
+// stack is rebuilt by Reset() whenever the game or its payoffs change,
+// so the cached status is valid as long as the level is the same.
+//
+gbtDominanceType 
+gbtStrategyDominanceStack::GetDominance(const Gambit::GameStrategy &p_strategy) const
+{
+  if (m_dominanceLevel != m_current) {
+    const Gambit::StrategySupport &support = *m_supports[m_current];
+    Gambit::Game game = m_doc->GetGame();
+    m_dominance = Gambit::Array<int>(game->MixedProfileLength());
+    for (int i = 1; i <= m_dominance.Length(); m_dominance[i++] = GBT_DOMINANCE_NONE);
+
+    for (int pl = 1; pl <= game->NumPlayers(); pl++) {
+      for (int st = 1; st <= support.NumStrategies(pl); st++) {
+	Gambit::GameStrategy strategy = support.GetStrategy(pl, st);
+	if (support.IsDominated(strategy, false)) {
+	  m_dominance[strategy->GetId()] = 
+	    (support.IsDominated(strategy, true)) ? GBT_DOMINANCE_STRICT : GBT_DOMINANCE_WEAK;
+	}
+      }
+    }
+    m_dominanceLevel = m_current;
+  }
+
+  return (gbtDominanceType) m_dominance[p_strategy->GetId()];
+}
+
 //=========================================================================
 //                          class gbtGameDocument
 //=========================================================================
@@ -193,19 +226,18 @@ gbtGameDocument::gbtGameDocument(Gambit::Game p_game)
   : m_game(p_game),
     m_selectNode(0), m_modified(false),
     m_behavSupports(this, true), m_stratSupports(this, true),
-    m_currentProfileList(0)
+    m_currentProfileList(0), m_editsSinceCheckpoint(0)
 {
   m_game->Canonicalize();
   wxGetApp().AddDocument(this);
-
-  std::ostringstream s;
-  SaveDocument(s);
-  m_undoList.Append(s.str());
+  PushUndo(GBT_DOC_MODIFIED_NONE);
 }
 
 gbtGameDocument::~gbtGameDocument()
 {
   wxGetApp().RemoveDocument(this);
+  for (int i = 1; i <= m_undoList.Length(); delete m_undoList[i++]);
+  for (int i = 1; i <= m_redoList.Length(); delete m_redoList[i++]);
 }
 
 bool gbtGameDocument::LoadDocument(const wxString &p_filename,
@@ -260,9 +292,41 @@ bool gbtGameDocument::LoadDocument(const wxString &p_filename,
   m_behavSupports.Reset();
   m_stratSupports.Reset();
 
-  m_profiles = Gambit::List<gbtAnalysisOutput *>();
+  LoadProfiles(game);
+
+  TiXmlNode *colors = docroot->FirstChild("colors");
+  if (colors)  m_style.SetColorXML(colors);
+  TiXmlNode *font = docroot->FirstChild("font");
+  if (font)    m_style.SetFontXML(font);
+  TiXmlNode *layout = docroot->FirstChild("autolayout");
+  if (layout)  m_style.SetLayoutXML(layout);
+  TiXmlNode *labels = docroot->FirstChild("labels");
+  if (labels)  m_style.SetLabelXML(labels);
+  TiXmlNode *numbers = docroot->FirstChild("numbers");
+  if (numbers) {
+    int numDecimals = 4;
+    numbers->ToElement()->QueryIntAttribute("decimals", &numDecimals);
+    m_style.SetNumDecimals(numDecimals);
+  }
+
+  if (p_saveUndo) {
+    PushUndo(GBT_DOC_MODIFIED_GAME);
+  }
+
+  return true;
+}
+
+//
+// Replaces the profile lists by those in the <analysis> children of
+// the <game> element
+//
+void gbtGameDocument::LoadProfiles(TiXmlNode *p_game)
+{
+  while (m_profiles.Length() > 0) {
+    delete m_profiles.Remove(1);
+  }
 
-  for (TiXmlNode *analysis = game->FirstChild("analysis");
+  for (TiXmlNode *analysis = p_game->FirstChild("analysis");
        analysis; analysis = analysis->NextSibling()) {
     const char *type = analysis->ToElement()->Attribute("type");
     // const char *rep = analysis->ToElement()->Attribute("rep");
@@ -295,29 +359,15 @@ bool gbtGameDocument::LoadDocument(const wxString &p_filename,
   }
 
   m_currentProfileList = m_profiles.Length();
+}
 
-  TiXmlNode *colors = docroot->FirstChild("colors");
-  if (colors)  m_style.SetColorXML(colors);
-  TiXmlNode *font = docroot->FirstChild("font");
-  if (font)    m_style.SetFontXML(font);
-  TiXmlNode *layout = docroot->FirstChild("autolayout");
-  if (layout)  m_style.SetLayoutXML(layout);
-  TiXmlNode *labels = docroot->FirstChild("labels");
-  if (labels)  m_style.SetLabelXML(labels);
-  TiXmlNode *numbers = docroot->FirstChild("numbers");
-  if (numbers) {
-    int numDecimals = 4;
-    numbers->ToElement()->QueryIntAttribute("decimals", &numDecimals);
-    m_style.SetNumDecimals(numDecimals);
-  }
-
-  if (p_saveUndo) {
-    std::ostringstream s;
-    SaveDocument(s);
-    m_undoList.Append(s.str());
+std::string gbtGameDocument::SaveProfiles(void) const
+{
+  std::ostringstream s;
+  for (int i = 1; i <= m_profiles.Length(); i++) {
+    m_profiles[i]->Save(s);
   }
-
-  return true;
+  return s.str();
 }
 
 void gbtGameDocument::SaveDocument(std::ostream &p_file) const
@@ -350,27 +400,15 @@ void gbtGameDocument::SaveDocument(std::ostream &p_file) const
     p_file << "</nfgfile>\n";
   }
 
-  for (int i = 1; i <= m_profiles.Length(); i++) {
-    m_profiles[i]->Save(p_file);
-  }
+  p_file << SaveProfiles();
 
   p_file << "</game>\n";
 
   p_file << "</gambit:document>\n";
 }
 
-void gbtGameDocument::UpdateViews(gbtGameModificationType p_modifications)
+void gbtGameDocument::InvalidateComputed(gbtGameModificationType p_modifications)
 {
-  if (p_modifications != GBT_DOC_MODIFIED_NONE) {
-    m_modified = true;
-    m_game->Canonicalize();
-    m_redoList = Gambit::List<std::string>();
-
-    std::ostringstream s;
-    SaveDocument(s);
-    m_undoList.Append(s.str());
-  }
-
   if (p_modifications == GBT_DOC_MODIFIED_GAME ||
       p_modifications == GBT_DOC_MODIFIED_PAYOFFS) {
     m_behavSupports.Reset();
@@ -385,6 +423,23 @@ void gbtGameDocument::UpdateViews(gbtGameModificationType p_modifications)
     }
     m_currentProfileList = 0;
   }
+}
+
+void gbtGameDocument::UpdateViews(gbtGameModificationType p_modifications)
+{
+  if (p_modifications != GBT_DOC_MODIFIED_NONE) {
+    m_modified = true;
+    m_game->Canonicalize();
+    // Computed values are wiped out before the undo step is stored, so
+    // that its checkpoint only holds profiles of the game it records
+    InvalidateComputed(p_modifications);
+    PushUndo(p_modifications);
+  }
+
+  m_lastProfiles = SaveProfiles();
+#ifdef __WXDEBUG__
+  m_lastDocument = SaveDebugDocument();
+#endif  // __WXDEBUG__
 
   for (int i = 1; i <= m_views.Length(); m_views[i++]->OnUpdate());
 }
@@ -411,41 +466,317 @@ void gbtGameDocument::SetStyle(const gbtStyle &p_style)
 
 //
 // A word about the undo and redo features:
-// We store a list of the textual representation of games.  We don't
-// store other aspects of the state (e.g., profiles) as yet.
-// The "undo" list includes the representation of the current state
-// of the game (hence, CanUndo() only returns true when the list has
-// more than one element.
+// The undo list holds a gbtUndoStep for each modification of the
+// document, including its style and the list of profile lists, the
+// last being the one which produced the current state (hence,
+// CanUndo() only returns true when the list has more than one
+// element).  The first step always has a checkpoint.  The profiles
+// are restored from the copies in the steps, since they may change
+// without a step of their own, when a computation adds profiles.
 //
-void gbtGameDocument::Undo(void)
+
+// Every this many steps of edits also store a checkpoint
+const int c_checkpointInterval = 100;
+// The history is trimmed (back to a checkpoint) to about this size
+const int c_maxUndoBytes = 64 * 1024 * 1024;
+const int c_maxUndoSteps = 1000;
+
+static Gambit::Array<int> UndoAddress(int p_index1)
 {
-  // The current game is at the end of the undo list; move it to the redo list
-  m_redoList.Append(m_undoList[m_undoList.Length()]);
-  m_undoList.Remove(m_undoList.Length());
+  Gambit::Array<int> where(1);
+  where[1] = p_index1;
+  return where;
+}
 
-  m_game = 0;
+static Gambit::Array<int> UndoAddress(int p_index1, int p_index2)
+{
+  Gambit::Array<int> where(2);
+  where[1] = p_index1;
+  where[2] = p_index2;
+  return where;
+}
 
-  while (m_profiles.Length() > 0) {
-    delete m_profiles.Remove(1);
+static Gambit::Array<int> UndoAddress(GameNode p_node)
+{
+  int depth = 0;
+  for (GameNode node = p_node; node->GetParent(); node = node->GetParent()) {
+    depth++;
   }
-  m_currentProfileList = 0;
+  Gambit::Array<int> where(depth);
+  for (GameNode node = p_node; node->GetParent(); node = node->GetParent()) {
+    where[depth--] = node->GetPriorAction()->GetNumber();
+  }
+  return where;
+}
 
-  wxString tempfile = wxFileName::CreateTempFileName(wxT("gambit"));
-  std::ofstream f((const char *) tempfile.mb_str());
-  f << m_undoList[m_undoList.Length()] << std::endl;
-  f.close();
+//
+// Information sets are renumbered when a checkpoint is reloaded, so
+// they are addressed by the path to one of their members, followed
+// by the number of the action (zero if none).
+//
+static Gambit::Array<int> UndoAddress(GameInfoset p_infoset, int p_action)
+{
+  Gambit::Array<int> where = UndoAddress(p_infoset->GetMember(1));
+  where.Append(p_action);
+  return where;
+}
 
-  LoadDocument(tempfile, false);
-  wxRemoveFile(tempfile);
+static GameNode UndoNode(Game p_game, const Gambit::Array<int> &p_where,
+			 int p_depth)
+{
+  GameNode node = p_game->GetRoot();
+  for (int i = 1; i <= p_depth; i++) {
+    node = node->GetChild(p_where[i]);
+  }
+  return node;
+}
 
-  for (int i = 1; i <= m_views.Length(); m_views[i++]->OnUpdate());
+static GameNode UndoNode(Game p_game, const Gambit::Array<int> &p_where)
+{
+  return UndoNode(p_game, p_where, p_where.Length());
 }
 
-void gbtGameDocument::Redo(void)
+static GameInfoset UndoInfoset(Game p_game, const Gambit::Array<int> &p_where)
+{
+  return UndoNode(p_game, p_where, p_where.Length() - 1)->GetInfoset();
+}
+
+//
+// Reading a tree back from a file numbers the outcomes in the order
+// they are first met, and drops those at no node.  Edits refer to
+// outcomes by number, so they can only be redone on a reloaded
+// checkpoint if the numbers of the game agree with that order.
+//
+static bool StableOutcomes(GameNode p_node, int &p_next)
+{
+  GameOutcome outcome = p_node->GetOutcome();
+  if (outcome && outcome->GetNumber() >= p_next) {
+    if (outcome->GetNumber() > p_next)  return false;
+    p_next++;
+  }
+  for (int i = 1; i <= p_node->NumChildren(); i++) {
+    if (!StableOutcomes(p_node->GetChild(i), p_next))  return false;
+  }
+  return true;
+}
+
+static bool StableOutcomes(Game p_game)
+{
+  if (!p_game->IsTree())  return true;
+  int next = 1;
+  return (StableOutcomes(p_game->GetRoot(), next) &&
+	  next == p_game->NumOutcomes() + 1);
+}
+
+//
+// Likewise for the information sets of each player.  Profiles list
+// their entries in the order of the information sets, so they can
+// only be restored on a reloaded checkpoint if these numbers agree.
+// Canonicalize() keeps them in this order for the most part.
+//
+static bool StableInfosets(GameNode p_node, Gambit::Array<int> &p_next)
+{
+  GameInfoset infoset = p_node->GetInfoset();
+  if (infoset) {
+    int &next = p_next[infoset->GetPlayer()->GetNumber()];
+    if (infoset->GetNumber() >= next) {
+      if (infoset->GetNumber() > next)  return false;
+      next++;
+    }
+  }
+  for (int i = 1; i <= p_node->NumChildren(); i++) {
+    if (!StableInfosets(p_node->GetChild(i), p_next))  return false;
+  }
+  return true;
+}
+
+static bool StableInfosets(Game p_game)
+{
+  if (!p_game->IsTree())  return true;
+  Gambit::Array<int> next(0, p_game->NumPlayers());
+  for (int pl = 0; pl <= p_game->NumPlayers(); next[pl++] = 1);
+  if (!StableInfosets(p_game->GetRoot(), next) ||
+      next[0] != p_game->GetChance()->NumInfosets() + 1) {
+    return false;
+  }
+  for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
+    if (next[pl] != p_game->GetPlayer(pl)->NumInfosets() + 1)  return false;
+  }
+  return true;
+}
+
+static bool StableNumbering(Game p_game)
+{
+  return StableOutcomes(p_game) && StableInfosets(p_game);
+}
+
+gbtUndoEdit gbtGameDocument::NewEdit(gbtUndoEditType p_type,
+				     const Gambit::Array<int> &p_where) const
+{
+  gbtUndoEdit edit(p_type, p_where);
+  edit.m_oldValue = GetUndoValue(edit);
+  return edit;
+}
+
+std::string gbtGameDocument::GetUndoValue(const gbtUndoEdit &p_edit) const
+{
+  const Gambit::Array<int> &where = p_edit.m_where;
+
+  switch (p_edit.m_type) {
+  case GBT_UNDO_TITLE:
+    return m_game->GetTitle();
+  case GBT_UNDO_COMMENT:
+    return m_game->GetComment();
+  case GBT_UNDO_PLAYER_LABEL:
+    return m_game->GetPlayer(where[1])->GetLabel();
+  case GBT_UNDO_STRATEGY_LABEL:
+    return m_game->GetPlayer(where[1])->GetStrategy(where[2])->GetLabel();
+  case GBT_UNDO_INFOSET_LABEL:
+    return UndoInfoset(m_game, where)->GetLabel();
+  case GBT_UNDO_ACTION_LABEL:
+    return UndoInfoset(m_game, where)->GetAction(where[where.Length()])->GetLabel();
+  case GBT_UNDO_ACTION_PROB:
+    return UndoInfoset(m_game, where)->GetActionProb<std::string>(where[where.Length()]);
+  case GBT_UNDO_NODE_LABEL:
+    return UndoNode(m_game, where)->GetLabel();
+  case GBT_UNDO_NODE_OUTCOME: {
+    GameOutcome outcome = UndoNode(m_game, where)->GetOutcome();
+    return lexical_cast<std::string>((outcome) ? outcome->GetNumber() : 0);
+  }
+  case GBT_UNDO_PAYOFF:
+    return m_game->GetOutcome(where[1])->GetPayoff<std::string>(where[2]);
+  default:
+    return "";
+  }
+}
+
+void gbtGameDocument::SetUndoValue(const gbtUndoEdit &p_edit,
+				   const std::string &p_value)
+{
+  const Gambit::Array<int> &where = p_edit.m_where;
+
+  switch (p_edit.m_type) {
+  case GBT_UNDO_TITLE:
+    m_game->SetTitle(p_value);
+    break;
+  case GBT_UNDO_COMMENT:
+    m_game->SetComment(p_value);
+    break;
+  case GBT_UNDO_PLAYER_LABEL:
+    m_game->GetPlayer(where[1])->SetLabel(p_value);
+    break;
+  case GBT_UNDO_STRATEGY_LABEL:
+    m_game->GetPlayer(where[1])->GetStrategy(where[2])->SetLabel(p_value);
+    break;
+  case GBT_UNDO_INFOSET_LABEL:
+    UndoInfoset(m_game, where)->SetLabel(p_value);
+    break;
+  case GBT_UNDO_ACTION_LABEL:
+    UndoInfoset(m_game, where)->GetAction(where[where.Length()])->SetLabel(p_value);
+    break;
+  case GBT_UNDO_ACTION_PROB:
+    UndoInfoset(m_game, where)->SetActionProb(where[where.Length()], p_value);
+    break;
+  case GBT_UNDO_NODE_LABEL:
+    UndoNode(m_game, where)->SetLabel(p_value);
+    break;
+  case GBT_UNDO_NODE_OUTCOME: {
+    int outcome = atoi(p_value.c_str());
+    if (outcome > 0) {
+      UndoNode(m_game, where)->SetOutcome(m_game->GetOutcome(outcome));
+    }
+    else {
+      UndoNode(m_game, where)->SetOutcome(0);
+    }
+    break;
+  }
+  case GBT_UNDO_PAYOFF:
+    m_game->GetOutcome(where[1])->SetPayoff(where[2], p_value);
+    break;
+  }
+}
+
+//
+// Appends a step for the modification just made to the undo list.
+// The edits made by the modification are expected in m_pendingEdits;
+// if there are none, the step stores a checkpoint.
+//
+void gbtGameDocument::PushUndo(gbtGameModificationType p_modifications)
+{
+  for (int i = 1; i <= m_redoList.Length(); delete m_redoList[i++]);
+  m_redoList = Gambit::List<gbtUndoStep *>();
+
+  gbtUndoStep *step = new gbtUndoStep;
+  step->m_modifications = p_modifications;
+  // The profile lists may already have been changed, and wiped out,
+  // by the modification; the step records them as last shown
+  step->m_profilesBefore = m_lastProfiles;
+  step->m_edits = m_pendingEdits;
+  m_pendingEdits = Gambit::List<gbtUndoEdit>();
+  for (int i = 1; i <= step->m_edits.Length(); i++) {
+    step->m_edits[i].m_newValue = GetUndoValue(step->m_edits[i]);
+  }
+
+  // Edits may be redone on a reloaded game only if it keeps its
+  // numbers both before and after them
+  step->m_stableNumbering = StableNumbering(m_game);
+  if (!step->m_stableNumbering || 
+      (m_undoList.Length() > 0 &&
+       !m_undoList[m_undoList.Length()]->m_stableNumbering)) {
+    step->m_edits = Gambit::List<gbtUndoEdit>();
+  }
+
+  if (step->m_edits.Length() == 0 || 
+      ++m_editsSinceCheckpoint >= c_checkpointInterval) {
+    std::ostringstream s;
+    SaveDocument(s);
+    step->m_checkpoint = s.str();
+    m_editsSinceCheckpoint = 0;
+  }
+
+  m_lastProfiles = SaveProfiles();
+#ifdef __WXDEBUG__
+  step->m_documentBefore = m_lastDocument;
+  m_lastDocument = SaveDebugDocument();
+#endif  // __WXDEBUG__
+
+  m_undoList.Append(step);
+  TrimUndo();
+}
+
+//
+// Drops the oldest steps while the history is too large.  The list
+// must start with a checkpoint, so steps are dropped up to the next
+// one; the history may stay over the limits if there is none.
+//
+void gbtGameDocument::TrimUndo(void)
 {
-  m_undoList.Append(m_redoList[m_redoList.Length()]);
-  m_redoList.Remove(m_redoList.Length());
+  long bytes = 0;
+  for (int i = 1; i <= m_undoList.Length(); i++) {
+    bytes += (m_undoList[i]->m_checkpoint.length() +
+	      m_undoList[i]->m_profilesBefore.length());
+  }
 
+  while (bytes > c_maxUndoBytes || m_undoList.Length() > c_maxUndoSteps) {
+    int next = 2;
+    while (next < m_undoList.Length() && 
+	   m_undoList[next]->m_checkpoint.empty()) {
+      next++;
+    }
+    if (next >= m_undoList.Length()) {
+      // Never drop the step with the current state
+      break;
+    }
+    for (; next > 1; next--) {
+      gbtUndoStep *step = m_undoList.Remove(1);
+      bytes -= step->m_checkpoint.length() + step->m_profilesBefore.length();
+      delete step;
+    }
+  }
+}
+
+void gbtGameDocument::LoadCheckpoint(const std::string &p_checkpoint)
+{
   m_game = 0;
 
   while (m_profiles.Length() > 0) {
@@ -455,15 +786,127 @@ void gbtGameDocument::Redo(void)
 
   wxString tempfile = wxFileName::CreateTempFileName(wxT("gambit"));
   std::ofstream f((const char *) tempfile.mb_str());
-  f << m_undoList[m_undoList.Length()] << std::endl;
+  f << p_checkpoint << std::endl;
   f.close();
 
   LoadDocument(tempfile, false);
   wxRemoveFile(tempfile);
+}
 
+void gbtGameDocument::RestoreProfiles(const std::string &p_profiles)
+{
+  TiXmlDocument doc;
+  doc.Parse(("<game>" + p_profiles + "</game>").c_str());
+  LoadProfiles(doc.FirstChild("game"));
+}
+
+void gbtGameDocument::Undo(void)
+{
+  // The current state is at the end of the undo list; move it to the redo list
+  gbtUndoStep *step = m_undoList.Remove(m_undoList.Length());
+  m_redoList.Append(step);
+  step->m_profilesAfter = SaveProfiles();
+#ifdef __WXDEBUG__
+  step->m_documentAfter = SaveDebugDocument();
+#endif  // __WXDEBUG__
+
+  if (step->m_edits.Length() > 0) {
+    for (int i = step->m_edits.Length(); i >= 1; i--) {
+      SetUndoValue(step->m_edits[i], step->m_edits[i].m_oldValue);
+    }
+    InvalidateComputed(step->m_modifications);
+  }
+  else {
+    // Go back to the most recent checkpoint, and redo the edits after it
+    int base = m_undoList.Length();
+    while (m_undoList[base]->m_checkpoint.empty())  base--;
+    LoadCheckpoint(m_undoList[base]->m_checkpoint);
+    for (int i = base + 1; i <= m_undoList.Length(); i++) {
+      gbtUndoStep *edits = m_undoList[i];
+      for (int j = 1; j <= edits->m_edits.Length(); j++) {
+	SetUndoValue(edits->m_edits[j], edits->m_edits[j].m_newValue);
+      }
+      InvalidateComputed(edits->m_modifications);
+    }
+  }
+
+  // Profiles cannot be read back onto a reloaded game which numbers
+  // its information sets differently
+  bool stable = m_undoList[m_undoList.Length()]->m_stableNumbering;
+  RestoreProfiles((stable) ? step->m_profilesBefore : "");
+  m_lastProfiles = SaveProfiles();
+
+#ifdef __WXDEBUG__
+  CheckUndoState(step->m_documentBefore, stable);
+  m_lastDocument = SaveDebugDocument();
+#endif  // __WXDEBUG__
   for (int i = 1; i <= m_views.Length(); m_views[i++]->OnUpdate());
 }
 
+void gbtGameDocument::Redo(void)
+{
+  gbtUndoStep *step = m_redoList.Remove(m_redoList.Length());
+  m_undoList.Append(step);
+
+  if (step->m_edits.Length() > 0) {
+    for (int i = 1; i <= step->m_edits.Length(); i++) {
+      SetUndoValue(step->m_edits[i], step->m_edits[i].m_newValue);
+    }
+    InvalidateComputed(step->m_modifications);
+  }
+  else {
+    LoadCheckpoint(step->m_checkpoint);
+  }
+  RestoreProfiles((step->m_stableNumbering) ? step->m_profilesAfter : "");
+  m_lastProfiles = SaveProfiles();
+
+#ifdef __WXDEBUG__
+  CheckUndoState(step->m_documentAfter, step->m_stableNumbering);
+  m_lastDocument = SaveDebugDocument();
+#endif  // __WXDEBUG__
+  for (int i = 1; i <= m_views.Length(); m_views[i++]->OnUpdate());
+}
+
+#ifdef __WXDEBUG__
+//
+// The document as written by SaveDocument(), with runs of whitespace
+// collapsed, as reading a checkpoint does.  Player colors are set
+// when first drawn; they are set here, so that it does not matter
+// whether that has happened yet.
+//
+std::string gbtGameDocument::SaveDebugDocument(void) const
+{
+  if (m_game->NumPlayers() > 0) {
+    m_style.GetPlayerColor(m_game->NumPlayers());
+  }
+  std::ostringstream s;
+  SaveDocument(s);
+  std::string text = s.str(), ret;
+  for (std::string::size_type i = 0; i < text.length(); i++) {
+    if (!isspace(text[i])) {
+      ret += text[i];
+    }
+    else if (ret.length() > 0 && ret[ret.length() - 1] != ' ') {
+      ret += ' ';
+    }
+  }
+  return ret;
+}
+
+//
+// Checks that undo or redo has brought back the document as it was.
+// Reloading a tree may renumber its outcomes and information sets, so
+// the check is only made when it does not.
+//
+void gbtGameDocument::CheckUndoState(const std::string &p_document,
+				     bool p_stable) const
+{
+  if (!p_stable)  return;
+  wxASSERT_MSG(SaveDebugDocument() == p_document,
+	       wxT("Undo or redo did not restore the document"));
+}
+#endif  // __WXDEBUG__
+
 
 void gbtGameDocument::SetCurrentProfile(int p_profile)
 {
@@ -635,6 +1078,8 @@ void gbtGameDocument::DoExportNfg(const wxString &p_filename)
 void gbtGameDocument::DoSetTitle(const wxString &p_title, 
 				 const wxString &p_comment)
 {
+  m_pendingEdits.Append(NewEdit(GBT_UNDO_TITLE, Gambit::Array<int>()));
+  m_pendingEdits.Append(NewEdit(GBT_UNDO_COMMENT, Gambit::Array<int>()));
   m_game->SetTitle(static_cast<const char *>(p_title.mb_str()));
   m_game->SetComment(static_cast<const char *>(p_comment.mb_str()));
   UpdateViews(GBT_DOC_MODIFIED_LABELS);
@@ -654,7 +1099,10 @@ void gbtGameDocument::DoNewPlayer(void)
 void gbtGameDocument::DoSetPlayerLabel(GamePlayer p_player,
 				       const wxString &p_label)
 {
+  gbtUndoEdit edit = NewEdit(GBT_UNDO_PLAYER_LABEL,
+			     UndoAddress(p_player->GetNumber()));
   p_player->SetLabel(static_cast<const char *>(p_label.mb_str()));
+  m_pendingEdits.Append(edit);
   UpdateViews(GBT_DOC_MODIFIED_LABELS);
 }
 
@@ -674,13 +1122,21 @@ void gbtGameDocument::DoDeleteStrategy(GameStrategy p_strategy)
 void gbtGameDocument::DoSetStrategyLabel(GameStrategy p_strategy,
 					 const wxString &p_label)
 {
+  gbtUndoEdit edit = NewEdit(GBT_UNDO_STRATEGY_LABEL,
+			     UndoAddress(p_strategy->GetPlayer()->GetNumber(),
+					 p_strategy->GetNumber()));
   p_strategy->SetLabel(static_cast<const char *>(p_label.mb_str()));
+  m_pendingEdits.Append(edit);
   UpdateViews(GBT_DOC_MODIFIED_LABELS);
 }
 
 void gbtGameDocument::DoSetInfosetLabel(GameInfoset p_infoset,
 					const wxString &p_label)
 {
+  if (p_infoset->NumMembers() > 0) {
+    m_pendingEdits.Append(NewEdit(GBT_UNDO_INFOSET_LABEL,
+				  UndoAddress(p_infoset, 0)));
+  }
   p_infoset->SetLabel(static_cast<const char *>(p_label.mb_str()));
   UpdateViews(GBT_DOC_MODIFIED_LABELS);
 }
@@ -688,6 +1144,11 @@ void gbtGameDocument::DoSetInfosetLabel(GameInfoset p_infoset,
 void gbtGameDocument::DoSetActionLabel(GameAction p_action,
 				       const wxString &p_label)
 {
+  GameInfoset infoset = p_action->GetInfoset();
+  if (infoset->NumMembers() > 0) {
+    m_pendingEdits.Append(NewEdit(GBT_UNDO_ACTION_LABEL,
+				  UndoAddress(infoset, p_action->GetNumber())));
+  }
   p_action->SetLabel(static_cast<const char *>(p_label.mb_str()));
   UpdateViews(GBT_DOC_MODIFIED_LABELS);
 }
@@ -696,6 +1157,10 @@ void gbtGameDocument::DoSetActionProb(GameInfoset p_infoset,
 				      unsigned int p_action,
 				      const wxString &p_prob)
 {
+  if (p_infoset->NumMembers() > 0) {
+    m_pendingEdits.Append(NewEdit(GBT_UNDO_ACTION_PROB,
+				  UndoAddress(p_infoset, p_action)));
+  }
   p_infoset->SetActionProb(p_action, static_cast<const char *>(p_prob.mb_str()));
   UpdateViews(GBT_DOC_MODIFIED_PAYOFFS);
 }
@@ -728,7 +1193,9 @@ void gbtGameDocument::DoInsertAction(GameNode p_node)
 
 void gbtGameDocument::DoSetNodeLabel(GameNode p_node, const wxString &p_label)
 {
+  gbtUndoEdit edit = NewEdit(GBT_UNDO_NODE_LABEL, UndoAddress(p_node));
   p_node->SetLabel(static_cast<const char *>(p_label.mb_str()));
+  m_pendingEdits.Append(edit);
   UpdateViews(GBT_DOC_MODIFIED_LABELS);
 }
 
@@ -812,6 +1279,7 @@ void gbtGameDocument::DoNewOutcome(PureStrategyProfile p_profile)
 
 void gbtGameDocument::DoSetOutcome(GameNode p_node, GameOutcome p_outcome)
 {
+  m_pendingEdits.Append(NewEdit(GBT_UNDO_NODE_OUTCOME, UndoAddress(p_node)));
   p_node->SetOutcome(p_outcome);
   UpdateViews(GBT_DOC_MODIFIED_PAYOFFS);
 }
@@ -819,6 +1287,7 @@ void gbtGameDocument::DoSetOutcome(GameNode p_node, GameOutcome p_outcome)
 void gbtGameDocument::DoRemoveOutcome(GameNode p_node)
 {
   if (!p_node || !p_node->GetOutcome()) return;
+  m_pendingEdits.Append(NewEdit(GBT_UNDO_NODE_OUTCOME, UndoAddress(p_node)));
   p_node->SetOutcome(0);
   UpdateViews(GBT_DOC_MODIFIED_PAYOFFS);
 }
@@ -837,8 +1306,11 @@ void gbtGameDocument::DoCopyOutcome(GameNode p_node, GameOutcome p_outcome)
 void gbtGameDocument::DoSetPayoff(GameOutcome p_outcome, int p_player,
 				  const wxString &p_value)
 {
+  gbtUndoEdit edit = NewEdit(GBT_UNDO_PAYOFF,
+			     UndoAddress(p_outcome->GetNumber(), p_player));
   p_outcome->SetPayoff(p_player, 
 		       static_cast<const char *>(p_value.mb_str()));
+  m_pendingEdits.Append(edit);
   UpdateViews(GBT_DOC_MODIFIED_PAYOFFS);
 }
 
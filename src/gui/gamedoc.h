@@ -45,6 +45,7 @@ private:
   Gambit::Array<Gambit::BehavSupport *> m_supports;
   int m_current;
   bool m_noFurther;
+  Gambit::ActionEliminator *m_eliminator;
 
 public:
   gbtBehavDominanceStack(gbtGameDocument *p_doc, bool p_strict);
@@ -106,6 +107,16 @@ public:
     { return (m_current < m_supports.Length() || !m_noFurther); }
 };
 
+//
+// The dominance status of a strategy within a support, as reported
+// by gbtStrategyDominanceStack::GetDominance()
+//
+typedef enum {
+  GBT_DOMINANCE_NONE = 0,
+  GBT_DOMINANCE_WEAK = 1,
+  GBT_DOMINANCE_STRICT = 2
+} gbtDominanceType;
+
 //!
 //! This class manages the "stack" of supports obtained by eliminating
 //! dominated strategies from consideration.
@@ -117,6 +128,11 @@ private:
   Gambit::Array<Gambit::StrategySupport *> m_supports;
   int m_current;
   bool m_noFurther;
+  Gambit::StrategyEliminator *m_eliminator;
+  // Dominance status of each strategy (by id) in the support at
+  // level m_dominanceLevel; zero if not yet computed
+  mutable Gambit::Array<int> m_dominance;
+  mutable int m_dominanceLevel;
 
 public:
   gbtStrategyDominanceStack(gbtGameDocument *p_doc, bool p_strict);
@@ -181,7 +197,14 @@ public:
   //!
   bool CanEliminate(void) const 
     { return (m_current < m_supports.Length() || !m_noFurther); }
-	      
+
+  //!
+  //! Returns whether the strategy is strictly, weakly, or not dominated
+  //! in the current support.  The status of all strategies is computed
+  //! together on first use and kept until the current support changes,
+  //! so this is cheap enough to call for each cell drawn in a table.
+  //!
+  gbtDominanceType GetDominance(const Gambit::GameStrategy &) const;
 };
 
 
@@ -213,6 +236,68 @@ typedef enum {
   GBT_DOC_MODIFIED_VIEWS = 0x08
 } gbtGameModificationType;
 
+//
+// The values of the game which are edited in place, and recorded for
+// undo/redo as their values before and after the edit.  Each is
+// addressed by a list of indices:
+//
+// GBT_UNDO_TITLE, GBT_UNDO_COMMENT: (none)
+// GBT_UNDO_PLAYER_LABEL: player
+// GBT_UNDO_STRATEGY_LABEL: player, strategy
+// GBT_UNDO_INFOSET_LABEL: player (0 for chance), infoset
+// GBT_UNDO_ACTION_LABEL, GBT_UNDO_ACTION_PROB: player, infoset, action
+// GBT_UNDO_NODE_LABEL, GBT_UNDO_NODE_OUTCOME: the action numbers on the
+//   path from the root to the node (the value of GBT_UNDO_NODE_OUTCOME
+//   is the number of the outcome, or zero if none)
+// GBT_UNDO_PAYOFF: outcome, player
+//
+typedef enum {
+  GBT_UNDO_TITLE, GBT_UNDO_COMMENT,
+  GBT_UNDO_PLAYER_LABEL, GBT_UNDO_STRATEGY_LABEL,
+  GBT_UNDO_INFOSET_LABEL, GBT_UNDO_ACTION_LABEL, GBT_UNDO_ACTION_PROB,
+  GBT_UNDO_NODE_LABEL, GBT_UNDO_NODE_OUTCOME,
+  GBT_UNDO_PAYOFF
+} gbtUndoEditType;
+
+class gbtUndoEdit {
+public:
+  gbtUndoEditType m_type;
+  Gambit::Array<int> m_where;
+  std::string m_oldValue, m_newValue;
+
+  gbtUndoEdit(void) : m_type(GBT_UNDO_TITLE) { }
+  gbtUndoEdit(gbtUndoEditType p_type, const Gambit::Array<int> &p_where)
+    : m_type(p_type), m_where(p_where) { }
+};
+
+//
+// A step in the undo history.  Edits of labels, payoffs and the like
+// are undone and redone by setting the old or new values.  Other
+// modifications store a checkpoint, the whole document as written by
+// SaveDocument(), and are undone by reloading the most recent earlier
+// checkpoint and redoing the edits made after it.  Every so often a
+// step of edits gets a checkpoint as well, to bound that replay.
+// Computed profiles are added without a step of their own, and are
+// wiped out by some modifications, so each step also records the
+// profiles before it, and, once it has been undone, after it.
+//
+class gbtUndoStep {
+public:
+  gbtGameModificationType m_modifications;
+  Gambit::List<gbtUndoEdit> m_edits;
+  std::string m_checkpoint;    // empty if the step has none
+  // True if reloading the game keeps the numbers of its outcomes,
+  // which edits use to refer to outcomes, and of its information
+  // sets, which give the order of the entries of profiles
+  bool m_stableNumbering;
+  // The profile lists, as written by SaveDocument()
+  std::string m_profilesBefore, m_profilesAfter;
+#ifdef __WXDEBUG__
+  // The whole document, to check that undo and redo restore it
+  std::string m_documentBefore, m_documentAfter;
+#endif  // __WXDEBUG__
+};
+
 class gbtGameDocument {
 friend class gbtGameView;
 private:
@@ -238,9 +323,29 @@ private:
   Gambit::List<gbtAnalysisOutput *> m_profiles;
   int m_currentProfileList;
 
-  Gambit::List<std::string> m_undoList, m_redoList;
-
-
+  Gambit::List<gbtUndoStep *> m_undoList, m_redoList;
+  Gambit::List<gbtUndoEdit> m_pendingEdits;
+  int m_editsSinceCheckpoint;
+  std::string m_lastProfiles;  // as of the last update of the views
+#ifdef __WXDEBUG__
+  std::string m_lastDocument;  // as of the last update of the views
+#endif  // __WXDEBUG__
+
+  gbtUndoEdit NewEdit(gbtUndoEditType, const Gambit::Array<int> &) const;
+  std::string GetUndoValue(const gbtUndoEdit &) const;
+  void SetUndoValue(const gbtUndoEdit &, const std::string &);
+  void PushUndo(gbtGameModificationType p_modifications);
+  void TrimUndo(void);
+  void LoadCheckpoint(const std::string &);
+  std::string SaveProfiles(void) const;
+  void LoadProfiles(TiXmlNode *p_game);
+  void RestoreProfiles(const std::string &p_profiles);
+#ifdef __WXDEBUG__
+  std::string SaveDebugDocument(void) const;
+  void CheckUndoState(const std::string &p_document, bool p_stable) const;
+#endif  // __WXDEBUG__
+
+  void InvalidateComputed(gbtGameModificationType p_modifications);
   void UpdateViews(gbtGameModificationType p_modifications);
 
 public:
@@ -336,6 +441,8 @@ public:
   void TopStrategyElimLevel(void);
   bool CanStrategyElim(void) const;
   int GetStrategyElimLevel(void) const;
+  gbtDominanceType GetStrategyDominance(const Gambit::GameStrategy &p_strategy) const
+    { return m_stratSupports.GetDominance(p_strategy); }
   //@}
 
   Gambit::GameNode GetSelectNode(void) const { return m_selectNode; }
@@ -381,6 +488,14 @@ public:
 		   const wxString &p_value);
 
   void DoAddOutput(gbtAnalysisOutput &p_list, const wxString &p_output);
+  /// Add a profile computed by an in-process solver; P is one of the
+  /// mixed strategy or behavior profile types on this document's game
+  template <class P> 
+  void DoAddOutput(gbtAnalysisOutput &p_list, const P &p_profile)
+  {
+    p_list.AddProfile(p_profile);
+    UpdateViews(GBT_DOC_MODIFIED_NONE);
+  }
 };
 
 class gbtGameView {
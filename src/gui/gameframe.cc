@@ -32,6 +32,7 @@
 #include <wx/dcps.h>
 #endif  // !defined(__WXMSW__) || wxUSE_POSTSCRIPT
 #include <wx/splitter.h>
+#include <wx/image.h>           // for exporting graphics
 
 #include "libgambit/libgambit.h"
 
@@ -874,17 +875,19 @@ void gbtGameFrame::OnFileExportNfg(wxCommandEvent &)
 
 void gbtGameFrame::OnFileExportGraphic(wxCommandEvent &p_event)
 {
-  wxBitmap bitmap = wxNullBitmap;
-  bool bitmapOK = false;
+  wxImage image;
+  bool imageOK = false;
 
   if (m_efgPanel && m_efgPanel->IsShown()) {
-    bitmapOK = m_efgPanel->GetBitmap(bitmap, 50, 50);
+    imageOK = m_efgPanel->GetImage(image, 50, 50);
   }
   else {
-    bitmapOK = m_nfgPanel->GetBitmap(bitmap, 50, 50);
+    wxBitmap bitmap = wxNullBitmap;
+    imageOK = m_nfgPanel->GetBitmap(bitmap, 50, 50);
+    if (imageOK)  image = bitmap.ConvertToImage();
   }
 
-  if (!bitmapOK) {
+  if (!imageOK) {
     wxMessageBox(_("Game image too large to export to graphics file"),
 		 _("Error"), wxOK, this);
     return;
@@ -919,7 +922,7 @@ void gbtGameFrame::OnFileExportGraphic(wxCommandEvent &p_event)
     default: break;
     }
 
-    if (!bitmap.SaveFile(dialog.GetPath(), code)) {
+    if (!image.SaveFile(dialog.GetPath(), code)) {
       wxMessageBox(_("An error occurred in writing ") + dialog.GetPath() + 
 		   wxT("."),  _("Error"), wxOK, this);
     }
@@ -0,0 +1,76 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2010, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/gui/logitrecords.cc
+// Reading the binary output of gambit-logit -b
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <cstring>   // for memcpy
+
+#include <wx/wxprec.h>
+#ifndef WX_PRECOMP
+#include <wx/wx.h>
+#endif  // WX_PRECOMP
+#include <wx/process.h>
+
+#include "logitrecords.h"
+
+void ReadAvailable(wxProcess *p_process, std::string &p_buffer,
+		   int p_maxBytes)
+{
+  wxInputStream &stream = *p_process->GetInputStream();
+  char block[4096];
+  int total = 0;
+
+  while ((p_maxBytes == 0 || total < p_maxBytes) &&
+	 p_process->IsInputAvailable()) {
+    size_t size = sizeof(block);
+    if (p_maxBytes > 0 && (size_t) (p_maxBytes - total) < size) {
+      size = p_maxBytes - total;
+    }
+    // Read() returns early, rather than blocking, once it has read
+    // something and no more is available from the pipe
+    stream.Read(block, size);
+    size_t count = stream.LastRead();
+    if (count == 0)  break;
+    p_buffer.append(block, count);
+    total += count;
+  }
+}
+
+void ReadRecords(std::string &p_buffer,
+		 Gambit::List<Gambit::Array<double> > &p_records)
+{
+  std::string::size_type pos = 0;
+  while (p_buffer.length() - pos >= sizeof(int)) {
+    int count;
+    memcpy(&count, p_buffer.data() + pos, sizeof(int));
+    if (count < 0)  count = -count;
+    std::string::size_type size = sizeof(int) + count * sizeof(double);
+    if (p_buffer.length() - pos < size)  break;
+
+    if (count > 0) {
+      Gambit::Array<double> values(count);
+      memcpy(&values[1], p_buffer.data() + pos + sizeof(int),
+	     count * sizeof(double));
+      p_records.Append(values);
+    }
+    pos += size;
+  }
+  p_buffer.erase(0, pos);
+}
@@ -0,0 +1,46 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2010, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/gui/logitrecords.h
+// Reading the binary output of gambit-logit -b
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef LOGITRECORDS_H
+#define LOGITRECORDS_H
+
+#include <string>
+#include <wx/process.h>
+#include "libgambit/libgambit.h"
+
+//
+// Appends up to p_maxBytes of the output available from the process
+// (or all of it, if p_maxBytes is zero) to the buffer.
+//
+void ReadAvailable(wxProcess *p_process, std::string &p_buffer,
+		   int p_maxBytes);
+
+//
+// Extracts the complete records at the start of the buffer of output
+// from gambit-logit -b, removing them from the buffer.  Each record is
+// the number of doubles which follow, negated for a terminal point,
+// and zero to mark the end of a branch.
+//
+void ReadRecords(std::string &p_buffer,
+		 Gambit::List<Gambit::Array<double> > &p_records);
+
+#endif  // LOGITRECORDS_H
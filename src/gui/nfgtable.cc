@@ -26,6 +26,8 @@
 #endif  // WX_PRECOMP
 #include <wx/dnd.h>      // for drag-and-drop support
 #include <wx/print.h>    // for printing support
+#include <algorithm>
+#include <map>
 #include "dcsvg.h"         // for SVG output
 
 #include "wx/sheet/sheet.h"
@@ -166,6 +168,14 @@ private:
   void DrawCell(wxDC &p_dc, const wxSheetCoords &p_coords);
   //@}  
 
+  /// @name Overriding wxSheet members to compute spanned cells
+  //@{
+  /// Spans are computed from the strategy counts, rather than stored
+  bool HasSpannedCells(void) const { return true; }
+  /// Each strategy label spans the rows of the players after it
+  wxSheetBlock GetCellBlock(const wxSheetCoords &p_coords) const;
+  //@}
+
   void OnCellRightClick(wxSheetEvent &);
 
 public:
@@ -192,6 +202,10 @@ gbtRowPlayerWidget::gbtRowPlayerWidget(gbtTableWidget *p_parent,
   : gbtTableWidgetBase(p_parent, -1), m_doc(p_doc), m_table(p_parent)
 {
   CreateGrid(m_table->NumRowContingencies(), m_table->NumRowPlayers());
+  // With no stored spans, wxSheet asks GetCellBlock() about the visible
+  // cells only; storing a span per strategy label is quadratic in the
+  // number of rows.
+  GetTable()->SetSpannedBlocks(0, true);
   SetRowLabelWidth(1);
   SetColLabelHeight(1);
   SetScrollBarMode(SB_NEVER);
@@ -277,9 +291,10 @@ void gbtRowPlayerWidget::DrawCell(wxDC &p_dc, const wxSheetCoords &p_coords)
   int strat = m_table->RowToStrategy(p_coords.GetCol() + 1, p_coords.GetRow());
   Gambit::GameStrategy strategy = support.GetStrategy(player, strat);
 
-  if (support.IsDominated(strategy, false)) {
+  gbtDominanceType dominance = m_doc->GetStrategyDominance(strategy);
+  if (dominance != GBT_DOMINANCE_NONE) {
     wxRect rect = CellToRect(p_coords);
-    if (support.IsDominated(strategy, true)) {
+    if (dominance == GBT_DOMINANCE_STRICT) {
       p_dc.SetPen(wxPen(m_doc->GetStyle().GetPlayerColor(player),
 			2, wxSOLID));
     }
@@ -304,20 +319,17 @@ void gbtRowPlayerWidget::OnUpdate(void)
   if (newCols < GetNumberCols())  DeleteCols(0, GetNumberCols() - newCols);
   if (newCols == 0)  InsertCols(0, 1);
 
-  for (int col = 0; col < GetNumberCols(); col++) {
-    for (int row = 0; row < GetNumberRows(); 
-	 SetCellSpan(wxSheetCoords(row++, col), wxSheetCoords(1, 1)));
-
-    int span = m_table->NumRowsSpanned(col+1);
+  Refresh();
+}
 
-    int row = 0;
-    while (row < GetNumberRows()) {
-      SetCellSpan(wxSheetCoords(row, col), wxSheetCoords(span, 1));
-      row += span;
-    }
-  }
+wxSheetBlock 
+gbtRowPlayerWidget::GetCellBlock(const wxSheetCoords &p_coords) const
+{
+  if (!ContainsGridCell(p_coords))  return wxSheetBlock(p_coords, 1, 1);
 
-  Refresh();
+  int span = m_table->NumRowsSpanned(p_coords.GetCol() + 1);
+  return wxSheetBlock(p_coords.GetRow() - p_coords.GetRow() % span,
+		      p_coords.GetCol(), span, 1);
 }
 
 bool gbtRowPlayerWidget::DropText(wxCoord p_x, wxCoord p_y,
@@ -375,6 +387,14 @@ private:
   void DrawCell(wxDC &p_dc, const wxSheetCoords &p_coords);
   //@}  
 
+  /// @name Overriding wxSheet members to compute spanned cells
+  //@{
+  /// Spans are computed from the strategy counts, rather than stored
+  bool HasSpannedCells(void) const { return true; }
+  /// Each strategy label spans the columns of the players after it
+  wxSheetBlock GetCellBlock(const wxSheetCoords &p_coords) const;
+  //@}
+
   void OnCellRightClick(wxSheetEvent &);
 
 public:
@@ -401,6 +421,8 @@ gbtColPlayerWidget::gbtColPlayerWidget(gbtTableWidget *p_parent,
   : gbtTableWidgetBase(p_parent, -1), m_doc(p_doc), m_table(p_parent)
 {
   CreateGrid(m_table->NumColPlayers(), 0);
+  // See the comment in the gbtRowPlayerWidget constructor
+  GetTable()->SetSpannedBlocks(0, true);
   SetRowLabelWidth(1);
   SetColLabelHeight(1);
   SetScrollBarMode(SB_NEVER);
@@ -441,20 +463,17 @@ void gbtColPlayerWidget::OnUpdate(void)
   if (newRows < GetNumberRows())  DeleteRows(0, GetNumberRows() - newRows);
   if (newRows == 0)  InsertRows(0, 1);
 
-  for (int row = 0; row < GetNumberRows(); row++) {
-    for (int col = 0; col < GetNumberCols(); 
-	 SetCellSpan(wxSheetCoords(row, col++), wxSheetCoords(1, 1)));
-
-    int span = m_table->NumColsSpanned(row+1) * m_doc->NumPlayers();
+  Refresh();
+}
 
-    int col = 0;
-    while (col < GetNumberCols()) {
-      SetCellSpan(wxSheetCoords(row, col), wxSheetCoords(1, span));
-      col += span;
-    }      
-  }
+wxSheetBlock 
+gbtColPlayerWidget::GetCellBlock(const wxSheetCoords &p_coords) const
+{
+  if (!ContainsGridCell(p_coords))  return wxSheetBlock(p_coords, 1, 1);
 
-  Refresh();
+  int span = m_table->NumColsSpanned(p_coords.GetRow() + 1) * m_doc->NumPlayers();
+  return wxSheetBlock(p_coords.GetRow(), 
+		      p_coords.GetCol() - p_coords.GetCol() % span, 1, span);
 }
 
 wxString gbtColPlayerWidget::GetCellValue(const wxSheetCoords &p_coords)
@@ -514,9 +533,10 @@ void gbtColPlayerWidget::DrawCell(wxDC &p_dc, const wxSheetCoords &p_coords)
   int strat = m_table->ColToStrategy(p_coords.GetRow() + 1, p_coords.GetCol());
   Gambit::GameStrategy strategy = support.GetStrategy(player, strat);
 
-  if (support.IsDominated(strategy, false)) {
+  gbtDominanceType dominance = m_doc->GetStrategyDominance(strategy);
+  if (dominance != GBT_DOMINANCE_NONE) {
     wxRect rect = CellToRect(p_coords);
-    if (support.IsDominated(strategy, true)) {
+    if (dominance == GBT_DOMINANCE_STRICT) {
       p_dc.SetPen(wxPen(m_doc->GetStyle().GetPlayerColor(player),
 			2, wxSOLID));
     }
@@ -595,6 +615,21 @@ private:
   /// Maps columns to corresponding player
   int ColToPlayer(int p_col) const;
 
+  /// @name Caching payoff text
+  //@{
+  /// Payoff text is computed for a page of c_pageRows rows by
+  /// c_pageCols contingencies at a time, the first time any cell on
+  /// the page is drawn, so each profile is built once per page rather
+  /// than once per cell on every paint.  At most c_maxPages are kept.
+  static const int c_pageRows = 64, c_pageCols = 16, c_maxPages = 64;
+  std::map<std::pair<int, int>, Gambit::Array<std::string> > m_pages;
+
+  /// Returns the payoff text for the cell
+  const std::string &GetPayoffText(const wxSheetCoords &);
+  /// Computes the payoff text for a page
+  void LoadPage(int p_pageRow, int p_pageCol, Gambit::Array<std::string> &);
+  //@}
+
 public:
   gbtPayoffsWidget(gbtTableWidget *p_parent, gbtGameDocument *p_doc);
 
@@ -636,6 +671,8 @@ int gbtPayoffsWidget::ColToPlayer(int p_col) const
 
 void gbtPayoffsWidget::OnUpdate(void)
 {
+  m_pages.clear();
+
   int newCols = m_table->NumColContingencies() * m_doc->NumPlayers();
   if (newCols > GetNumberCols())  InsertCols(0, newCols - GetNumberCols());
   if (newCols < GetNumberCols())  DeleteCols(0, GetNumberCols() - newCols);
@@ -651,9 +688,52 @@ wxString gbtPayoffsWidget::GetCellValue(const wxSheetCoords &p_coords)
 {
   if (IsLabelCell(p_coords))  return wxT("");
 
-  Gambit::PureStrategyProfile profile = m_table->CellToProfile(p_coords);
-  int player = ColToPlayer(p_coords.GetCol());
-  return wxString(profile.GetPayoff<std::string>(player).c_str(), *wxConvCurrent);
+  return wxString(GetPayoffText(p_coords).c_str(), *wxConvCurrent);
+}
+
+const std::string &
+gbtPayoffsWidget::GetPayoffText(const wxSheetCoords &p_coords)
+{
+  int numPlayers = m_doc->NumPlayers();
+  int row = p_coords.GetRow(), cont = p_coords.GetCol() / numPlayers;
+  std::pair<int, int> key(row / c_pageRows, cont / c_pageCols);
+
+  std::map<std::pair<int, int>, Gambit::Array<std::string> >::iterator page;
+  page = m_pages.find(key);
+  if (page == m_pages.end()) {
+    if ((int) m_pages.size() >= c_maxPages)  m_pages.clear();
+    page = m_pages.insert(std::make_pair(key, 
+					 Gambit::Array<std::string>())).first;
+    LoadPage(key.first, key.second, page->second);
+  }
+
+  return page->second[((row % c_pageRows) * c_pageCols + cont % c_pageCols) 
+		      * numPlayers + p_coords.GetCol() % numPlayers + 1];
+}
+
+void gbtPayoffsWidget::LoadPage(int p_pageRow, int p_pageCol,
+				Gambit::Array<std::string> &p_page)
+{
+  int numPlayers = m_doc->NumPlayers();
+  p_page = Gambit::Array<std::string>(c_pageRows * c_pageCols * numPlayers);
+
+  int firstRow = p_pageRow * c_pageRows;
+  int lastRow = std::min(firstRow + c_pageRows, GetNumberRows());
+  int firstCont = p_pageCol * c_pageCols;
+  int lastCont = std::min(firstCont + c_pageCols, 
+			  GetNumberCols() / numPlayers);
+
+  for (int row = firstRow; row < lastRow; row++) {
+    for (int cont = firstCont; cont < lastCont; cont++) {
+      Gambit::PureStrategyProfile profile = 
+	m_table->CellToProfile(wxSheetCoords(row, cont * numPlayers));
+      int index = ((row - firstRow) * c_pageCols + cont - firstCont) * numPlayers;
+      for (int i = 0; i < numPlayers; i++) {
+	int player = ColToPlayer(cont * numPlayers + i);
+	p_page[index + i + 1] = profile.GetPayoff<std::string>(player);
+      }
+    }
+  }
 }
 
 void gbtPayoffsWidget::SetCellValue(const wxSheetCoords &p_coords,
@@ -732,13 +812,12 @@ void gbtPayoffsWidget::DrawCell(wxDC &p_dc, const wxSheetCoords &p_coords)
 
   if (!m_table->ShowDominance() || IsLabelCell(p_coords)) return;
 
-  Gambit::PureStrategyProfile profile = m_table->CellToProfile(p_coords);
   int player = ColToPlayer(p_coords.GetCol());
-  const Gambit::StrategySupport &support = m_doc->GetNfgSupport();
-
-  if (support.IsDominated(profile.GetStrategy(player), false)) {
+  gbtDominanceType dominance = 
+    m_doc->GetStrategyDominance(m_table->CellToStrategy(p_coords, player));
+  if (dominance != GBT_DOMINANCE_NONE) {
     wxRect rect = CellToRect(p_coords);
-    if (support.IsDominated(profile.GetStrategy(player), true)) {
+    if (dominance == GBT_DOMINANCE_STRICT) {
       p_dc.SetPen(wxPen(m_doc->GetStyle().GetPlayerColor(player),
 			2, wxSOLID));
     }
@@ -1152,6 +1231,28 @@ gbtTableWidget::CellToProfile(const wxSheetCoords &p_coords) const
   return profile;
 }
 
+Gambit::GameStrategy
+gbtTableWidget::CellToStrategy(const wxSheetCoords &p_coords, int p_player) const
+{
+  const Gambit::StrategySupport &support = m_doc->GetNfgSupport();
+
+  for (int i = 1; i <= NumRowPlayers(); i++) {
+    if (GetRowPlayer(i) == p_player) {
+      return support.GetStrategy(p_player, 
+				 RowToStrategy(i, p_coords.GetRow()));
+    }
+  }
+
+  for (int i = 1; i <= NumColPlayers(); i++) {
+    if (GetColPlayer(i) == p_player) {
+      return support.GetStrategy(p_player, 
+				 ColToStrategy(i, p_coords.GetCol()));
+    }
+  }
+
+  return 0;
+}
+
 class gbtNfgPrintout : public wxPrintout {
 private:
   gbtTableWidget *m_table;
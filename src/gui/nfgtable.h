@@ -127,6 +127,10 @@ public:
 
   /// Returns the strategy profile corresponding to a cell
   Gambit::PureStrategyProfile CellToProfile(const wxSheetCoords &) const;
+
+  /// Returns the strategy of a player in the profile of a cell, without
+  /// building the whole profile
+  Gambit::GameStrategy CellToStrategy(const wxSheetCoords &, int pl) const;
   //@}
 
   /// @name Exporting/printing graphics
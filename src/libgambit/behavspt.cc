@@ -586,6 +586,286 @@ BehavSupport BehavSupport::Undominated(bool strong, bool conditional,
   return T;
 }
 
+//========================================================================
+//                       class PackedBehavSupport
+//========================================================================
+
+PackedBehavSupport::PackedBehavSupport(const Game &p_efg)
+  : m_efg(p_efg),
+    m_bits((p_efg->BehavProfileLength() + c_wordBits - 1) / c_wordBits),
+    m_playerOffsets(p_efg->NumPlayers())
+{
+  int offset = 0;
+  for (int pl = 1; pl <= p_efg->NumPlayers(); pl++) {
+    GamePlayer player = p_efg->GetPlayer(pl);
+    m_playerOffsets[pl] = m_infosetOffsets.Length();
+    for (int iset = 1; iset <= player->NumInfosets(); iset++) {
+      m_infosetOffsets.Append(offset);
+      offset += player->GetInfoset(iset)->NumActions();
+    }
+  }
+
+  for (int i = 1; i <= m_bits.Length(); m_bits[i++] = 0UL);
+  for (int i = 1; i <= offset; SetBit(i++));
+}
+
+PackedBehavSupport::PackedBehavSupport(const BehavSupport &p_support)
+{
+  *this = PackedBehavSupport(p_support.GetGame());
+  for (int pl = 1; pl <= m_efg->NumPlayers(); pl++) {
+    GamePlayer player = m_efg->GetPlayer(pl);
+    for (int iset = 1; iset <= player->NumInfosets(); iset++) {
+      GameInfoset infoset = player->GetInfoset(iset);
+      for (int act = 1; act <= infoset->NumActions(); act++) {
+	if (!p_support.Contains(infoset->GetAction(act))) {
+	  ClearBit(ActionIndex(pl, iset, act));
+	}
+      }
+    }
+  }
+}
+
+bool PackedBehavSupport::operator<(const PackedBehavSupport &p_support) const
+{
+  for (int i = 1; i <= m_efg->BehavProfileLength(); i++) {
+    if (GetBit(i) != p_support.GetBit(i)) {
+      return GetBit(i);
+    }
+  }
+  return false;
+}
+
+int PackedBehavSupport::ActionIndex(const GameAction &p_action) const
+{
+  GameInfoset infoset = p_action->GetInfoset();
+  return ActionIndex(infoset->GetPlayer()->GetNumber(), infoset->GetNumber(),
+		     p_action->GetNumber());
+}
+
+int PackedBehavSupport::NumActions(int pl, int iset) const
+{
+  int count = 0;
+  int numActions = m_efg->GetPlayer(pl)->GetInfoset(iset)->NumActions();
+  for (int act = 1; act <= numActions; act++) {
+    if (GetBit(ActionIndex(pl, iset, act)))  count++;
+  }
+  return count;
+}
+
+unsigned long PackedBehavSupport::Hash(void) const
+{
+  unsigned long hash = 2166136261UL;
+  for (int i = 1; i <= m_bits.Length(); i++) {
+    hash = (hash ^ m_bits[i]) * 16777619UL;
+  }
+  return hash;
+}
+
+//
+// The actions are removed in the order in which they appear in the
+// game, so that the reachability information of the support returned
+// is the same as that of one built up by removing actions from the
+// full support in that order.
+//
+BehavSupport PackedBehavSupport::ToSupport(void) const
+{
+  BehavSupport support(m_efg);
+  for (int pl = 1; pl <= m_efg->NumPlayers(); pl++) {
+    GamePlayer player = m_efg->GetPlayer(pl);
+    for (int iset = 1; iset <= player->NumInfosets(); iset++) {
+      GameInfoset infoset = player->GetInfoset(iset);
+      for (int act = 1; act <= infoset->NumActions(); act++) {
+	if (!GetBit(ActionIndex(pl, iset, act))) {
+	  support.RemoveAction(infoset->GetAction(act));
+	}
+      }
+    }
+  }
+  return support;
+}
+
+void PackedBehavSupport::MarkReachable(const GameNode &p_node,
+				       Array<bool> &p_reached) const
+{
+  if (p_node->IsTerminal())  return;
+
+  GameInfoset infoset = p_node->GetInfoset();
+  int pl = infoset->GetPlayer()->GetNumber();
+  if (pl > 0) {
+    p_reached[InfosetIndex(pl, infoset->GetNumber())] = true;
+  }
+  for (int act = 1; act <= p_node->NumChildren(); act++) {
+    if (pl == 0 || GetBit(ActionIndex(pl, infoset->GetNumber(), act))) {
+      MarkReachable(p_node->GetChild(act), p_reached);
+    }
+  }
+}
+
+bool PackedBehavSupport::IsConsistent(bool p_noOthers) const
+{
+  Array<bool> reached(m_infosetOffsets.Length());
+  for (int i = 1; i <= reached.Length(); reached[i++] = false);
+  MarkReachable(m_efg->GetRoot(), reached);
+
+  for (int pl = 1; pl <= m_efg->NumPlayers(); pl++) {
+    for (int iset = 1; iset <= m_efg->GetPlayer(pl)->NumInfosets(); iset++) {
+      int numActions = NumActions(pl, iset);
+      if (reached[InfosetIndex(pl, iset)] && numActions == 0) {
+	return false;
+      }
+      if (p_noOthers && !reached[InfosetIndex(pl, iset)] && numActions > 0) {
+	return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool PackedBehavSupport::RemoveAction(const GameAction &p_action)
+{
+  int index = ActionIndex(p_action);
+  if (!GetBit(index))  return false;
+  ClearBit(index);
+  return true;
+}
+
+//
+// Treating the membership bits of the actions in p_support as the
+// digits of a binary number, with the first action most significant,
+// the lexicographic successor is obtained by decrementing that number.
+//
+bool PackedBehavSupport::Next(const PackedBehavSupport &p_support)
+{
+  int numActions = m_efg->BehavProfileLength();
+  int i = numActions;
+  for (; i >= 1; i--) {
+    if (p_support.GetBit(i) && GetBit(i))  break;
+  }
+  if (i == 0)  return false;
+
+  ClearBit(i);
+  for (int later = i + 1; later <= numActions; later++) {
+    if (p_support.GetBit(later))  SetBit(later);
+  }
+  return true;
+}
+
+//========================================================================
+//                        class ActionEliminator
+//========================================================================
+
+//
+// Marks the information set at a node as relevant, and queues it for
+// having its own dependencies followed, if it has not been seen already.
+// Chance information sets (player number zero) are followed as well,
+// although they are never the subject of elimination.
+//
+static void MarkRelevant(const GameNode &p_node,
+			 Array<Array<bool> > &p_marked,
+			 List<GameInfoset> &p_queue)
+{
+  GameInfoset infoset = p_node->GetInfoset();
+  if (!infoset)  return;
+  int pl = infoset->GetPlayer()->GetNumber();
+  if (!p_marked[pl][infoset->GetNumber()]) {
+    p_marked[pl][infoset->GetNumber()] = true;
+    p_queue.Append(infoset);
+  }
+}
+
+static void MarkRelevantSubtree(const GameNode &p_node,
+				Array<Array<bool> > &p_marked,
+				List<GameInfoset> &p_queue)
+{
+  MarkRelevant(p_node, p_marked, p_queue);
+  for (int i = 1; i <= p_node->NumChildren(); i++) {
+    MarkRelevantSubtree(p_node->GetChild(i), p_marked, p_queue);
+  }
+}
+
+ActionEliminator::ActionEliminator(const BehavSupport &p_support,
+				   bool p_strict, bool p_conditional)
+  : m_support(p_support), m_strict(p_strict), m_conditional(p_conditional),
+    m_rounds(0), m_dirty(p_support.GetGame()->NumPlayers()),
+    m_dependents(p_support.GetGame()->NumPlayers())
+{
+  Game efg = m_support.GetGame();
+
+  for (int pl = 1; pl <= efg->NumPlayers(); pl++) {
+    int numInfosets = efg->GetPlayer(pl)->NumInfosets();
+    m_dirty[pl] = Array<bool>(numInfosets);
+    m_dependents[pl] = Array<List<GameInfoset> >(numInfosets);
+    for (int iset = 1; iset <= numInfosets; m_dirty[pl][iset++] = true);
+  }
+
+  for (int pl = 1; pl <= efg->NumPlayers(); pl++) {
+    for (int iset = 1; iset <= efg->GetPlayer(pl)->NumInfosets(); iset++) {
+      GameInfoset infoset = efg->GetPlayer(pl)->GetInfoset(iset);
+
+      Array<Array<bool> > marked(0, efg->NumPlayers());
+      for (int i = 0; i <= efg->NumPlayers(); i++) {
+	GamePlayer player = (i == 0) ? efg->GetChance() : efg->GetPlayer(i);
+	marked[i] = Array<bool>(player->NumInfosets());
+	for (int j = 1; j <= marked[i].Length(); marked[i][j++] = false);
+      }
+
+      List<GameInfoset> queue;
+      marked[pl][iset] = true;
+      queue.Append(infoset);
+      for (int q = 1; q <= queue.Length(); q++) {
+	GameInfoset current = queue[q];
+	for (int m = 1; m <= current->NumMembers(); m++) {
+	  GameNode member = current->GetMember(m);
+	  for (GameNode node = member->GetParent(); node; 
+	       node = node->GetParent()) {
+	    MarkRelevant(node, marked, queue);
+	  }
+	  MarkRelevantSubtree(member, marked, queue);
+	}
+      }
+
+      for (int i = 1; i <= efg->NumPlayers(); i++) {
+	for (int j = 1; j <= marked[i].Length(); j++) {
+	  if (marked[i][j])  m_dependents[i][j].Append(infoset);
+	}
+      }
+    }
+  }
+}
+
+bool ActionEliminator::NextRound(void)
+{
+  Game efg = m_support.GetGame();
+  BehavSupport newSupport(m_support);
+  List<GameInfoset> changed;
+
+  for (int pl = 1; pl <= efg->NumPlayers(); pl++) {
+    for (int iset = 1; iset <= efg->GetPlayer(pl)->NumInfosets(); iset++) {
+      if (m_dirty[pl][iset]) {
+	m_dirty[pl][iset] = false;
+	if (ElimDominatedInInfoset(m_support, newSupport, pl, iset,
+				   m_strict, m_conditional)) {
+	  changed.Append(efg->GetPlayer(pl)->GetInfoset(iset));
+	}
+      }
+    }
+  }
+
+  for (int i = 1; i <= changed.Length(); i++) {
+    List<GameInfoset> &dependents = 
+      m_dependents[changed[i]->GetPlayer()->GetNumber()][changed[i]->GetNumber()];
+    for (int j = 1; j <= dependents.Length(); j++) {
+      m_dirty[dependents[j]->GetPlayer()->GetNumber()][dependents[j]->GetNumber()] = true;
+    }
+  }
+
+  if (changed.Length() > 0) {
+    m_support = newSupport;
+    m_rounds++;
+    return true;
+  }
+  return false;
+}
 
 // Utilities 
 bool BehavSupport::HasActiveMembers(int pl, int iset) const
@@ -161,6 +161,154 @@ public:
   //@}
 };
 
+/// \brief A support on an extensive game, stored as a set of bits
+///
+/// This class represents a subset of the actions in an extensive game,
+/// keeping one bit per action, in the order of players, information
+/// sets, and actions.  Membership tests are constant-time, and copying
+/// a support copies only a few words, so this representation is suited
+/// to algorithms which generate large numbers of supports.  Unlike
+/// BehavSupport, information sets may have no actions in the support,
+/// and reachability is computed only when asked for.
+///
+/// Supports are ordered lexicographically by the membership of the
+/// actions, with a support containing an action preceding one which
+/// does not.  Thus, the full support comes first.
+class PackedBehavSupport {
+private:
+  Game m_efg;
+  Array<unsigned long> m_bits;
+  /// The number of information sets of players before each player
+  Array<int> m_playerOffsets;
+  /// The number of actions at information sets before each information set
+  Array<int> m_infosetOffsets;
+
+  static const int c_wordBits = 8 * sizeof(unsigned long);
+
+  bool GetBit(int p_index) const
+    { return (m_bits[(p_index - 1) / c_wordBits + 1] >> 
+	      ((p_index - 1) % c_wordBits)) & 1UL; }
+  void SetBit(int p_index)
+    { m_bits[(p_index - 1) / c_wordBits + 1] |= 1UL << ((p_index - 1) % c_wordBits); }
+  void ClearBit(int p_index)
+    { m_bits[(p_index - 1) / c_wordBits + 1] &= ~(1UL << ((p_index - 1) % c_wordBits)); }
+
+  int InfosetIndex(int pl, int iset) const 
+    { return m_playerOffsets[pl] + iset; }
+  int ActionIndex(int pl, int iset, int act) const
+    { return m_infosetOffsets[InfosetIndex(pl, iset)] + act; }
+  int ActionIndex(const GameAction &) const;
+
+  void MarkReachable(const GameNode &, Array<bool> &) const;
+  bool IsConsistent(bool p_noOthers) const;
+
+public:
+  /// @name Lifecycle
+  //@{
+  /// Constructor.  By default, a support contains all actions.
+  PackedBehavSupport(const Game &);
+  /// Construct from a support
+  PackedBehavSupport(const BehavSupport &);
+  //@}
+
+  /// @name Operator overloading
+  //@{
+  /// Test for the equality of two supports (same actions at all infosets)
+  bool operator==(const PackedBehavSupport &p_support) const
+    { return (m_bits == p_support.m_bits); }
+  /// Test for the inequality of two supports
+  bool operator!=(const PackedBehavSupport &p_support) const
+    { return (m_bits != p_support.m_bits); }
+  /// Lexicographic comparison of two supports
+  bool operator<(const PackedBehavSupport &) const;
+  //@}
+
+  /// @name General information
+  //@{
+  /// Returns the game on which the support is defined.
+  Game GetGame(void) const { return m_efg; }
+  /// Returns the number of actions in the support at the information set
+  int NumActions(int pl, int iset) const;
+  /// Returns whether the action is in the support.
+  bool Contains(const GameAction &p_action) const
+    { return GetBit(ActionIndex(p_action)); }
+  bool Contains(int pl, int iset, int act) const
+    { return GetBit(ActionIndex(pl, iset, act)); }
+  /// Returns a hash value for the support
+  unsigned long Hash(void) const;
+  /// Returns the support as a BehavSupport
+  BehavSupport ToSupport(void) const;
+
+  /// Do all reachable information sets have actions in the support?
+  bool HasActiveActionsAtActiveInfosets(void) const
+    { return IsConsistent(false); }
+  /// Do only reachable information sets have actions in the support?
+  bool HasActiveActionsAtActiveInfosetsAndNoOthers(void) const
+    { return IsConsistent(true); }
+  //@}
+
+  /// @name Editing the support
+  //@{
+  /// Adds the action to the support; no effect if action is present already
+  void AddAction(const GameAction &p_action)
+    { SetBit(ActionIndex(p_action)); }
+  /// Removes the action from the support; returns true if it was present
+  bool RemoveAction(const GameAction &);
+  /// \brief Advance to the lexicographic successor
+  ///
+  /// Changes the support to the next subsupport of p_support in
+  /// lexicographic order.  This support must itself be a subsupport
+  /// of p_support.  Returns false, leaving the support unchanged, 
+  /// if this is the last one.
+  bool Next(const PackedBehavSupport &p_support);
+  //@}
+};
+
+/// \brief Iterated elimination of dominated actions
+///
+/// This class carries out iterated elimination of dominated actions,
+/// one round at a time.  Each round has the same effect as
+/// BehavSupport::Undominated() applied to all players.  Whether one
+/// action dominates another depends only on the actions available at
+/// information sets whose members precede or succeed members of the
+/// information set (and, transitively, on those which determine whether
+/// those information sets are reached).  These dependencies are computed
+/// once; after each round, only information sets which depend on one
+/// at which an action was eliminated are examined again.
+class ActionEliminator {
+private:
+  BehavSupport m_support;
+  bool m_strict, m_conditional;
+  int m_rounds;
+  /// Information sets which need to be examined in the next round
+  Array<Array<bool> > m_dirty;
+  /// For each information set, those whose dominance relations depend on it
+  Array<Array<List<GameInfoset> > > m_dependents;
+
+public:
+  /// @name Lifecycle
+  //@{
+  /// Begin iterated elimination from the given support
+  ActionEliminator(const BehavSupport &, bool p_strict, bool p_conditional);
+  //@}
+
+  /// @name Elimination
+  //@{
+  /// Carry out one round; returns true if any action was eliminated
+  bool NextRound(void);
+  /// Carry out rounds until no further actions are eliminated
+  void Run(void) { while (NextRound()); }
+  //@}
+
+  /// @name Data access
+  //@{
+  /// Returns the support after the rounds of elimination carried out so far
+  const BehavSupport &GetSupport(void) const { return m_support; }
+  /// Returns the number of rounds of elimination carried out so far
+  int NumRounds(void) const { return m_rounds; }
+  //@}
+};
+
 } // end namespace Gambit
 
 #endif  // LIBGAMBIT_BEHAVSPT_H
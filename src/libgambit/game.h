@@ -372,6 +372,7 @@ class GameStrategyRep : public GameObject  {
   friend class GameRep;
   friend class GamePlayerRep;
   friend class PureStrategyProfile;
+  friend class StrategySupport;
   template <class T> friend class MixedStrategyProfile;
   template <class T> friend class MixedBehavProfile;
 
@@ -624,6 +625,7 @@ class GameRep : public GameObject {
   friend class GamePlayerRep;
   friend class GameNodeRep;
   friend class PureStrategyProfile;
+  friend class StrategySupport;
   template <class T> friend class MixedBehavProfile;
   template <class T> friend class MixedStrategyProfile;
 
@@ -97,7 +97,11 @@ long lg(unsigned long x)
 #define MALLOC_MIN_OVERHEAD 4
 #endif
 
-static IntegerRep _ZeroRep = {1, 0, 1, {0}};
+// Shared representations of 0, 1 and -1.  These are never written to,
+// so they can be shared by Integers in different threads: the allocation
+// routines below return _ZeroRep or a new rep in place of a static one,
+// and Isetsgn() copies a static rep before changing its sign.
+static IntegerRep _ZeroRep = {0, 0, 1, {0}};
 static IntegerRep _OneRep = {1, 0, 1, {1}};
 static IntegerRep _MinusOneRep = {1, 0, 0, {1}};
 
@@ -147,6 +151,7 @@ inline static int calc_len(int len1, int len2, int pad)
 
 static void Icheck(IntegerRep* rep)
 {
+  if (STATIC_IntegerRep(rep)) return;
   int l = rep->len;
   const unsigned short* p = &(rep->s[l]);
   while (l > 0 && *--p == 0) --l;
@@ -198,8 +203,10 @@ static IntegerRep* Inew(int newlen)
 IntegerRep* Ialloc(IntegerRep* old, const unsigned short* src, int srclen, int newsgn,
               int newlen)
 {
+  if (newlen == 0 && old != 0 && STATIC_IntegerRep(old))
+    return &_ZeroRep;
   IntegerRep* rep;
-  if (old == 0 || newlen > old->sz)
+  if (old == 0 || STATIC_IntegerRep(old) || newlen > old->sz)
     rep = Inew(newlen);
   else
     rep = old;
@@ -219,7 +226,7 @@ IntegerRep* Ialloc(IntegerRep* old, const unsigned short* src, int srclen, int n
 IntegerRep* Icalloc(IntegerRep* old, int newlen)
 {
   IntegerRep* rep;
-  if (old == 0 || newlen > old->sz)
+  if (old == 0 || STATIC_IntegerRep(old) || newlen > old->sz)
   {
     if (old != 0 && !STATIC_IntegerRep(old)) delete old;
     rep = Inew(newlen);
@@ -249,7 +256,7 @@ IntegerRep* Iresize(IntegerRep* old, int newlen)
   else 
   {
     oldlen = old->len;
-    if (newlen > old->sz)
+    if (STATIC_IntegerRep(old) || newlen > old->sz)
     {
       rep = Inew(newlen);
       scpy(old->s, rep->s, oldlen);
@@ -275,7 +282,7 @@ IntegerRep* Icopy(IntegerRep* old, const IntegerRep* src)
   IntegerRep* rep;
   if (src == 0)
   {
-    if (old == 0)
+    if (old == 0 || STATIC_IntegerRep(old))
       rep = Inew(0);
     else
     {
@@ -288,7 +295,9 @@ IntegerRep* Icopy(IntegerRep* old, const IntegerRep* src)
   else 
   {
     int newlen = src->len;
-    if (old == 0 || newlen > old->sz)
+    if (newlen == 0 && old != 0 && STATIC_IntegerRep(old))
+      return &_ZeroRep;
+    if (old == 0 || STATIC_IntegerRep(old) || newlen > old->sz)
     {
       if (old != 0 && !STATIC_IntegerRep(old)) delete old;
       rep = Inew(newlen);
@@ -311,7 +320,8 @@ IntegerRep* Icopy_long(IntegerRep* old, long x)
 {
   int newsgn = (x >= 0);
   IntegerRep* rep = Icopy_ulong(old, newsgn ? x : -x);
-  rep->sgn = newsgn;
+  if (!STATIC_IntegerRep(rep))
+    rep->sgn = newsgn;
   return rep;
 }
 
@@ -326,8 +336,10 @@ IntegerRep* Icopy_ulong(IntegerRep* old, unsigned long x)
     x = down(x);
   }
 
+  if (srclen == 0 && old != 0 && STATIC_IntegerRep(old))
+    return &_ZeroRep;
   IntegerRep* rep;
-  if (old == 0 || srclen > old->sz)
+  if (old == 0 || STATIC_IntegerRep(old) || srclen > old->sz)
   {
     if (old != 0 && !STATIC_IntegerRep(old)) delete old;
     rep = Inew(srclen);
@@ -373,6 +385,21 @@ IntegerRep* Icopy_one(IntegerRep* old, int newsgn)
   return old;
 }
 
+// give rep the sign newsgn, copying it first if it is a static rep
+
+static IntegerRep* Isetsgn(IntegerRep* rep, int newsgn)
+{
+  if (STATIC_IntegerRep(rep))
+  {
+    if (rep->len == 0 || rep->sgn == newsgn)
+      return rep;
+    rep = Icopy(0, rep);
+  }
+  rep->sgn = newsgn;
+  Icheck(rep);
+  return rep;
+}
+
 // convert to a legal two's complement long if possible
 // if too big, return most negative/positive value
 
@@ -492,47 +519,38 @@ int Iisdouble(const IntegerRep* rep)
 
 double ratio(const Integer& num, const Integer& den)
 {
-  Integer q, r;
-  divide(num, den, q, r);
-  double d1 = q.as_double();
- 
-  if (d1 >= DBL_MAX || d1 <= -DBL_MAX || sign(r) == 0)
-    return d1;
-  else      // use as much precision as available for fractional part
-  {
-    double  d2 = 0.0;
-    double  d3 = 0.0; 
-    int cont = 1;
-    for (int i = den.rep->len - 1; i >= 0 && cont; --i)
-    {
-		unsigned short a = (unsigned short) (I_RADIX >> 1);
-      while (a != 0)
-      {
-        if (d2 + 1.0 == d2) // out of precision when we get here
-        {
-          cont = 0;
-          break;
-        }
-
-        d2 *= 2.0;
-        if (den.rep->s[i] & a)
-          d2 += 1.0;
+  if (sign(num) == 0)  return 0.0;
 
-        if (i < r.rep->len)
-        {
-          d3 *= 2.0;
-          if (r.rep->s[i] & a)
-            d3 += 1.0;
-        }
+  Integer x(num), y(den);
+  x.abs();
+  y.abs();
 
-        a >>= 1;
-      }
-    }
+  // Scale the quotient to an integer of 53 or 54 bits, then to
+  // exactly 53 bits, which a double holds exactly.  The remainder
+  // decides the rounding, to nearest with ties to even.
+  long shift = 53 - (lg(x) - lg(y));
+  Integer top;
+  lshift(Integer(1), 53, top);
+  Integer q, r, n, d;
+  for (;;) {
+    n = x;
+    d = y;
+    if (shift > 0)  lshift(x, shift, n);
+    else if (shift < 0)  lshift(y, -shift, d);
+    divide(n, d, q, r);
+    if (compare(q, top) < 0)  break;
+    shift--;
+  }
 
-    if (sign(r) < 0)
-      d3 = -d3;
-    return d1 + d3 / d2;
+  Integer twice;
+  lshift(r, 1, twice);
+  int cmp = compare(twice, d);
+  if (cmp > 0 || (cmp == 0 && odd(q))) {
+    q += 1;
   }
+
+  double result = ldexp(q.as_double(), (int) -shift);
+  return (sign(num) * sign(den) < 0) ? -result : result;
 }
 
 // comparison functions
@@ -1009,8 +1027,7 @@ IntegerRep* multiply(const IntegerRep* x, const IntegerRep* y, IntegerRep* r)
         --hia;
     }
   }
-  r->sgn = rsgn;
-  Icheck(r);
+  r = Isetsgn(r, rsgn);
   return r;
 }
 
@@ -1272,8 +1289,7 @@ IntegerRep* div(const IntegerRep* x, const IntegerRep* y, IntegerRep* q)
     if (yy != y && !STATIC_IntegerRep(yy)) delete yy;
     if (!STATIC_IntegerRep(r)) delete r;
   }
-  q->sgn = samesign;
-  Icheck(q);
+  q = Isetsgn(q, samesign);
   return q;
 }
 
@@ -1340,8 +1356,7 @@ IntegerRep* div(const IntegerRep* x, long y, IntegerRep* q)
 
     if (!STATIC_IntegerRep(r)) delete r;
   }
-  q->sgn = samesign;
-  Icheck(q);
+  q = Isetsgn(q, samesign);
   return q;
 }
 
@@ -1425,8 +1440,7 @@ void divide(const Integer& Ix, long y, Integer& Iq, long& rem)
   }
   rem = abs(rem).as_long();
   if (xsgn == I_NEGATIVE) rem = -rem;
-  q->sgn = samesign;
-  Icheck(q);
+  q = Isetsgn(q, samesign);
   Iq.rep = q;
 }
 
@@ -1499,8 +1513,7 @@ void divide(const Integer& Ix, const Integer& Iy, Integer& Iq, Integer& Ir)
       unscale(r->s, r->len, prescale, r->s);
     }
   }
-  q->sgn = samesign;
-  Icheck(q);
+  q = Isetsgn(q, samesign);
   Iq.rep = q;
   Icheck(r);
   Ir.rep = r;
@@ -1694,8 +1707,7 @@ IntegerRep* lshift(const IntegerRep* x, long y, IntegerRep* r)
         *rs++ = 0;
     }
   }
-  r->sgn = rsgn;
-  Icheck(r);
+  r = Isetsgn(r, rsgn);
   return r;
 }
 
@@ -1829,6 +1841,8 @@ IntegerRep*  Compl(const IntegerRep* src, IntegerRep* r)
 {
   nonnil(src);
   r = Icopy(r, src);
+  if (STATIC_IntegerRep(r))
+    r = Icopy(0, r);
   unsigned short* s = r->s;
   unsigned short* top = &(s[r->len - 1]);
   while (s < top)
@@ -1856,7 +1870,7 @@ void (setbit)(Integer& x, long b)
 	 int bw = (int) ((unsigned long)b / I_SHIFT);
 	 int sw = (int) ((unsigned long)b % I_SHIFT);
     int xl = x.rep ? x.rep->len : 0;
-    if (xl <= bw)
+    if (xl <= bw || STATIC_IntegerRep(x.rep))
       x.rep = Iresize(x.rep, calc_len(xl, bw+1, 0));
     x.rep->s[bw] |= (1 << sw);
     Icheck(x.rep);
@@ -2044,8 +2058,7 @@ IntegerRep* power(const IntegerRep* x, long y, IntegerRep* r)
     }
     if (!STATIC_IntegerRep(b)) delete b;
   }
-  r->sgn = sgn;
-  Icheck(r);
+  r = Isetsgn(r, sgn);
   return r;
 }
 
@@ -2054,8 +2067,7 @@ IntegerRep* abs(const IntegerRep* src, IntegerRep* dest)
   nonnil(src);
   if (src != dest)
     dest = Icopy(dest, src);
-  dest->sgn = I_POSITIVE;
-  return dest;
+  return Isetsgn(dest, I_POSITIVE);
 }
 
 IntegerRep* negate(const IntegerRep* src, IntegerRep* dest)
@@ -2064,7 +2076,7 @@ IntegerRep* negate(const IntegerRep* src, IntegerRep* dest)
   if (src != dest)
     dest = Icopy(dest, src);
   if (dest->len != 0) 
-    dest->sgn = !dest->sgn;
+    dest = Isetsgn(dest, !dest->sgn);
   return dest;
 }
 
@@ -0,0 +1,57 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2010, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/libgambit/nash.h
+// Interface for reporting equilibria as a computation finds them
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef LIBGAMBIT_NASH_H
+#define LIBGAMBIT_NASH_H
+
+namespace Gambit {
+
+///
+/// An observer is handed each profile found by an equilibrium
+/// computation as soon as it is found, so that callers (the command-line
+/// tools, the graphical interface) can display results while the
+/// computation is still running.  The computation polls IsCancelled()
+/// between steps, and returns early once it reports true.
+///
+/// The default implementations discard all profiles and never cancel;
+/// derived classes override only the overloads their solver produces.
+///
+class NashObserver {
+public:
+  virtual ~NashObserver() { }
+
+  /// Called with each equilibrium in strategies as it is found
+  virtual void OnProfile(const MixedStrategyProfile<double> &) { }
+  /// Called with each equilibrium in strategies as it is found
+  virtual void OnProfile(const MixedStrategyProfile<Rational> &) { }
+  /// Called with each equilibrium in behavior strategies as it is found
+  virtual void OnProfile(const MixedBehavProfile<double> &) { }
+  /// Called with each equilibrium in behavior strategies as it is found
+  virtual void OnProfile(const MixedBehavProfile<Rational> &) { }
+
+  /// Returns true if the computation should stop as soon as possible
+  virtual bool IsCancelled(void) const { return false; }
+};
+
+}
+
+#endif   // LIBGAMBIT_NASH_H
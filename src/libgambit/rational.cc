@@ -378,7 +378,8 @@ Rational::fits_in_double() const
 // These were moved from the header file to eliminate warnings
 //
 
-static IntegerRep _ZeroRep = {1, 0, 1, {0}};
+// As in integer.cc, these are shared, and are never written to
+static IntegerRep _ZeroRep = {0, 0, 1, {0}};
 static IntegerRep _OneRep = {1, 0, 1, {1}};
 
 Rational::Rational() : num(&_ZeroRep), den(&_OneRep) {}
@@ -556,6 +557,9 @@ Rational lexical_cast(const std::string &f)
 	expsign = -1;
 	ch = f[index++];
       }
+      else if (ch == '+') {
+	ch = f[index++];
+      }
       while (ch >= '0' && ch <= '9' && index <= length) {
 	exponent *= 10;
 	exponent += (int) (ch - '0');
@@ -583,6 +587,9 @@ Rational lexical_cast(const std::string &f)
       expsign = -1;
       ch = f[index++];
     }
+    else if (ch == '+') {
+      ch = f[index++];
+    }
     while (ch >= '0' && ch <= '9' && index <= length) {
       exponent *= 10;
       exponent += (int) (ch - '0');
@@ -157,23 +157,141 @@ bool StrategySupport::Dominates(const GameStrategy &s,
 				const GameStrategy &t, 
 				bool p_strict) const
 {
+  return Dominates(s, t, p_strict, 0);
+}
+
+bool StrategySupport::Dominates(const GameStrategy &s, 
+				const GameStrategy &t, 
+				bool p_strict, Array<int> *p_witness) const
+{
+  if (p_witness)  *p_witness = Array<int>();
+
+  if (!m_nfg->IsTree()) {
+    return DominatesTable(s, t, p_strict, p_witness);
+  }
+
   bool equal = true;
   
   for (StrategyIterator iter(*this); !iter.AtEnd(); iter++) {
     Rational ap = iter->GetStrategyValue<Rational>(s);
     Rational bp = iter->GetStrategyValue<Rational>(t);
-    if (p_strict && ap <= bp) {
+    if ((p_strict && ap <= bp) || (!p_strict && ap < bp)) {
+      if (p_witness) {
+	int player = s->GetPlayer()->GetNumber();
+	*p_witness = Array<int>(m_support.Length());
+	for (int pl = 1; pl <= m_support.Length(); pl++) {
+	  (*p_witness)[pl] = (pl == player) ? 0 : 
+	    iter->GetStrategy(pl)->GetId();
+	}
+      }
       return false;
     }
-    else if (!p_strict) {
-      if (ap < bp) return false;
-      else if (ap > bp) equal = false;
+    else if (!p_strict && ap > bp) {
+      equal = false;
     }
   }
 
   return (p_strict || !equal);
 }
 
+//
+// For games in table form, the payoffs to s and t against each
+// contingency of the other players are at a fixed distance from each
+// other in the table of outcomes.  This walks the contingencies of the
+// other players in the support directly, keeping the running index into
+// the table, and compares the payoffs in place.  This avoids constructing
+// a profile and copying two rational numbers for each contingency.
+//
+bool StrategySupport::DominatesTable(const GameStrategy &s,
+				     const GameStrategy &t,
+				     bool p_strict, Array<int> *p_witness) const
+{
+  Array<Array<GameStrategyRep *> > strategies(m_support.Length());
+  for (int pl = 1; pl <= m_support.Length(); pl++) {
+    strategies[pl] = Array<GameStrategyRep *>(m_support[pl].Length());
+    for (int st = 1; st <= m_support[pl].Length(); st++) {
+      strategies[pl][st] = m_support[pl][st];
+    }
+  }
+  return DominatesTable(m_nfg, s, t, strategies, p_strict, p_witness);
+}
+
+bool StrategySupport::DominatesTable(const GameRep *game,
+				     const GameStrategyRep *srep,
+				     const GameStrategyRep *trep,
+				     const Array<Array<GameStrategyRep *> > &p_strategies,
+				     bool p_strict, Array<int> *p_witness)
+{
+  int player = srep->m_player->GetNumber();
+  int numPlayers = p_strategies.Length();
+
+  // The table offsets of the strategies in the support, by player
+  Array<Array<long> > offsets(numPlayers);
+  Array<int> current(numPlayers);
+  long index = 1L;
+  for (int pl = 1; pl <= numPlayers; pl++) {
+    if (pl == player)  continue;
+    offsets[pl] = Array<long>(p_strategies[pl].Length());
+    for (int st = 1; st <= p_strategies[pl].Length(); st++) {
+      offsets[pl][st] = p_strategies[pl][st]->m_offset;
+    }
+    current[pl] = 1;
+    index += offsets[pl][1];
+  }
+
+  const Rational zero(0);
+  bool equal = true, fails = false;
+
+  while (true) {
+    const GameOutcomeRep *sOutcome = game->m_results[index + srep->m_offset];
+    const GameOutcomeRep *tOutcome = game->m_results[index + trep->m_offset];
+
+    if (sOutcome == tOutcome) {
+      // Same outcome (or both null): payoffs are equal
+      fails = p_strict;
+    }
+    else {
+      const Rational &ap = (sOutcome) ? 
+	sOutcome->GetPayoff<Rational>(player) : zero;
+      const Rational &bp = (tOutcome) ?
+	tOutcome->GetPayoff<Rational>(player) : zero;
+      if (p_strict) {
+	fails = (ap <= bp);
+      }
+      else {
+	fails = (ap < bp);
+	if (ap > bp) equal = false;
+      }
+    }
+
+    if (fails) {
+      if (p_witness) {
+	*p_witness = Array<int>(numPlayers);
+	for (int pl = 1; pl <= numPlayers; pl++) {
+	  (*p_witness)[pl] = (pl == player) ? 0 :
+	    p_strategies[pl][current[pl]]->GetId();
+	}
+      }
+      return false;
+    }
+
+    // Advance to the next contingency of the other players
+    int pl;
+    for (pl = 1; pl <= numPlayers; pl++) {
+      if (pl == player) continue;
+      index -= offsets[pl][current[pl]];
+      if (current[pl] < offsets[pl].Length()) {
+	index += offsets[pl][++current[pl]];
+	break;
+      }
+      current[pl] = 1;
+      index += offsets[pl][1];
+    }
+    if (pl > numPlayers) break;
+  }
+
+  return (p_strict || !equal);
+}
 
 bool StrategySupport::IsDominated(const GameStrategy &s, 
 				  bool p_strict,
@@ -322,6 +440,255 @@ bool StrategySupport::Overwhelms(const GameStrategy &s,
   return true;
 }
 
+//===========================================================================
+//                       class PackedStrategySupport
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//                               Lifecycle
+//---------------------------------------------------------------------------
+
+PackedStrategySupport::PackedStrategySupport(const Game &p_nfg)
+  : m_nfg(p_nfg), 
+    m_bits((p_nfg->MixedProfileLength() + c_wordBits - 1) / c_wordBits),
+    m_numStrategies(p_nfg->NumPlayers())
+{
+  for (int i = 1; i <= m_bits.Length(); m_bits[i++] = 0UL);
+  for (int id = 1; id <= p_nfg->MixedProfileLength(); SetBit(id++));
+  for (int pl = 1; pl <= p_nfg->NumPlayers(); pl++) {
+    m_numStrategies[pl] = p_nfg->GetPlayer(pl)->NumStrategies();
+  }
+}
+
+PackedStrategySupport::PackedStrategySupport(const StrategySupport &p_support)
+  : m_nfg(p_support.GetGame()),
+    m_bits((m_nfg->MixedProfileLength() + c_wordBits - 1) / c_wordBits),
+    m_numStrategies(p_support.NumStrategies())
+{
+  for (int i = 1; i <= m_bits.Length(); m_bits[i++] = 0UL);
+  for (int id = 1; id <= m_nfg->MixedProfileLength(); id++) {
+    if (p_support.m_profileIndex[id] >= 0)  SetBit(id);
+  }
+}
+
+//---------------------------------------------------------------------------
+//                          General information
+//---------------------------------------------------------------------------
+
+bool PackedStrategySupport::operator<(const PackedStrategySupport &p_support) const
+{
+  for (int id = 1; id <= m_nfg->MixedProfileLength(); id++) {
+    if (GetBit(id) != p_support.GetBit(id)) {
+      return GetBit(id);
+    }
+  }
+  return false;
+}
+
+int PackedStrategySupport::MixedProfileLength(void) const
+{
+  int total = 0;
+  for (int pl = 1; pl <= m_numStrategies.Length(); 
+       total += m_numStrategies[pl++]);
+  return total;
+}
+
+unsigned long PackedStrategySupport::Hash(void) const
+{
+  unsigned long hash = 2166136261UL;
+  for (int i = 1; i <= m_bits.Length(); i++) {
+    hash = (hash ^ m_bits[i]) * 16777619UL;
+  }
+  return hash;
+}
+
+StrategySupport PackedStrategySupport::ToSupport(void) const
+{
+  StrategySupport support(m_nfg);
+  for (int id = 1; id <= m_nfg->MixedProfileLength(); id++) {
+    if (!GetBit(id))  support.RemoveStrategy(m_nfg->GetStrategy(id));
+  }
+  return support;
+}
+
+//---------------------------------------------------------------------------
+//                        Modifying the support
+//---------------------------------------------------------------------------
+
+void PackedStrategySupport::AddStrategy(const GameStrategy &p_strategy)
+{
+  if (!GetBit(p_strategy->GetId())) {
+    SetBit(p_strategy->GetId());
+    m_numStrategies[p_strategy->GetPlayer()->GetNumber()]++;
+  }
+}
+
+bool PackedStrategySupport::RemoveStrategy(const GameStrategy &p_strategy)
+{
+  int pl = p_strategy->GetPlayer()->GetNumber();
+  if (!GetBit(p_strategy->GetId()) || m_numStrategies[pl] == 1) {
+    return false;
+  }
+  ClearBit(p_strategy->GetId());
+  m_numStrategies[pl]--;
+  return true;
+}
+
+//
+// Treating the membership bits of the strategies in p_support as the
+// digits of a binary number, with the first strategy most significant,
+// the lexicographic successor is obtained by decrementing that number.
+// Players' strategies are numbered consecutively, so a decrement
+// which leaves some player with no strategies is followed by one which
+// restores all of that player's strategies.
+//
+bool PackedStrategySupport::Next(const PackedStrategySupport &p_support)
+{
+  PackedStrategySupport next(*this);
+  int numIds = m_nfg->MixedProfileLength();
+
+  do {
+    int id = numIds;
+    for (; id >= 1; id--) {
+      if (!p_support.GetBit(id))  continue;
+      if (next.GetBit(id))  break;
+    }
+    if (id == 0)  return false;
+
+    next.ClearBit(id);
+    for (int later = id + 1; later <= numIds; later++) {
+      if (p_support.GetBit(later))  next.SetBit(later);
+    }
+
+    for (int pl = 1; pl <= m_nfg->NumPlayers(); pl++) {
+      GamePlayerRep *player = m_nfg->GetPlayer(pl);
+      next.m_numStrategies[pl] = 0;
+      for (int st = 1; st <= player->NumStrategies(); st++) {
+	if (next.GetBit(player->GetStrategy(st)->GetId())) {
+	  next.m_numStrategies[pl]++;
+	}
+      }
+    }
+  } while (next.m_numStrategies.Contains(0));
+
+  *this = next;
+  return true;
+}
+
+//---------------------------------------------------------------------------
+//                 Identification of dominated strategies
+//---------------------------------------------------------------------------
+
+bool PackedStrategySupport::Dominates(const GameStrategy &s,
+				      const GameStrategy &t,
+				      bool p_strict) const
+{
+  if (m_nfg->IsTree()) {
+    return ToSupport().Dominates(s, t, p_strict);
+  }
+
+  Array<Array<GameStrategyRep *> > strategies(m_nfg->NumPlayers());
+  for (int pl = 1; pl <= m_nfg->NumPlayers(); pl++) {
+    GamePlayerRep *player = m_nfg->GetPlayer(pl);
+    strategies[pl] = Array<GameStrategyRep *>(m_numStrategies[pl]);
+    for (int st = 1, i = 1; st <= player->NumStrategies(); st++) {
+      GameStrategyRep *strategy = player->GetStrategy(st);
+      if (GetBit(strategy->GetId()))  strategies[pl][i++] = strategy;
+    }
+  }
+  return StrategySupport::DominatesTable(m_nfg, s, t, strategies, 
+					 p_strict, 0);
+}
+
+bool PackedStrategySupport::IsDominated(const GameStrategy &s, 
+					bool p_strict) const
+{
+  GamePlayer player = s->GetPlayer();
+  for (int st = 1; st <= player->NumStrategies(); st++) {
+    GameStrategy t = player->GetStrategy(st);
+    if (t != s && GetBit(t->GetId()) && Dominates(t, s, p_strict)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+//===========================================================================
+//                        class StrategyEliminator
+//===========================================================================
+
+StrategyEliminator::StrategyEliminator(const StrategySupport &p_support,
+				       bool p_strict)
+  : m_support(p_support), m_strict(p_strict), m_rounds(0),
+    m_dirty(p_support.GetGame()->NumPlayers()),
+    m_witness(p_support.GetGame()->NumPlayers())
+{
+  for (int pl = 1; pl <= m_dirty.Length(); pl++) {
+    m_dirty[pl] = true;
+    int n = m_support.GetGame()->GetPlayer(pl)->NumStrategies();
+    m_witness[pl] = Array<Array<int> >(n * n);
+  }
+}
+
+Array<int> &StrategyEliminator::Witness(int pl, 
+					const GameStrategy &s,
+					const GameStrategy &t)
+{
+  int n = m_support.GetGame()->GetPlayer(pl)->NumStrategies();
+  return m_witness[pl][(t->GetNumber() - 1) * n + s->GetNumber()];
+}
+
+bool StrategyEliminator::IsWitnessValid(const Array<int> &p_witness) const
+{
+  if (p_witness.Length() == 0)  return false;
+  for (int pl = 1; pl <= p_witness.Length(); pl++) {
+    if (p_witness[pl] > 0 && m_support.m_profileIndex[p_witness[pl]] < 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool StrategyEliminator::NextRound(void)
+{
+  int numPlayers = m_support.GetGame()->NumPlayers();
+  StrategySupport newSupport(m_support);
+  Array<bool> changed(numPlayers);
+
+  for (int pl = 1; pl <= numPlayers; pl++) {
+    changed[pl] = false;
+    if (!m_dirty[pl])  continue;
+
+    for (int i = 1; i <= m_support.NumStrategies(pl); i++) {
+      GameStrategy t = m_support.GetStrategy(pl, i);
+      for (int j = 1; j <= m_support.NumStrategies(pl); j++) {
+	GameStrategy s = m_support.GetStrategy(pl, j);
+	if (s == t)  continue;
+	Array<int> &witness = Witness(pl, s, t);
+	if (IsWitnessValid(witness))  continue;
+	if (m_support.Dominates(s, t, m_strict, &witness)) {
+	  newSupport.RemoveStrategy(t);
+	  changed[pl] = true;
+	  break;
+	}
+      }
+    }
+  }
 
+  bool any = false;
+  for (int pl = 1; pl <= numPlayers; pl++) {
+    any = any || changed[pl];
+    m_dirty[pl] = false;
+    for (int opp = 1; opp <= numPlayers; opp++) {
+      if (opp != pl && changed[opp])  m_dirty[pl] = true;
+    }
+  }
+
+  if (any) {
+    m_support = newSupport;
+    m_rounds++;
+  }
+  return any;
+}
 
 } // end namespace Gambit
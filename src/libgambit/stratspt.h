@@ -73,6 +73,8 @@ public:
 /// in which they appear in the underlying game.
 class StrategySupport {
   template <class T> friend class MixedStrategyProfile;
+  friend class StrategyEliminator;
+  friend class PackedStrategySupport;
 protected:
   Game m_nfg;
   Array<Array<GameStrategy> > m_support;
@@ -82,6 +84,25 @@ protected:
   
   bool Undominated(StrategySupport &newS, int p_player, 
 		   bool p_strict, bool p_external = false) const;
+  /// Dominance test which scans the payoff table of a strategic game directly
+  bool DominatesTable(const GameStrategy &s, const GameStrategy &t,
+		      bool p_strict, Array<int> *p_witness) const;
+  /// Scans the payoff table against the contingencies formed from
+  /// the listed strategies of the other players
+  static bool DominatesTable(const GameRep *, 
+			     const GameStrategyRep *s, 
+			     const GameStrategyRep *t,
+			     const Array<Array<GameStrategyRep *> > &,
+			     bool p_strict, Array<int> *p_witness);
+  /// \brief Dominance test which also reports a counterexample
+  ///
+  /// If s does not dominate t because of some contingency at which t
+  /// does at least as well as s (strictly better for weak dominance),
+  /// the ids of the strategies of the other players in that contingency
+  /// are returned in p_witness (with zero for the player of s and t).
+  /// Otherwise, p_witness is returned empty.
+  bool Dominates(const GameStrategy &s, const GameStrategy &t,
+		 bool p_strict, Array<int> *p_witness) const;
 
 public:
   /// @name Lifecycle
@@ -170,6 +191,153 @@ public:
   //@}
 };
 
+/// \brief A support on a strategic game, stored as a set of bits
+///
+/// This class represents the same information as StrategySupport,
+/// but keeps only one bit per strategy, indexed by the strategy's id.
+/// Membership tests are constant-time, and copying a support copies
+/// only a few words, so this representation is suited to algorithms
+/// which generate and store large numbers of supports, such as
+/// enumeration of possible equilibrium supports.  Supports are
+/// converted to StrategySupport only when they are to be used for
+/// computing on the restricted game.
+///
+/// Supports are ordered lexicographically by the membership of the
+/// strategies, in the order of their ids, with a support containing
+/// a strategy preceding one which does not.  Thus, the full support
+/// comes first.
+class PackedStrategySupport {
+private:
+  Game m_nfg;
+  Array<unsigned long> m_bits;
+  Array<int> m_numStrategies;
+
+  static const int c_wordBits = 8 * sizeof(unsigned long);
+
+  bool GetBit(int p_id) const
+    { return (m_bits[(p_id - 1) / c_wordBits + 1] >> 
+	      ((p_id - 1) % c_wordBits)) & 1UL; }
+  void SetBit(int p_id)
+    { m_bits[(p_id - 1) / c_wordBits + 1] |= 1UL << ((p_id - 1) % c_wordBits); }
+  void ClearBit(int p_id)
+    { m_bits[(p_id - 1) / c_wordBits + 1] &= ~(1UL << ((p_id - 1) % c_wordBits)); }
+
+public:
+  /// @name Lifecycle
+  //@{
+  /// Constructor.  By default, a support contains all strategies.
+  PackedStrategySupport(const Game &);
+  /// Construct from a support
+  PackedStrategySupport(const StrategySupport &);
+  //@}
+
+  /// @name Operator overloading
+  //@{
+  /// Test for the equality of two supports (same strategies for all players)
+  bool operator==(const PackedStrategySupport &p_support) const
+    { return (m_bits == p_support.m_bits); }
+  /// Test for the inequality of two supports
+  bool operator!=(const PackedStrategySupport &p_support) const
+    { return (m_bits != p_support.m_bits); }
+  /// Lexicographic comparison of two supports
+  bool operator<(const PackedStrategySupport &) const;
+  //@}
+
+  /// @name General information
+  //@{
+  /// Returns the game on which the support is defined.
+  Game GetGame(void) const { return m_nfg; }
+  /// Returns the number of strategies in the support for player pl.
+  int NumStrategies(int pl) const { return m_numStrategies[pl]; }
+  /// Returns the total number of strategies in the support.
+  int MixedProfileLength(void) const;
+  /// Returns true exactly when the strategy is in the support.
+  bool Contains(const GameStrategy &s) const { return GetBit(s->GetId()); }
+  /// Returns true exactly when the strategy with the given id is in the support.
+  bool Contains(int p_id) const { return GetBit(p_id); }
+  /// Returns a hash value for the support
+  unsigned long Hash(void) const;
+  /// Returns the support as a StrategySupport
+  StrategySupport ToSupport(void) const;
+  //@}
+
+  /// @name Modifying the support
+  //@{
+  /// Add a strategy to the support.
+  void AddStrategy(const GameStrategy &);
+  /// \brief Removes a strategy from the support
+  ///
+  /// As with StrategySupport, the strategy is not removed if it is
+  /// not present, or if it is the only strategy for that player.
+  /// Returns true if the removal was executed, and false if not.
+  bool RemoveStrategy(const GameStrategy &);
+  /// \brief Advance to the lexicographic successor
+  ///
+  /// Changes the support to the next subsupport of p_support in
+  /// lexicographic order in which each player has at least one strategy.
+  /// This support must itself be a subsupport of p_support.  Returns
+  /// false, leaving the support unchanged, if this is the last one.
+  bool Next(const PackedStrategySupport &p_support);
+  //@}
+
+  /// @name Identification of dominated strategies
+  //@{
+  bool Dominates(const GameStrategy &s, const GameStrategy &t,
+		 bool p_strict) const;
+  bool IsDominated(const GameStrategy &s, bool p_strict) const;
+  //@}
+};
+
+/// \brief Iterated elimination of dominated strategies
+///
+/// This class carries out iterated elimination of dominated strategies,
+/// one round at a time.  Each round has the same effect as
+/// StrategySupport::Undominated(), but information from earlier rounds
+/// is reused:
+/// - When a strategy s is found not to dominate t, the contingency
+///   of the other players which shows this is remembered.  The pair is
+///   only examined again once one of the strategies in that contingency
+///   has been eliminated.
+/// - A player's strategies are only examined if some other player's
+///   support changed in the previous round, since removing a player's
+///   own strategies does not change dominance among the remaining ones.
+class StrategyEliminator {
+private:
+  StrategySupport m_support;
+  bool m_strict;
+  int m_rounds;
+  /// Players whose strategies need to be examined in the next round
+  Array<bool> m_dirty;
+  /// Counterexamples to dominance, indexed by player, then by pair
+  Array<Array<Array<int> > > m_witness;
+
+  Array<int> &Witness(int pl, const GameStrategy &s, const GameStrategy &t);
+  bool IsWitnessValid(const Array<int> &) const;
+
+public:
+  /// @name Lifecycle
+  //@{
+  /// Begin iterated elimination from the given support
+  StrategyEliminator(const StrategySupport &, bool p_strict);
+  //@}
+
+  /// @name Elimination
+  //@{
+  /// Carry out one round; returns true if any strategy was eliminated
+  bool NextRound(void);
+  /// Carry out rounds until no further strategies are eliminated
+  void Run(void) { while (NextRound()); }
+  //@}
+
+  /// @name Data access
+  //@{
+  /// Returns the support after the rounds of elimination carried out so far
+  const StrategySupport &GetSupport(void) const { return m_support; }
+  /// Returns the number of rounds of elimination carried out so far
+  int NumRounds(void) const { return m_rounds; }
+  //@}
+};
+
 } // end namespace Gambit
 
 #endif // LIBGAMBIT_STRATSPT_H
@@ -0,0 +1,94 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2010, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/liblinear/lpdom.h
+// Interface to dominance by mixed strategies via linear programming
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef LPDOM_H
+#define LPDOM_H
+
+#include "libgambit/libgambit.h"
+#include "lpsolve.h"
+
+//
+// This class tests whether strategies of one player are dominated by
+// mixtures over that player's other strategies in a support.
+// The payoffs to the player's strategies against each contingency of
+// the other players are extracted once, at construction, into a
+// matrix which is shared by all the tests.
+//
+// A strategy s is strictly dominated exactly when, with all payoffs
+// shifted to be positive, there are weights p >= 0 on the other
+// strategies with sum_r p_r u(r,c) >= u(s,c) for all contingencies c
+// and sum_r p_r < 1.  It is weakly dominated exactly when some mixture
+// does at least as well as s against every contingency and strictly
+// better against some contingency.
+//
+// Both tests are carried out on the dual programs, which have one
+// constraint per active strategy and in which the tested strategy
+// enters only through the objective.  Each program is therefore built
+// once, and each test re-optimizes it from the previous optimal basis
+// with a new cost vector.  A program is rebuilt only after a strategy
+// is deactivated.
+//
+template <class T> class MixedDominanceLP {
+private:
+  Gambit::StrategySupport m_support;
+  int m_player;
+  Gambit::Matrix<T> m_payoffs;   // contingencies x strategies of player
+  Gambit::Array<bool> m_active;
+
+  // A program, with the constraints its tableau refers to
+  class Program {
+  public:
+    Gambit::Matrix<T> A;
+    Gambit::Vector<T> b;
+    LPSolve<T> LP;
+
+    Program(const Gambit::Matrix<T> &p_A, const Gambit::Vector<T> &p_b,
+	    const Gambit::Vector<T> &p_c)
+      : A(p_A), b(p_b), LP(A, b, p_c, 0) { }
+  };
+  mutable Program *m_strict, *m_weak;
+
+  bool IsStrictlyDominated(int p_index) const;
+  bool IsWeaklyDominated(int p_index) const;
+
+  /// Objects own their programs, and are not copyable
+  MixedDominanceLP(const MixedDominanceLP<T> &);
+  MixedDominanceLP<T> &operator=(const MixedDominanceLP<T> &);
+
+public:
+  MixedDominanceLP(const Gambit::StrategySupport &p_support, int p_player);
+  ~MixedDominanceLP();
+
+  /// Is the strategy dominated by a mixture of the other active strategies?
+  bool IsDominated(const Gambit::GameStrategy &, bool p_strict) const;
+  /// Excludes the strategy from the mixtures considered in further tests
+  void Deactivate(const Gambit::GameStrategy &);
+};
+
+/// Returns a copy of the support, with the strategies which are
+/// dominated by mixed strategies in the support eliminated.  As with
+/// StrategySupport::Undominated(), this carries out one round of
+/// elimination; iterate to obtain the iterated undominated support.
+template <class T> Gambit::StrategySupport
+UndominatedMixed(const Gambit::StrategySupport &p_support, bool p_strict);
+
+#endif  // LPDOM_H
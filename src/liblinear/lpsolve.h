@@ -51,6 +51,7 @@ private:
   Gambit::Vector<T> y, x, d;
 
   void Solve(int phase = 0);
+  void Optimize(const Gambit::Vector<T> &c);
   int Enter(void);
   int Exit(int);
 public:
@@ -61,6 +62,13 @@ public:
 //	  const Gambit::Vector<int> &LB,  const Gambit::Vector<T> &lb, 
 //	  const Gambit::Vector<int> &UB, const Gambit::Vector<T> &ub);
   ~LPSolve();
+
+  // Solves the program again for a new cost vector, of the same length,
+  // starting from the optimal basis of the last solution.  The
+  // constraints are unchanged, so that basis is still feasible.
+  // The tableau refers to the A and B passed to the constructor,
+  // which must therefore still exist.
+  void Resolve(const Gambit::Vector<T> &C);
   
   T OptimumCost(void) const;
   const Gambit::Vector<T> &OptimumVector(void) const;
@@ -1,5 +1,10 @@
 """
 A set of utilities for computing Nash equilibria
+
+enumpure, lp and lcp call the solvers compiled into the extension
+module.  enummixed and simpdiv still run gambit-enummixed and
+gambit-simpdiv as external programs.  The liap, logit, gnm and ipa
+solvers are not available from this module.
 """
 
 import os, sys
@@ -24,57 +29,95 @@ def launch_external_program(prog, game):
     return child_stdout
 
 
-def lp(game, rational=False):
+def read_external_profiles(prog, game, rational=False, behavior=False):
     """
-    Compute an equilibrium of a two-player constant-sum game by solving
-    a linear programming problem.
+    Run the external program 'prog' on the game, and return the
+    profiles it reports, as mixed strategy profiles or, if 'behavior'
+    is true, as behavior profiles.
     """
     profiles = [ ]
 
-    commandLine = "gambit-lp"
-    if not rational:
-        commandLine += " -d 10"
-    
-    for line in launch_external_program(commandLine, game):
+    for line in launch_external_program(prog, game):
         entries = line.strip().split(",")
         if entries[0] != "NE":  continue
-        
-        profile = game.mixed_strategy(rational=rational)
+
+        if behavior:
+            profile = game.behavior_strategy(rational=rational)
+        else:
+            profile = game.mixed_strategy(rational=rational)
         for (i, p) in enumerate(entries[1:]):
             if rational:
                 profile[i] = libgambit.Rational(p)
             else:
                 profile[i] = float(p)
-                
+
         profiles.append(profile)
 
     return profiles
 
-def lcp(game, rational=False):
+#
+# enumpure, lp and lcp call the solvers in the extension module when
+# it provides them.  An extension built from an older libgambit_wrap.cxx
+# does not, and then the external programs are run as before.
+#
+native_solvers = hasattr(libgambit, "LcpStrategyDouble")
+
+def enumpure(game, agent=False):
     """
-    Compute equilibria of a two-player game by solving
-    a linear complementarity programming problem.
+    Compute all equilibria in pure strategies.  If 'agent' is true,
+    and the game is a tree, the equilibria of the agent form are
+    computed and returned as behavior profiles; otherwise, the
+    equilibria of the strategic form are returned as mixed strategy
+    profiles.
     """
-    profiles = [ ]
+    if agent and game.is_tree():
+        if native_solvers:
+            return libgambit.EnumPureAgent(game)
+        return read_external_profiles("gambit-enumpure", game,
+                                      rational=True, behavior=True)
+    else:
+        if native_solvers:
+            return libgambit.EnumPureStrategy(game)
+        return read_external_profiles("gambit-enumpure -S", game,
+                                      rational=True)
 
-    commandLine = "gambit-lcp"
-    if not rational:
-        commandLine += " -d 10"
-    
-    for line in launch_external_program(commandLine, game):
-        entries = line.strip().split(",")
-        if entries[0] != "NE":  continue
-        
-        profile = game.mixed_strategy(rational=rational)
-        for (i, p) in enumerate(entries[1:]):
-            if rational:
-                profile[i] = libgambit.Rational(p)
-            else:
-                profile[i] = float(p)
-                
-        profiles.append(profile)
+def lp(game, rational=False):
+    """
+    Compute an equilibrium of a two-player constant-sum game by solving
+    a linear programming problem.
+    """
+    if game.NumPlayers() != 2 or not game.IsConstSum():
+        raise ValueError("lp requires a two-player constant-sum game")
+
+    if not native_solvers:
+        commandLine = "gambit-lp -S"
+        if not rational:
+            commandLine += " -d 10"
+        return read_external_profiles(commandLine, game, rational=rational)
+    elif rational:
+        return libgambit.LpStrategyRational(game)
+    else:
+        return libgambit.LpStrategyDouble(game)
 
-    return profiles
+def lcp(game, rational=False, stop_after=0, max_depth=0):
+    """
+    Compute equilibria of a two-player game by solving
+    a linear complementarity programming problem.  At most
+    'stop_after' equilibria are computed, and paths are followed
+    to a depth of at most 'max_depth' (either is unlimited if zero).
+    """
+    if game.NumPlayers() != 2:
+        raise ValueError("lcp requires a two-player game")
+
+    if not native_solvers:
+        commandLine = "gambit-lcp -S -e %d -r %d" % (stop_after, max_depth)
+        if not rational:
+            commandLine += " -d 10"
+        return read_external_profiles(commandLine, game, rational=rational)
+    elif rational:
+        return libgambit.LcpStrategyRational(game, stop_after, max_depth)
+    else:
+        return libgambit.LcpStrategyDouble(game, stop_after, max_depth)
 
 def enummixed(game, rational=False):
     """
@@ -45,12 +45,30 @@
 
 using namespace Gambit;
 
+//
+// Thrown by the functions wrapped here when called on a game they
+// do not apply to; it becomes a Python ValueError
+//
+class GameValueException : public Gambit::Exception {
+private:
+  const char *m_description;
+
+public:
+  GameValueException(const char *p_description)
+    : m_description(p_description) { }
+  virtual ~GameValueException() throw() { }
+  const char *what(void) const throw() { return m_description; }
+};
+
 %}
 
 %exception {
   try {
     $action
   }
+  catch (GameValueException &e) {
+    SWIG_exception(SWIG_ValueError, e.what());
+  }
   catch (Gambit::IndexException &) {
     SWIG_exception(SWIG_IndexError, "index out of range");
   }
@@ -141,8 +159,8 @@ using namespace Gambit;
 
 %include <libgambit/integer.h>
 %extend Gambit::Integer {
-  std::string __str__(void)   { return ToText(*self); }
-  std::string __repr__(void)  { return ToText(*self); }
+  std::string __str__(void)   { return lexical_cast<std::string>(*self); }
+  std::string __repr__(void)  { return lexical_cast<std::string>(*self); }
 
   // Right-side operators (a nifty Python feature!)
   Integer __radd__(long lhs) const { return Integer(lhs) + *self; }
@@ -162,10 +180,10 @@ using namespace Gambit;
 %extend Gambit::Rational {
   Rational(const std::string &p_string)
     { Rational *r = new Rational;
-      *r = Gambit::ToRational(p_string);
+      *r = lexical_cast<Rational>(p_string);
       return r; }
-  std::string __str__(void)   { return ToText(*self); }  
-  std::string __repr__(void)  { return ToText(*self); }   
+  std::string __str__(void)   { return lexical_cast<std::string>(*self); }  
+  std::string __repr__(void)  { return lexical_cast<std::string>(*self); }   
 
   // Explicit overloads of some operators
   // This combines with SWIG's overloading-handling features to
@@ -211,9 +229,9 @@ using namespace Gambit;
 %extend Gambit::GameOutcomeRep {
   Rational GetPayoff(int pl) const { return self->GetPayoff<Rational>(pl); }
   void SetPayoff(int pl, const Rational &payoff)
-  { self->SetPayoff(pl, Gambit::ToText(payoff)); }
+  { self->SetPayoff(pl, lexical_cast<std::string>(payoff)); }
   void SetPayoff(int pl, double payoff)
-  { self->SetPayoff(pl, Gambit::ToText(payoff)); }
+  { self->SetPayoff(pl, lexical_cast<std::string>(payoff)); }
   void SetPayoff(int pl, const std::string &payoff)
   { self->SetPayoff(pl, payoff); }
 };
@@ -274,6 +292,26 @@ using namespace Gambit;
 %ignore Gambit::GameRep::WriteEfgFile(std::ostream &);
 %ignore Gambit::GameRep::WriteNfgFile(std::ostream &);
 
+%{
+//
+// The shortest text, of 15 to 17 significant digits, which libgambit
+// reads back as the same double.  Seventeen digits always suffice.
+//
+static std::string PayoffText(double p_value)
+{
+  std::ostringstream text;
+  for (int digits = 15; digits <= 17; digits++) {
+    text.str("");
+    text.precision(digits);
+    text << p_value;
+    if ((double) lexical_cast<Rational>(text.str()) == p_value) {
+      break;
+    }
+  }
+  return text.str();
+}
+%}
+
 %extend Gambit::GameRep {
   std::string efg_file(void) const
   {
@@ -303,6 +341,58 @@ using namespace Gambit;
 
   MixedBehavProfile<Gambit::Rational> NewMixedBehavRational(void)
   { return MixedBehavProfile<Gambit::Rational>(BehavSupport(self)); }
+
+  // Copy the payoffs of the strategic form to or from the array of
+  // doubles at p_address.  The array holds one block of contingencies
+  // for each player, with the strategy of player 1 changing fastest
+  // (the order of the .nfg format).  The caller is responsible for the
+  // array being large enough; see payoff_array() and set_payoff_array().
+  void GetPayoffTable(size_t p_address)
+  {
+    double *payoffs = (double *) p_address;
+    StrategySupport support(self);
+    int contingencies = 1;
+    for (int pl = 1; pl <= self->NumPlayers(); pl++) {
+      contingencies *= support.NumStrategies(pl);
+    }
+    int cont = 0;
+    for (StrategyIterator iter(support); !iter.AtEnd(); iter++, cont++) {
+      for (int pl = 1; pl <= self->NumPlayers(); pl++) {
+	payoffs[(pl - 1) * contingencies + cont] = (*iter).GetPayoff<double>(pl);
+      }
+    }
+  }
+
+  void SetPayoffTable(size_t p_address)
+  {
+    const double *payoffs = (const double *) p_address;
+    StrategySupport support(self);
+    int contingencies = 1;
+    for (int pl = 1; pl <= self->NumPlayers(); pl++) {
+      contingencies *= support.NumStrategies(pl);
+    }
+    // An outcome may be shared by several contingencies.  The first of
+    // them to be visited writes to it; each of the others, and each
+    // contingency with no outcome, is given an outcome of its own.
+    Array<bool> written(self->NumOutcomes());
+    for (int i = 1; i <= written.Length(); i++) {
+      written[i] = false;
+    }
+    int cont = 0;
+    for (StrategyIterator iter(support); !iter.AtEnd(); iter++, cont++) {
+      GameOutcome outcome = (*iter).GetOutcome();
+      if (!outcome || written[outcome->GetNumber()]) {
+	outcome = self->NewOutcome();
+	(*iter).SetOutcome(outcome);
+      }
+      else {
+	written[outcome->GetNumber()] = true;
+      }
+      for (int pl = 1; pl <= self->NumPlayers(); pl++) {
+	outcome->SetPayoff(pl, PayoffText(payoffs[(pl - 1) * contingencies + cont]));
+      }
+    }
+  }
 }
 
 %template(Game) Gambit::GameObjectPtr<Gambit::GameRep>;
@@ -327,6 +417,44 @@ using namespace Gambit;
     else:
       return self.NewMixedBehavDouble()
 
+  def payoff_shape(self):
+    return tuple([ self.GetPlayer(pl).NumStrategies()
+                   for pl in range(1, self.NumPlayers()+1) ] +
+                 [ self.NumPlayers() ])
+
+  def payoff_array(self):
+    """
+    Return the payoffs of the strategic form as a NumPy array of floats.
+    Entry [s1, ..., sN, p] is the payoff to player p+1 when each player
+    i plays strategy si+1.  The array is a copy, filled in one call:
+    changing it does not change the game; use set_payoff_array() for
+    that.
+    """
+    import numpy
+    if self.is_tree():
+      self.BuildComputedValues()
+    shape = self.payoff_shape()
+    payoffs = numpy.empty(numpy.prod(shape), dtype=float)
+    self.GetPayoffTable(payoffs.ctypes.data)
+    return payoffs.reshape(shape, order="F")
+
+  def set_payoff_array(self, payoffs):
+    """
+    Set the payoffs of a strategic game from an array laid out as
+    returned by payoff_array().  Each payoff is stored as the shortest
+    decimal text which reads back as the same float, so payoff_array()
+    then returns the same values.
+    """
+    import numpy
+    if self.is_tree():
+      raise ValueError("payoffs of a tree are set on its outcomes")
+    payoffs = numpy.asarray(payoffs, dtype=float)
+    if payoffs.shape != self.payoff_shape():
+      raise ValueError("payoff array has shape %s; expected %s" %
+                       (payoffs.shape, self.payoff_shape()))
+    payoffs = numpy.ascontiguousarray(payoffs.ravel(order="F"))
+    self.SetPayoffTable(payoffs.ctypes.data)
+
   def __str__(self):
     if self.is_tree():
       return "Gambit extensive game '%s'" % self.GetTitle()
@@ -411,6 +539,24 @@ def ReadGame(x):
 %}
 };
 
+%extend Gambit::MixedStrategyProfile<double> {
+  // The address of the profile's storage, for as_array()
+  size_t GetDataAddress(void) { return (size_t) &(*self)[1]; }
+
+%pythoncode %{
+  def as_array(self):
+    """
+    Return a NumPy array of the probabilities, which shares storage
+    with the profile: changes to either are visible in the other.
+    The array keeps the profile alive.
+    """
+    import ctypes, numpy
+    data = (ctypes.c_double * len(self)).from_address(self.GetDataAddress())
+    data._profile = self
+    return numpy.frombuffer(data, dtype=float)
+%}
+};
+
 %template(MixedStrategyDouble) Gambit::MixedStrategyProfile<double>;
 %template(MixedStrategyRational) Gambit::MixedStrategyProfile<Gambit::Rational>;
 
@@ -453,6 +599,26 @@ public:
 %}
 };
 
+%extend Gambit::MixedBehavProfile<double> {
+  // The address of the profile's storage, for as_array()
+  size_t GetDataAddress(void) { return (size_t) &(*self)[1]; }
+
+%pythoncode %{
+  def as_array(self):
+    """
+    Return a NumPy array of the action probabilities, which shares
+    storage with the profile: changes to either are visible in the
+    other.  The array keeps the profile alive.  Call Invalidate()
+    after writing through the array, so that values computed from
+    the profile are recomputed.
+    """
+    import ctypes, numpy
+    data = (ctypes.c_double * len(self)).from_address(self.GetDataAddress())
+    data._profile = self
+    return numpy.frombuffer(data, dtype=float)
+%}
+};
+
 %template(MixedBehavDouble) Gambit::MixedBehavProfile<double>;
 %template(MixedBehavRational) Gambit::MixedBehavProfile<Gambit::Rational>;
 
@@ -496,3 +662,185 @@ public:
   %}
 }
     
+
+
+//========================================================================
+//                       Computing Nash equilibria
+//========================================================================
+
+//
+// The solvers shared with the command-line tools are compiled into the
+// extension and called directly, rather than by launching the tools and
+// parsing their output.  Each returns a Python list of the profiles it
+// finds.  The interpreter lock is released while a solver runs, so other
+// Python threads may proceed; they must not modify the game being solved
+// in the meantime.  If the solver throws, the lock is taken back before
+// the exception is passed on to be turned into a Python exception.
+//
+
+%{
+#include "libgambit/nash.h"
+#include "tools/enumpure/purenash.h"
+#include "tools/lcp/nfglcp.h"
+#include "tools/lp/nfglp.h"
+
+//
+// Collects the profiles reported by a solver
+//
+class ProfileCollector : public Gambit::NashObserver {
+public:
+  Gambit::List<Gambit::MixedStrategyProfile<double> > m_mixedDouble;
+  Gambit::List<Gambit::MixedStrategyProfile<Gambit::Rational> > m_mixedRational;
+  Gambit::List<Gambit::MixedBehavProfile<Gambit::Rational> > m_behavRational;
+
+  void OnProfile(const Gambit::MixedStrategyProfile<double> &p_profile)
+  { m_mixedDouble.Append(p_profile); }
+  void OnProfile(const Gambit::MixedStrategyProfile<Gambit::Rational> &p_profile)
+  { m_mixedRational.Append(p_profile); }
+  void OnProfile(const Gambit::MixedBehavProfile<Gambit::Rational> &p_profile)
+  { m_behavRational.Append(p_profile); }
+};
+
+Gambit::List<Gambit::MixedStrategyProfile<Gambit::Rational> > 
+EnumPureStrategy(const Gambit::Game &p_game)
+{
+  ProfileCollector observer;
+  p_game->BuildComputedValues();
+  Py_BEGIN_ALLOW_THREADS
+  try {
+    EnumPureStrategySolve(p_game, observer);
+  }
+  catch (...) {
+    Py_BLOCK_THREADS
+    throw;
+  }
+  Py_END_ALLOW_THREADS
+  return observer.m_mixedRational;
+}
+
+Gambit::List<Gambit::MixedBehavProfile<Gambit::Rational> > 
+EnumPureAgent(const Gambit::Game &p_game)
+{
+  ProfileCollector observer;
+  Py_BEGIN_ALLOW_THREADS
+  try {
+    EnumPureAgentSolve(p_game, observer);
+  }
+  catch (...) {
+    Py_BLOCK_THREADS
+    throw;
+  }
+  Py_END_ALLOW_THREADS
+  return observer.m_behavRational;
+}
+
+Gambit::List<Gambit::MixedStrategyProfile<double> > 
+LcpStrategyDouble(const Gambit::Game &p_game, int p_stopAfter, int p_maxDepth)
+{
+  if (p_game->NumPlayers() != 2) {
+    throw GameValueException("lcp requires a two-player game");
+  }
+  ProfileCollector observer;
+  p_game->BuildComputedValues();
+  Py_BEGIN_ALLOW_THREADS
+  try {
+    LcpStrategySolve<double>(p_game, p_stopAfter, p_maxDepth, observer);
+  }
+  catch (...) {
+    Py_BLOCK_THREADS
+    throw;
+  }
+  Py_END_ALLOW_THREADS
+  return observer.m_mixedDouble;
+}
+
+Gambit::List<Gambit::MixedStrategyProfile<Gambit::Rational> > 
+LcpStrategyRational(const Gambit::Game &p_game, int p_stopAfter, int p_maxDepth)
+{
+  if (p_game->NumPlayers() != 2) {
+    throw GameValueException("lcp requires a two-player game");
+  }
+  ProfileCollector observer;
+  p_game->BuildComputedValues();
+  Py_BEGIN_ALLOW_THREADS
+  try {
+    LcpStrategySolve<Gambit::Rational>(p_game, p_stopAfter, p_maxDepth,
+				       observer);
+  }
+  catch (...) {
+    Py_BLOCK_THREADS
+    throw;
+  }
+  Py_END_ALLOW_THREADS
+  return observer.m_mixedRational;
+}
+
+Gambit::List<Gambit::MixedStrategyProfile<double> > 
+LpStrategyDouble(const Gambit::Game &p_game)
+{
+  ProfileCollector observer;
+  p_game->BuildComputedValues();
+  if (p_game->NumPlayers() != 2 || !p_game->IsConstSum()) {
+    throw GameValueException("lp requires a two-player constant-sum game");
+  }
+  Py_BEGIN_ALLOW_THREADS
+  try {
+    LpStrategySolve<double>(p_game, observer);
+  }
+  catch (...) {
+    Py_BLOCK_THREADS
+    throw;
+  }
+  Py_END_ALLOW_THREADS
+  return observer.m_mixedDouble;
+}
+
+Gambit::List<Gambit::MixedStrategyProfile<Gambit::Rational> > 
+LpStrategyRational(const Gambit::Game &p_game)
+{
+  ProfileCollector observer;
+  p_game->BuildComputedValues();
+  if (p_game->NumPlayers() != 2 || !p_game->IsConstSum()) {
+    throw GameValueException("lp requires a two-player constant-sum game");
+  }
+  Py_BEGIN_ALLOW_THREADS
+  try {
+    LpStrategySolve<Gambit::Rational>(p_game, observer);
+  }
+  catch (...) {
+    Py_BLOCK_THREADS
+    throw;
+  }
+  Py_END_ALLOW_THREADS
+  return observer.m_mixedRational;
+}
+%}
+
+// Lists of profiles are returned to Python as lists of profile objects
+%define PROFILE_LIST_TYPEMAP(TYPE)
+%typemap(out) Gambit::List<TYPE > {
+  $result = PyList_New($1.Length());
+  for (int i = 1; i <= $1.Length(); i++) {
+    PyList_SetItem($result, i - 1,
+		   SWIG_NewPointerObj(new TYPE($1[i]), $descriptor(TYPE *),
+				      SWIG_POINTER_OWN));
+  }
+}
+%enddef
+
+PROFILE_LIST_TYPEMAP(Gambit::MixedStrategyProfile<double>)
+PROFILE_LIST_TYPEMAP(Gambit::MixedStrategyProfile<Gambit::Rational>)
+PROFILE_LIST_TYPEMAP(Gambit::MixedBehavProfile<Gambit::Rational>)
+
+Gambit::List<Gambit::MixedStrategyProfile<Gambit::Rational> > 
+EnumPureStrategy(const Gambit::Game &p_game);
+Gambit::List<Gambit::MixedBehavProfile<Gambit::Rational> > 
+EnumPureAgent(const Gambit::Game &p_game);
+Gambit::List<Gambit::MixedStrategyProfile<double> > 
+LcpStrategyDouble(const Gambit::Game &p_game, int p_stopAfter, int p_maxDepth);
+Gambit::List<Gambit::MixedStrategyProfile<Gambit::Rational> > 
+LcpStrategyRational(const Gambit::Game &p_game, int p_stopAfter, int p_maxDepth);
+Gambit::List<Gambit::MixedStrategyProfile<double> > 
+LpStrategyDouble(const Gambit::Game &p_game);
+Gambit::List<Gambit::MixedStrategyProfile<Gambit::Rational> > 
+LpStrategyRational(const Gambit::Game &p_game);
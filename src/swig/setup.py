@@ -18,7 +18,19 @@ libgambit_ext = Extension("gambit._libgambit",
                             "../libgambit/stratitr.cc",
                             "../libgambit/stratspt.cc",
                             "../libgambit/subgame.cc",
-                            "../libgambit/vector.cc" ],
+                            "../libgambit/vector.cc",
+                            "../liblinear/basis.cc",
+                            "../liblinear/btableau.cc",
+                            "../liblinear/lpdom.cc",
+                            "../liblinear/lpsolve.cc",
+                            "../liblinear/lptab.cc",
+                            "../liblinear/ludecomp.cc",
+                            "../liblinear/tableau.cc",
+                            "../tools/enumpure/purenash.cc",
+                            "../tools/lcp/lemketab.cc",
+                            "../tools/lcp/lhtab.cc",
+                            "../tools/lcp/nfglcp.cc",
+                            "../tools/lp/nfglp.cc" ],
                           include_dirs=[".."])
                           
 
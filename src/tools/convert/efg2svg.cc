@@ -0,0 +1,503 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2010, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/tools/convert/efg2svg.cc
+// Convert a Gambit .efg file to a drawing of the tree in SVG
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <cstdlib>
+#include <unistd.h>
+#include <iostream>
+#include <sstream>
+#include <map>
+
+#include "libgambit/libgambit.h"
+
+using namespace Gambit;
+
+//
+// The tree is laid out by the procedure the graphical interface uses
+// (gbtTreeLayout in src/gui/efglayout.cc) with its default style, which
+// is repeated here because that code is built on wxWidgets:
+//
+// * Terminal nodes are spaced evenly down the page, and each other node
+//   is centered on its first and last children.  Nodes are drawn as
+//   dots, joined to their children by a "fork" and a horizontal "tine",
+//   which carries the action label above and, for chance moves, the
+//   probability below.
+// * Each node is joined to the next member of its information set, in
+//   the order the nodes are visited, by a pair of vertical lines; if
+//   that member is at a different level, an arrow points towards it.
+//   The information sets at each level are given "sublevels", which
+//   push the nodes at that level and all deeper levels to the right.
+//   As in the graphical interface, terminal nodes, which have no
+//   information set, are chained together in the same way.
+//
+// What is not reproduced: there are no font metrics, so the widths of
+// labels (which place the payoffs of a terminal node after one another)
+// are estimated from their lengths; fractional payoffs are written as
+// "a/b" rather than stacked; and terminal nodes without an outcome get
+// no "(u)" hint.
+//
+// Everything drawn in one color goes into a few <path> elements, and
+// labels are grouped by color, so the size of the output is dominated
+// by the coordinates rather than by per-element markup.
+//
+
+int g_nodeSize = 10;
+int g_branchLength = 60;
+int g_tineLength = 20;
+int g_terminalSpacing = 50;
+const int c_leftMargin = 20;
+const int c_topMargin = 40;
+const int c_infosetSpacing = 40;
+const int c_fontSize = 10;
+const int c_payoffFontSize = 9;
+
+const char *s_playerColors[8] = {
+  "#ff0000", "#0000ff", "#008000", "#ff8000",
+  "#000040", "#8000ff", "#400000", "#ff80ff"
+};
+const char *s_chanceColor = "#9acd32";
+const char *s_terminalColor = "#000000";
+
+//
+// Primitives collected for one color
+//
+class SVGLayer {
+public:
+  std::ostringstream m_branches, m_dots, m_infosets, m_text;
+};
+
+class TreeDrawing {
+private:
+  Game m_efg;
+  // Entries are numbered in the order the nodes are visited, as in the
+  // node list of the graphical interface
+  Array<GameNode> m_nodes;
+  Array<int> m_entry;              // indexed by node number
+  Array<int> m_level, m_x, m_y, m_sublevel, m_nextMember;
+  Array<SVGLayer> m_layers;        // 1..n players, then chance, terminal
+  typedef std::pair<GameInfosetRep *, int> SublevelKey;
+  std::map<SublevelKey, int> m_sublevels;
+  Array<int> m_maxSublevel;        // indexed by level
+  int m_numEntries, m_maxLevel, m_maxX, m_maxY, m_nextY;
+
+  int ChanceLayer(void) const { return m_efg->NumPlayers() + 1; }
+  int TerminalLayer(void) const { return m_efg->NumPlayers() + 2; }
+  int NodeLayer(const GameNode &p_node) const;
+  const char *LayerColor(int p_layer) const;
+
+  void BuildNodeList(const GameNode &p_node, int p_level);
+  int LayoutSubtree(const GameNode &p_node);
+  void LayoutInfosets(void);
+  void AssignSublevels(const GameNode &p_node);
+  void Draw(int p_entry);
+  void DrawInfosetLink(int p_entry);
+
+  static std::string Escape(const std::string &);
+  static void Line(std::ostream &p_path, int x1, int y1, int x2, int y2)
+  { p_path << 'M' << x1 << ' ' << y1 << 'L' << x2 << ' ' << y2; }
+  static void Text(std::ostream &p_text, int x, int y,
+		   const std::string &p_label, bool p_center = false);
+
+public:
+  TreeDrawing(const Game &p_efg);
+
+  void Write(std::ostream &) const;
+};
+
+TreeDrawing::TreeDrawing(const Game &p_efg)
+  : m_efg(p_efg), m_layers(p_efg->NumPlayers() + 2),
+    m_numEntries(0), m_maxLevel(0), m_maxX(0), m_maxY(0),
+    m_nextY(c_topMargin)
+{
+  int numNodes = m_efg->NumNodes();
+  m_nodes = Array<GameNode>(numNodes);
+  m_entry = Array<int>(numNodes);
+  m_level = Array<int>(numNodes);
+  m_x = Array<int>(numNodes);
+  m_y = Array<int>(numNodes);
+  m_sublevel = Array<int>(numNodes);
+  m_nextMember = Array<int>(numNodes);
+
+  BuildNodeList(m_efg->GetRoot(), 0);
+  LayoutSubtree(m_efg->GetRoot());
+  LayoutInfosets();
+  for (int e = 1; e <= m_numEntries; e++) {
+    Draw(e);
+  }
+}
+
+int TreeDrawing::NodeLayer(const GameNode &p_node) const
+{
+  if (!p_node->GetPlayer())  return TerminalLayer();
+  if (p_node->GetPlayer()->IsChance())  return ChanceLayer();
+  return p_node->GetPlayer()->GetNumber();
+}
+
+const char *TreeDrawing::LayerColor(int p_layer) const
+{
+  if (p_layer == TerminalLayer())  return s_terminalColor;
+  if (p_layer == ChanceLayer())  return s_chanceColor;
+  return s_playerColors[(p_layer - 1) % 8];
+}
+
+void TreeDrawing::BuildNodeList(const GameNode &p_node, int p_level)
+{
+  int e = ++m_numEntries;
+  m_nodes[e] = p_node;
+  m_entry[p_node->GetNumber()] = e;
+  m_level[e] = p_level;
+  m_x[e] = c_leftMargin + p_level * (g_nodeSize + g_branchLength + g_tineLength);
+  m_maxLevel = std::max(m_maxLevel, p_level);
+  for (int i = 1; i <= p_node->NumChildren(); i++) {
+    BuildNodeList(p_node->GetChild(i), p_level + 1);
+  }
+}
+
+//
+// Returns the y coordinate of p_node, after laying out its subtree
+//
+int TreeDrawing::LayoutSubtree(const GameNode &p_node)
+{
+  int e = m_entry[p_node->GetNumber()];
+
+  if (p_node->NumChildren() == 0) {
+    m_y[e] = m_nextY;
+    m_nextY += g_terminalSpacing;
+  }
+  else {
+    int y1 = LayoutSubtree(p_node->GetChild(1));
+    int yn = y1;
+    for (int i = 2; i <= p_node->NumChildren(); i++) {
+      yn = LayoutSubtree(p_node->GetChild(i));
+    }
+    m_y[e] = (y1 + yn) / 2;
+  }
+
+  m_maxY = std::max(m_maxY, m_y[e]);
+  return m_y[e];
+}
+
+//
+// Finds the next member of each entry's information set, assigns the
+// sublevels, and moves the entries to the right to make room for them.
+// This follows gbtTreeLayout::Layout() and the functions it calls.
+//
+void TreeDrawing::LayoutInfosets(void)
+{
+  std::map<GameInfosetRep *, int> following;
+  for (int e = m_numEntries; e >= 1; e--) {
+    GameInfosetRep *infoset = m_nodes[e]->GetInfoset();
+    std::map<GameInfosetRep *, int>::iterator next = following.find(infoset);
+    m_nextMember[e] = (next != following.end()) ? next->second : 0;
+    m_sublevel[e] = 0;
+    following[infoset] = e;
+  }
+
+  m_sublevels.clear();
+  m_maxSublevel = Array<int>(0, m_maxLevel);
+  for (int i = 0; i <= m_maxLevel; m_maxSublevel[i++] = 0);
+  AssignSublevels(m_efg->GetRoot());
+
+  Array<int> nums(0, m_maxLevel + 1);
+  for (int i = 0; i <= m_maxLevel + 1; nums[i++] = 0);
+  for (int e = 1; e <= m_numEntries; e++) {
+    nums[m_level[e]] = std::max(m_sublevel[e] + 1, nums[m_level[e]]);
+  }
+  for (int i = 0; i <= m_maxLevel; i++) {
+    nums[i+1] += nums[i];
+  }
+
+  for (int e = 1; e <= m_numEntries; e++) {
+    if (m_level[e] != 0) {
+      m_x[e] += (nums[m_level[e] - 1] + m_sublevel[e]) * c_infosetSpacing;
+    }
+    m_maxX = std::max(m_maxX, m_x[e] + g_nodeSize);
+  }
+}
+
+//
+// Assigns the sublevels in the subtree rooted at p_node, considering
+// the children of each node before the node itself.  An information set
+// gets one sublevel on each level where it has a member which is
+// joined to a following member.
+//
+void TreeDrawing::AssignSublevels(const GameNode &p_node)
+{
+  for (int i = 1; i <= p_node->NumChildren(); i++) {
+    AssignSublevels(p_node->GetChild(i));
+  }
+
+  int e = m_entry[p_node->GetNumber()];
+  SublevelKey key(p_node->GetInfoset(), m_level[e]);
+  std::map<SublevelKey, int>::const_iterator sublevel = m_sublevels.find(key);
+  if (sublevel != m_sublevels.end()) {
+    m_sublevel[e] = sublevel->second;
+  }
+  else if (m_nextMember[e]) {
+    m_sublevel[e] = m_sublevels[key] = ++m_maxSublevel[m_level[e]];
+  }
+}
+
+void TreeDrawing::Draw(int p_entry)
+{
+  GameNode node = m_nodes[p_entry];
+  int x = m_x[p_entry], y = m_y[p_entry];
+  SVGLayer &layer = m_layers[NodeLayer(node)];
+
+  if (node->GetParent()) {
+    // The incoming branch is drawn in the color of the parent
+    GameNode parent = node->GetParent();
+    int p = m_entry[parent->GetNumber()];
+    SVGLayer &parentLayer = m_layers[NodeLayer(parent)];
+    int forkX = m_x[p] + g_nodeSize + g_branchLength;
+    Line(parentLayer.m_branches, m_x[p] + g_nodeSize, m_y[p], forkX, y);
+    Line(parentLayer.m_branches, forkX, y, x, y);
+
+    GameAction action = node->GetPriorAction();
+    Text(parentLayer.m_text, forkX + 3, y - 5, action->GetLabel());
+    if (parent->GetPlayer()->IsChance()) {
+      Text(parentLayer.m_text, forkX + 3, y + 3 + c_fontSize,
+	   parent->GetInfoset()->GetActionProb<std::string>(action->GetNumber()));
+    }
+  }
+
+  int r = g_nodeSize / 2;
+  layer.m_dots << 'M' << x << ' ' << y
+	       << 'a' << r << ' ' << r << " 0 1 0 " << g_nodeSize << " 0"
+	       << 'a' << r << ' ' << r << " 0 1 0 " << -g_nodeSize << " 0";
+
+  if (node->GetLabel() != "") {
+    Text(layer.m_text, x + r, y - 12, node->GetLabel(), true);
+  }
+
+  if (node->NumChildren() > 0) {
+    GameInfoset infoset = node->GetInfoset();
+    std::ostringstream iset;
+    if (infoset->GetPlayer()->IsChance()) {
+      iset << "C:" << infoset->GetNumber();
+    }
+    else {
+      iset << infoset->GetPlayer()->GetNumber() << ':' << infoset->GetNumber();
+    }
+    Text(layer.m_text, x + r, y + 9 + c_fontSize, iset.str(), true);
+    DrawInfosetLink(p_entry);
+    return;
+  }
+
+  GameOutcome outcome = node->GetOutcome();
+  if (outcome) {
+    // Payoffs are written to the right of the node, each in the
+    // color of its player
+    int px = x + g_nodeSize + 20;
+    for (int pl = 1; pl <= m_efg->NumPlayers(); pl++) {
+      std::string payoff = outcome->GetPayoff<std::string>(pl);
+      m_layers[pl].m_text << "<text x=\"" << px << "\" y=\""
+			  << y + c_payoffFontSize / 2 << "\" font-size=\""
+			  << c_payoffFontSize << "pt\">"
+			  << Escape(payoff) << "</text>\n";
+      px += payoff.length() * c_payoffFontSize * 2 / 3 + 10;
+    }
+    m_maxX = std::max(m_maxX, px);
+  }
+}
+
+//
+// Draws the lines joining an entry to the next member of its
+// information set
+//
+void TreeDrawing::DrawInfosetLink(int p_entry)
+{
+  int next = m_nextMember[p_entry];
+  if (!next)  return;
+
+  std::ostream &path = m_layers[NodeLayer(m_nodes[p_entry])].m_infosets;
+  int x = m_x[p_entry], y = m_y[p_entry];
+  int nextX = m_x[next], nextY = m_y[next];
+  Line(path, x, y, x, nextY);
+  Line(path, x + g_nodeSize, y, x + g_nodeSize, nextY);
+
+  if (nextX != x) {
+    // A little arrow in the direction of the next member
+    int startX, endX;
+    if (nextX < x) {
+      startX = x + g_nodeSize;
+      endX = x - c_infosetSpacing;
+    }
+    else {
+      startX = x;
+      endX = x + g_nodeSize + c_infosetSpacing;
+    }
+    int head = (startX > endX) ? c_infosetSpacing / 2 : -c_infosetSpacing / 2;
+    Line(path, startX, nextY, endX, nextY);
+    Line(path, endX, nextY, endX + head, nextY + c_infosetSpacing / 2);
+    Line(path, endX, nextY, endX + head, nextY - c_infosetSpacing / 2);
+  }
+}
+
+std::string TreeDrawing::Escape(const std::string &p_text)
+{
+  std::string ret;
+  for (unsigned int i = 0; i < p_text.length(); i++) {
+    switch (p_text[i]) {
+    case '&':  ret += "&amp;";  break;
+    case '<':  ret += "&lt;";  break;
+    case '>':  ret += "&gt;";  break;
+    case '"':  ret += "&quot;";  break;
+    default:   ret += p_text[i];  break;
+    }
+  }
+  return ret;
+}
+
+//
+// Writes a label with its baseline at y, starting at x, or centered on
+// x if p_center is true
+//
+void TreeDrawing::Text(std::ostream &p_text, int x, int y,
+		       const std::string &p_label, bool p_center)
+{
+  p_text << "<text x=\"" << x << "\" y=\"" << y << "\"";
+  if (p_center) {
+    p_text << " text-anchor=\"middle\"";
+  }
+  p_text << ">" << Escape(p_label) << "</text>\n";
+}
+
+void TreeDrawing::Write(std::ostream &p_file) const
+{
+  int width = m_maxX + c_leftMargin, height = m_maxY + c_topMargin;
+
+  p_file << "<?xml version=\"1.0\" standalone=\"no\"?>\n";
+  p_file << "<svg xmlns=\"http://www.w3.org/2000/svg\" version=\"1.1\" ";
+  p_file << "width=\"" << width << "\" height=\"" << height << "\" ";
+  p_file << "viewBox=\"0 0 " << width << ' ' << height << "\">\n";
+  p_file << "<title>" << Escape(m_efg->GetTitle()) << "</title>\n";
+  p_file << "<rect width=\"100%\" height=\"100%\" fill=\"#ffffff\"/>\n";
+
+  for (int i = 1; i <= m_layers.Length(); i++) {
+    const char *color = LayerColor(i);
+    const SVGLayer &layer = m_layers[i];
+    std::string branches = layer.m_branches.str();
+    std::string infosets = layer.m_infosets.str();
+    std::string dots = layer.m_dots.str();
+    p_file << "<g stroke=\"" << color << "\" fill=\"none\">\n";
+    if (branches != "") {
+      p_file << "<path stroke-width=\"4\" d=\"" << branches << "\"/>\n";
+    }
+    if (infosets != "") {
+      p_file << "<path stroke-width=\"1\" stroke-dasharray=\"1,2\" d=\""
+	     << infosets << "\"/>\n";
+    }
+    if (dots != "") {
+      p_file << "<path stroke-width=\"3\" fill=\"" << color << "\" d=\""
+	     << dots << "\"/>\n";
+    }
+    p_file << "</g>\n";
+    p_file << "<g fill=\"" << color << "\" ";
+    p_file << "font-family=\"sans-serif\" font-weight=\"bold\" ";
+    p_file << "font-size=\"" << c_fontSize << "pt\">\n";
+    p_file << layer.m_text.str();
+    p_file << "</g>\n";
+  }
+
+  p_file << "</svg>\n";
+}
+
+void PrintBanner(std::ostream &p_stream)
+{
+  p_stream << "Convert a Gambit .efg file to a drawing of the tree in SVG\n";
+  p_stream << "Gambit version " VERSION ", Copyright (C) 1994-2010, The Gambit Project\n";
+  p_stream << "This is free software, distributed under the GNU GPL\n\n";
+}
+
+void PrintHelp(char *progname)
+{
+  PrintBanner(std::cerr);
+  std::cerr << "Usage: " << progname << " [OPTIONS]\n";
+  std::cerr << "Accepts extensive game on standard input.\n";
+  std::cerr << "Writes a drawing of the game tree in SVG to standard output\n\n";
+
+  std::cerr << "Options:\n";
+  std::cerr << "  -b LENGTH        length of branches (default is 60)\n";
+  std::cerr << "  -s SPACING       vertical spacing of terminal nodes (default is 50)\n";
+  std::cerr << "  -h               print this help message\n";
+  std::cerr << "  -q               quiet mode (suppresses banner)\n";
+  exit(1);
+}
+
+int main(int argc, char *argv[])
+{
+  int c;
+  bool quiet = false;
+
+  while ((c = getopt(argc, argv, "b:s:hq")) != -1) {
+    switch (c) {
+    case 'b':
+      g_branchLength = atoi(optarg);
+      break;
+    case 's':
+      g_terminalSpacing = atoi(optarg);
+      break;
+    case 'q':
+      quiet = true;
+      break;
+    case 'h':
+      PrintHelp(argv[0]);
+      break;
+    case '?':
+      if (isprint(optopt)) {
+	std::cerr << argv[0] << ": Unknown option `-" << ((char) optopt) << "'.\n";
+      }
+      else {
+	std::cerr << argv[0] << ": Unknown option character `\\x" << optopt << "`.\n";
+      }
+      return 1;
+    default:
+      abort();
+    }
+  }
+
+  if (!quiet) {
+    PrintBanner(std::cerr);
+  }
+
+  Game efg;
+
+  try {
+    efg = ReadGame(std::cin);
+  }
+  catch (InvalidFileException) {
+    std::cerr << "Error: Game not in a recognized format.\n";
+    return 1;
+  }
+  catch (...) {
+    std::cerr << "Error: An internal error occurred.\n";
+    return 1;
+  }
+
+  if (!efg->IsTree()) {
+    std::cerr << argv[0] << ": Game does not have a tree representation.\n";
+    return 1;
+  }
+
+  TreeDrawing(efg).Write(std::cout);
+  return 0;
+}
@@ -21,11 +21,15 @@
 //
 
 #include <cstdlib>
+#include <climits>
 #include <unistd.h>
 #include <iostream>
 #include <iomanip>
+#include <sstream>
 
 #include "libgambit/libgambit.h"
+#include "liblinear/lpdom.h"
+#include "tools/workers/workers.h"
 #include "clique.h"
 #include "vertenum.imp"
 
@@ -34,6 +38,7 @@ using namespace Gambit;
 
 bool g_showConnect = false;
 int g_numDecimals = 6;
+int g_numWorkers = 1;
 
 bool EqZero(const double &x)
 {
@@ -133,7 +138,194 @@ template <class T> void GetCliques(std::ostream &p_stream,
   }
 }
 
-template <class T> void Solve(const StrategySupport &p_support)
+//
+// Vertices are passed back from worker processes as text, listing for
+// each the labels in its basis and their values.  Doubles are written
+// with enough digits to be read back exactly.
+//
+void WriteValue(std::ostream &p_stream, const double &p_value)
+{
+  p_stream << std::setprecision(17) << p_value;
+}
+
+void WriteValue(std::ostream &p_stream, const Rational &p_value)
+{
+  p_stream << p_value;
+}
+
+template <class T> void WriteVertices(std::ostream &p_stream,
+				      const List<BFS<T> > &p_verts,
+				      int p_numRows, int p_numColumns)
+{
+  List<BFS<T> > verts(p_verts);
+  p_stream << verts.Length() << std::endl;
+  for (int i = 1; i <= verts.Length(); i++) {
+    BFS<T> &bfs = verts[i];
+    int count = 0;
+    for (int k = -p_numRows; k <= p_numColumns; k++) {
+      count += bfs.count(k);
+    }
+    p_stream << count;
+    for (int k = -p_numRows; k <= p_numColumns; k++) {
+      if (bfs.count(k)) {
+	p_stream << ' ' << k << ' ';
+	WriteValue(p_stream, bfs[k]);
+      }
+    }
+    p_stream << std::endl;
+  }
+}
+
+template <class T> void ReadVertices(std::istream &p_stream, 
+				     List<BFS<T> > &p_verts)
+{
+  int numVerts;
+  p_stream >> numVerts;
+  for (int i = 1; i <= numVerts; i++) {
+    BFS<T> bfs;
+    int count;
+    p_stream >> count;
+    for (int j = 1; j <= count; j++) {
+      int k;
+      T value;
+      p_stream >> k >> value;
+      bfs.insert(k, value);
+    }
+    p_verts.Append(bfs);
+  }
+}
+
+//
+// The reverse search on each of the two polytopes splits up into one
+// subtree per reverse pivot from the starting vertex.  Tasks 1 through
+// m_numBranches1 are the subtrees of the first polytope, and the
+// remaining ones those of the second.
+//
+template <class T> class VertexTask : public IndexedTask {
+private:
+  const Matrix<T> &m_A1, &m_A2;
+  const Vector<T> &m_b1, &m_b2;
+  int m_numBranches1;
+
+public:
+  VertexTask(const Matrix<T> &p_A1, const Vector<T> &p_b1, int p_numBranches1,
+	     const Matrix<T> &p_A2, const Vector<T> &p_b2)
+    : m_A1(p_A1), m_A2(p_A2), m_b1(p_b1), m_b2(p_b2), 
+      m_numBranches1(p_numBranches1) { }
+  virtual ~VertexTask() { }
+
+  void Run(int p_index, std::ostream &p_stream);
+};
+
+template <class T> 
+void VertexTask<T>::Run(int p_index, std::ostream &p_stream)
+{
+  const Matrix<T> &A = (p_index <= m_numBranches1) ? m_A1 : m_A2;
+  const Vector<T> &b = (p_index <= m_numBranches1) ? m_b1 : m_b2;
+  int branch = (p_index <= m_numBranches1) ? p_index : p_index - m_numBranches1;
+
+  VertEnum<T> poly(A, b, branch);
+  WriteVertices(p_stream, poly.VertexList(), A.NumRows(), A.NumColumns());
+}
+
+template <class T> void CopyVertices(const List<BFS<T> > &p_list,
+				     Array<BFS<T> > &p_verts)
+{
+  List<BFS<T> > list(p_list);
+  p_verts = Array<BFS<T> >(list.Length());
+  for (int i = 1; i <= list.Length(); i++) {
+    p_verts[i] = list[i];
+  }
+}
+
+//
+// Enumerates the vertices of A1 x + b1 <= 0 and A2 x + b2 <= 0.
+// The list of vertices is the same regardless of the number of workers.
+//
+template <class T> void EnumerateVertices(const Matrix<T> &p_A1, 
+					  const Vector<T> &p_b1,
+					  const Matrix<T> &p_A2,
+					  const Vector<T> &p_b2,
+					  Array<BFS<T> > &p_verts1,
+					  Array<BFS<T> > &p_verts2)
+{
+  if (g_numWorkers <= 1) {
+    VertEnum<T> poly1(p_A1, p_b1);
+    VertEnum<T> poly2(p_A2, p_b2);
+    CopyVertices(poly1.VertexList(), p_verts1);
+    CopyVertices(poly2.VertexList(), p_verts2);
+    return;
+  }
+
+  VertEnum<T> root1(p_A1, p_b1, 0);
+  VertEnum<T> root2(p_A2, p_b2, 0);
+  int numBranches1 = root1.NumRootBranches();
+  int numBranches2 = root2.NumRootBranches();
+
+  VertexTask<T> task(p_A1, p_b1, numBranches1, p_A2, p_b2);
+  std::stringstream stream;
+  RunWorkers(task, numBranches1 + numBranches2, g_numWorkers, stream, true);
+
+  List<BFS<T> > verts1(root1.VertexList()), verts2(root2.VertexList());
+  for (int i = 1; i <= numBranches1; i++) {
+    ReadVertices(stream, verts1);
+  }
+  for (int i = 1; i <= numBranches2; i++) {
+    ReadVertices(stream, verts2);
+  }
+  CopyVertices(verts1, p_verts1);
+  CopyVertices(verts2, p_verts2);
+}
+
+//
+// A set of vertices, as a bit vector, used to index the vertices
+// of a polytope by the labels in their bases.
+//
+class VertexSet {
+private:
+  static const int c_wordBits = sizeof(unsigned long) * CHAR_BIT;
+  Array<unsigned long> m_bits;
+
+public:
+  VertexSet(int p_size = 0) : m_bits(p_size / c_wordBits + 1)
+  { for (int w = 1; w <= m_bits.Length(); m_bits[w++] = 0); }
+
+  void Insert(int i)
+  { m_bits[i / c_wordBits + 1] |= (1ul << (i % c_wordBits)); }
+  void Remove(const VertexSet &p_set)
+  { for (int w = 1; w <= m_bits.Length(); w++) m_bits[w] &= ~p_set.m_bits[w]; }
+
+  /// Returns the smallest member greater than i, or zero if none
+  int Next(int i) const
+  {
+    for (i++; i / c_wordBits < m_bits.Length(); i++) {
+      unsigned long word = m_bits[i / c_wordBits + 1] >> (i % c_wordBits);
+      if (word == 0) {
+	i += c_wordBits - i % c_wordBits - 1;
+      }
+      else if (word & 1ul) {
+	return i;
+      }
+    }
+    return 0;
+  }
+};
+
+//
+// A label whose value passes this test cannot be complementary to
+// any other label which passes it, since their product is then nonzero.
+//
+template <class T> bool IsCertainlyNonZero(const T &x)
+{
+  return !EqZero(x * x);
+}
+
+//
+// Enumerates the extreme equilibria.  These are printed as they are
+// found, or, if p_equilibria is given, appended to it instead.
+//
+template <class T> void Solve(const StrategySupport &p_support,
+			      List<MixedStrategyProfile<T> > *p_equilibria = 0)
 {
   List<Vector<T> > key1, key2;  
   List<int> node1, node2;   // IDs of each component of the extreme equilibria
@@ -175,28 +367,56 @@ template <class T> void Solve(const StrategySupport &p_support)
   b2 = (T) -1;
 
   // enumerate vertices of A1 x + b1 <= 0 and A2 x + b2 <= 0
-  VertEnum<T> poly1(A1, b1);
-  VertEnum<T> poly2(A2, b2);
-
-  const List<BFS<T> > &verts1(poly1.VertexList());
-  const List<BFS<T> > &verts2(poly2.VertexList());
+  Array<BFS<T> > verts1, verts2;
+  EnumerateVertices(A1, b1, A2, b2, verts1, verts2);
   int v1 = verts1.Length();
   int v2 = verts2.Length();
 
+  // Index the vertices of the first polytope by the labels they carry,
+  // so that for each vertex of the second polytope the vertices which
+  // cannot be complementary to it are ruled out a word at a time.
+  // Only pairs surviving this go on to the complementarity check below.
+  int n1 = p_support.NumStrategies(1), n2 = p_support.NumStrategies(2);
+  Array<VertexSet> slack1(n1), strat2(n2);
+  for (int k = 1; k <= n1; slack1[k++] = VertexSet(v1));
+  for (int k = 1; k <= n2; strat2[k++] = VertexSet(v1));
+  VertexSet all(v1);
+  for (int i1 = 2; i1 <= v1; i1++) {
+    BFS<T> &bfs2 = verts1[i1];
+    all.Insert(i1);
+    for (int k = 1; k <= n1; k++) {
+      if (bfs2.count(-k) && IsCertainlyNonZero(bfs2[-k]))  slack1[k].Insert(i1);
+    }
+    for (int k = 1; k <= n2; k++) {
+      if (bfs2.count(k) && IsCertainlyNonZero(bfs2[k]))  strat2[k].Insert(i1);
+    }
+  }
+
   Array<int> vert1id(v1);
   Array<int> vert2id(v2);
   for (int i = 1; i <= vert1id.Length(); vert1id[i++] = 0);
   for (int i = 1; i <= vert2id.Length(); vert2id[i++] = 0);
 
-  int i = 0;
   int id1 = 0, id2 = 0;
 
   try {
     for (int i2 = 2; i2 <= v2; i2++) {
-      BFS<T> bfs1 = verts2[i2];
-      i++;
-      for (int i1 = 2; i1 <= v1; i1++) {
-	BFS<T> bfs2 = verts1[i1];
+      BFS<T> &bfs1 = verts2[i2];
+
+      VertexSet candidates(all);
+      for (int k = 1; k <= n1; k++) {
+	if (bfs1.count(k) && IsCertainlyNonZero(bfs1[k])) {
+	  candidates.Remove(slack1[k]);
+	}
+      }
+      for (int k = 1; k <= n2; k++) {
+	if (bfs1.count(-k) && IsCertainlyNonZero(bfs1[-k])) {
+	  candidates.Remove(strat2[k]);
+	}
+      }
+
+      for (int i1 = candidates.Next(1); i1 > 0; i1 = candidates.Next(i1)) {
+	BFS<T> &bfs2 = verts1[i1];
 	
 	// check if solution is nash 
 	// need only check complementarity, since it is feasible
@@ -245,6 +465,10 @@ template <class T> void Solve(const StrategySupport &p_support)
 	    }
 	  }
 
+	  if (p_equilibria) {
+	    p_equilibria->Append(profile);
+	    continue;
+	  }
 	  PrintProfile(std::cout, "NE", profile.ToFullSupport());
 	  
 	  // note: The keys give the mixed strategy associated with each node. 
@@ -278,7 +502,7 @@ template <class T> void Solve(const StrategySupport &p_support)
 	}
       }
     }
-    if (g_showConnect) {
+    if (g_showConnect && !p_equilibria) {
       GetCliques(std::cout, p_support, node1, key1, v1, node2, key2, v2);
     }
   }
@@ -287,7 +511,66 @@ template <class T> void Solve(const StrategySupport &p_support)
   }
 }
 
-extern void LrsSolve(const StrategySupport &);
+extern bool LrsSolve(const StrategySupport &, 
+		     List<MixedStrategyProfile<Rational> > &);
+
+//
+// Reports the equilibria found by lrs.  For connectedness information,
+// each distinct strategy of a player in these equilibria is treated as
+// one vertex of that player's polytope.
+//
+template <class T> void ReportLrs(const StrategySupport &p_support,
+				  const List<MixedStrategyProfile<Rational> > &p_equilibria)
+{
+  List<Vector<T> > key1, key2;  
+  List<int> node1, node2;
+
+  for (int i = 1; i <= p_equilibria.Length(); i++) {
+    MixedStrategyProfile<T> profile(p_support);
+    for (int j = 1; j <= profile.Length(); j++) {
+      profile[j] = (T) p_equilibria[i][j];
+    }
+    PrintProfile(std::cout, "NE", profile.ToFullSupport());
+
+    Vector<T> probs1(p_support.NumStrategies(1));
+    for (int j = 1; j <= probs1.Length(); j++) {
+      probs1[j] = profile[p_support.GetStrategy(1, j)];
+    }
+    Vector<T> probs2(p_support.NumStrategies(2));
+    for (int j = 1; j <= probs2.Length(); j++) {
+      probs2[j] = profile[p_support.GetStrategy(2, j)];
+    }
+    if (!key1.Contains(probs1))  key1.Append(probs1);
+    if (!key2.Contains(probs2))  key2.Append(probs2);
+    node1.Append(key1.Find(probs1));
+    node2.Append(key2.Find(probs2));
+  }
+
+  if (g_showConnect) {
+    GetCliques(std::cout, p_support, node1, key1, key2.Length(),
+	       node2, key2, key1.Length());
+  }
+}
+
+//
+// Carries out iterative elimination of strictly dominated strategies.
+// Dominance by pure strategies is checked first, since it is much
+// cheaper; dominance by mixed strategies is only checked once no
+// strategy is dominated by a pure strategy.
+//
+template <class T> StrategySupport Eliminate(const StrategySupport &p_support)
+{
+  StrategySupport support(p_support);
+
+  while (true) {
+    StrategyEliminator eliminator(support, true);
+    eliminator.Run();
+    StrategySupport newSupport = UndominatedMixed<T>(eliminator.GetSupport(),
+						     true);
+    if (newSupport == eliminator.GetSupport())  return newSupport;
+    support = newSupport;
+  }
+}
 
 void PrintBanner(std::ostream &p_stream)
 {
@@ -310,6 +593,9 @@ void PrintHelp(char *progname)
   std::cerr << "                   display results with DECIMALS digits\n";
   std::cerr << "  -D               don't eliminate dominated strategies first\n";
   std::cerr << "  -L               use lrslib for enumeration (experimental!)\n";
+  std::cerr << "  -V               use Gambit's own vertex enumeration (default)\n";
+  std::cerr << "  -j PROCESSES     run Gambit's own enumeration in PROCESSES\n";
+  std::cerr << "                   processes; cannot be used with -L\n";
   std::cerr << "  -c               output connectedness information\n";
   std::cerr << "  -h               print this help message\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
@@ -321,7 +607,7 @@ int main(int argc, char *argv[])
   int c;
   bool useFloat = false, uselrs = false, quiet = false, eliminate = true;
 
-  while ((c = getopt(argc, argv, "d:DhqcS")) != -1) {
+  while ((c = getopt(argc, argv, "d:DhqcLVSj:")) != -1) {
     switch (c) {
     case 'd':
       useFloat = true;
@@ -333,6 +619,16 @@ int main(int argc, char *argv[])
     case 'L':
       uselrs = true;
       break;
+    case 'V':
+      uselrs = false;
+      break;
+    case 'j':
+      g_numWorkers = atoi(optarg);
+      if (g_numWorkers < 1) {
+	std::cerr << argv[0] << ": Number of processes must be at least one.\n";
+	return 1;
+      }
+      break;
     case 'h':
       PrintHelp(argv[0]);
       break;
@@ -357,6 +653,11 @@ int main(int argc, char *argv[])
     }
   }
 
+  if (uselrs && g_numWorkers > 1) {
+    std::cerr << argv[0] << ": -L cannot be used with more than one process.\n";
+    return 1;
+  }
+
   if (!quiet) {
     PrintBanner(std::cerr);
   }
@@ -373,17 +674,42 @@ int main(int argc, char *argv[])
 
     StrategySupport support(game);
     if (eliminate) {
-      while (true) {
-	StrategySupport newSupport = support.Undominated(true);
-	if (newSupport == support) break;
-	support = newSupport;
-      }
+      support = (useFloat) ? Eliminate<double>(support) : 
+	Eliminate<Rational>(support);
     }
 
     if (uselrs) {
-      LrsSolve(support);
+      try {
+	List<MixedStrategyProfile<Rational> > equilibria, check;
+	// lrslib misses extreme equilibria of some degenerate games, and
+	// does not always say so.  Its result is therefore only reported
+	// if it contains every equilibrium found by our own enumeration;
+	// otherwise, our own enumeration is reported.
+	if (LrsSolve(support, equilibria)) {
+	  Solve<Rational>(support, &check);
+	  bool complete = (check.Length() > 0);
+	  for (int i = 1; complete && i <= check.Length(); i++) {
+	    complete = equilibria.Contains(check[i]);
+	  }
+	  if (complete) {
+	    if (useFloat) {
+	      ReportLrs<double>(support, equilibria);
+	    }
+	    else {
+	      ReportLrs<Rational>(support, equilibria);
+	    }
+	    return 0;
+	  }
+	}
+	std::cerr << "Warning: lrslib did not find all equilibria; ";
+	std::cerr << "using Gambit's own enumeration instead.\n";
+      }
+      catch (ValueException) {
+	// Payoffs cannot be passed to lrslib; fall back on our own
+      }
     }
-    else if (useFloat) {
+
+    if (useFloat) {
       Solve<double>(support);
     }
     else {
@@ -525,7 +525,8 @@ lrs_init (const char *name)       /* returns TRUE if successful, else FALSE */
   printf (",");
   printf (ARITH);
 #endif  // UNUSED_BY_GAMBIT
-  if (!lrs_mp_init (ZERO, stdin, stdout))  /* initialize arithmetic */
+  /* Gambit writes equilibria to stdout; keep any lrs messages apart */
+  if (!lrs_mp_init (ZERO, stdin, stderr))  /* initialize arithmetic */
     return FALSE;
   //printf (")");
 
@@ -561,8 +562,9 @@ lrs_close (const char *name)
 #endif
 
   //fprintf (lrs_ofp, "\n");
-  fclose (lrs_ifp);
-  if (lrs_ofp != stdout)
+  if (lrs_ifp != stdin)
+    fclose (lrs_ifp);
+  if (lrs_ofp != stdout && lrs_ofp != stderr)
     fclose (lrs_ofp);
 }
 
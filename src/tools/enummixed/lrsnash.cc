@@ -39,6 +39,8 @@
 #include <iostream>
 #include <cstdio>
 #include <cstring>
+#include <string>
+#include <vector>
 
 // The order of these next includes is important, because of macro definitions
 #include "libgambit/libgambit.h"
@@ -66,8 +68,7 @@ extern "C" {
 void FillNonnegativityRows(lrs_dic *P, lrs_dat *Q, 
 			   int firstRow, int lastRow, int n)
 {
-  const int MAXCOL = 1000;     /* maximum number of columns */
-  long num[MAXCOL], den[MAXCOL];
+  std::vector<long> num(n), den(n);
 
   for (long row = firstRow; row <= lastRow; row++) {
     num[0] = 0;
@@ -78,7 +79,7 @@ void FillNonnegativityRows(lrs_dic *P, lrs_dat *Q,
       den[col] = 1;
     }
 
-    lrs_set_row(P, Q, row, num, den, GE);
+    lrs_set_row(P, Q, row, &num[0], &den[0], GE);
   }
 }
 
@@ -86,8 +87,8 @@ void FillConstraintRows(lrs_dic *P, lrs_dat *Q,
 			const StrategySupport &p_support,
 			int p1, int p2, int firstRow)
 {
-  const int MAXCOL = 1000;     /* maximum number of columns */
-  long num[MAXCOL], den[MAXCOL];
+  std::vector<long> num(p_support.NumStrategies(p2) + 2);
+  std::vector<long> den(p_support.NumStrategies(p2) + 2);
 
   Game game = p_support.GetGame();
   Rational min = game->GetMinPayoff() - Rational(1);
@@ -110,14 +111,13 @@ void FillConstraintRows(lrs_dic *P, lrs_dat *Q,
 
     num[p_support.NumStrategies(p2)+1] = 1;
     den[p_support.NumStrategies(p2)+1] = 1;
-    lrs_set_row(P, Q, row, num, den, GE);
+    lrs_set_row(P, Q, row, &num[0], &den[0], GE);
   }
 }
 
 void FillLinearityRow(lrs_dic *P, lrs_dat *Q, int m, int n)
 {
-  const int MAXCOL = 1000;     /* maximum number of columns */
-  long num[MAXCOL], den[MAXCOL];
+  std::vector<long> num(n), den(n);
 
   num[0] = -1;
   den[0] = 1;
@@ -130,7 +130,33 @@ void FillLinearityRow(lrs_dic *P, lrs_dat *Q, int m, int n)
   num[n-1] = 0;
   den[n-1] = 1;
 
-  lrs_set_row(P, Q, m, num, den, EQ);
+  lrs_set_row(P, Q, m, &num[0], &den[0], EQ);
+}
+
+//
+// The payoffs are handed to lrs as fractions of machine integers;
+// lrs itself then computes in arbitrary precision.  This checks
+// whether all of them fit.
+//
+bool PayoffsFit(const StrategySupport &p_support)
+{
+  Game game = p_support.GetGame();
+  Rational min = game->GetMinPayoff() - Rational(1);
+  PureStrategyProfile cont(game);
+
+  for (int i = 1; i <= p_support.NumStrategies(1); i++) {
+    cont.SetStrategy(p_support.GetStrategy(1, i));
+    for (int j = 1; j <= p_support.NumStrategies(2); j++) {
+      cont.SetStrategy(p_support.GetStrategy(2, j));
+      for (int pl = 1; pl <= 2; pl++) {
+	Rational x = cont.GetPayoff<Rational>(pl) - min;
+	if (!x.numerator().fits_in_long() || !x.denominator().fits_in_long()) {
+	  return false;
+	}
+      }
+    }
+  }
+  return true;
 }
 
 //
@@ -163,7 +189,9 @@ void BuildRep(lrs_dic *P, lrs_dat *Q, const StrategySupport &p_support,
 long nash2_main (lrs_dic *P1, lrs_dat *Q1, lrs_dic *P2orig,
 		 lrs_dat *Q2, long *numequilib, 
 		 lrs_mp_vector output1, lrs_mp_vector output2,
-		 const StrategySupport &p_support);
+		 const StrategySupport &p_support,
+		 List<MixedStrategyProfile<Rational> > &p_equilibria,
+		 bool &p_complete);
 
 long lrs_getfirstbasis2 (lrs_dic ** D_p, lrs_dat * Q, lrs_dic *P2orig,
 			 lrs_mp_matrix * Lin, long no_output);
@@ -171,17 +199,24 @@ long lrs_getfirstbasis2 (lrs_dic ** D_p, lrs_dat * Q, lrs_dic *P2orig,
 long getabasis2 (lrs_dic * P, lrs_dat * Q, lrs_dic * P2orig, long order[]);
 
 // This is a modified version of lrs_output from the original, in which
-// we output the equilibria found in Gambit format.
+// we collect the equilibria found as Gambit profiles.
 void nashoutput(lrs_dat *Q1, lrs_mp_vector output1,
 		lrs_dat *Q2, lrs_mp_vector output2,
-		const StrategySupport &p_support);
+		const StrategySupport &p_support,
+		List<MixedStrategyProfile<Rational> > &p_equilibria);
 
 
 
 //
 // This is the main function, based on main() from lrslib's 'nash' driver.
+// The equilibria found are appended to p_equilibria, as profiles on
+// p_support.  Throws a ValueException if the payoffs cannot be
+// passed to lrs.  Returns false if lrs warned that its output may be
+// incomplete (a dual degenerate or unbounded starting dictionary), or
+// if the problem could not be set up at all.
 //
-void LrsSolve(const StrategySupport &p_support)
+bool LrsSolve(const StrategySupport &p_support,
+	      List<MixedStrategyProfile<Rational> > &p_equilibria)
 {
   lrs_dic *P1,*P2; /* structure for holding current dictionary and indices */
   lrs_dat *Q1,*Q2; /* structure for holding static problem data            */
@@ -197,9 +232,14 @@ void LrsSolve(const StrategySupport &p_support)
   long prune = FALSE;		/* if TRUE, getnextbasis will prune tree and backtrack  */
   long numequilib=0;            /* number of nash equilibria found                      */
   long oldnum=0;                                                                            
+  bool complete = true;
 /* global variables lrs_ifp and lrs_ofp are file pointers for input and output   */
 /* they default to stdin and stdout, but may be overidden by command line parms. */
 
+  if (!PayoffsFit(p_support)) {
+    throw ValueException();
+  }
+
 /***************************************************
  Step 0: 
   Do some global initialization that should only be done once,
@@ -208,7 +248,7 @@ void LrsSolve(const StrategySupport &p_support)
 ***************************************************/
 
   if (!lrs_init("")) {
-    return;
+    return false;
   }
 
 /*********************************************************************************/
@@ -218,7 +258,7 @@ void LrsSolve(const StrategySupport &p_support)
 
   Q1 = lrs_alloc_dat ("LRS globals");	/* allocate and init structure for static problem data */
   if (Q1 == NULL) {
-    return;
+    return false;
   }
 
   Q1->nash=TRUE;
@@ -227,7 +267,7 @@ void LrsSolve(const StrategySupport &p_support)
 
   P1 = lrs_alloc_dic (Q1);	/* allocate and initialize lrs_dic */
   if (P1 == NULL) {
-    return;
+    return false;
   }
 
   BuildRep(P1, Q1, p_support, 2, 1);
@@ -237,7 +277,7 @@ void LrsSolve(const StrategySupport &p_support)
   /* allocate and init structure for player 2's problem data */
   Q2 = lrs_alloc_dat ("LRS globals"); 
   if (Q2 == NULL) {
-    return;
+    return false;
   }
 
   Q2->nash=TRUE;
@@ -246,7 +286,7 @@ void LrsSolve(const StrategySupport &p_support)
 
   P2 = lrs_alloc_dic (Q2);	/* allocate and initialize lrs_dic */
   if (P2 == NULL) {
-    return;
+    return false;
   }
   BuildRep(P2, Q2, p_support, 1, 2);
 
@@ -254,7 +294,7 @@ void LrsSolve(const StrategySupport &p_support)
 
   P2orig = lrs_getdic(Q2);  	     /* allocate and initialize lrs_dic                     */
   if (P2orig == NULL)
-    return;
+    return false;
   copy_dict(Q2,P2orig,P2);
 
 /*********************************************************************************/
@@ -265,18 +305,18 @@ void LrsSolve(const StrategySupport &p_support)
 /*********************************************************************************/
 
   if (!lrs_getfirstbasis (&P1, Q1, &Lin, TRUE))
-    return;
+    return false;
 
   if (Q1->dualdeg)
      {
-      printf("\n*Warning! Dual degenerate, ouput may be incomplete");
-      printf("\n*Recommendation: Add dualperturb option before maximize in first input file\n");
+      complete = false;
+      fprintf(stderr, "Warning: Dual degenerate, output may be incomplete\n");
      }
 
   if (Q1->unbounded)
      {
-      printf("\n*Warning! Unbounded starting dictionary for p1, output may be incomplete");
-      printf("\n*Recommendation: Change/remove maximize option, or include bounds \n");
+      complete = false;
+      fprintf(stderr, "Warning: Unbounded starting dictionary for player 1, output may be incomplete\n");
      }
 
   /* Pivot to a starting dictionary                      */
@@ -309,7 +349,8 @@ void LrsSolve(const StrategySupport &p_support)
       if (!prune && lrs_getsolution (P1, Q1, output1, col))
 	{ 
            oldnum=numequilib;
-           nash2_main(P1,Q1,P2orig,Q2,&numequilib,output1,output2,p_support);
+           nash2_main(P1,Q1,P2orig,Q2,&numequilib,output1,output2,p_support,
+		      p_equilibria, complete);
 	   if (numequilib > oldnum || Q1->verbose)
 	      {
                 if(Q1->verbose)
@@ -333,7 +374,7 @@ void LrsSolve(const StrategySupport &p_support)
 
 
   lrs_close ("");
-  fclose(lrs_ofp);
+  return complete;
 }
 /*********************************************/
 /* end of nash driver                        */
@@ -348,9 +389,9 @@ void LrsSolve(const StrategySupport &p_support)
 long nash2_main (lrs_dic *P1, lrs_dat *Q1, lrs_dic *P2orig, 
 		 lrs_dat *Q2, long *numequilib, 
 		 lrs_mp_vector output1, lrs_mp_vector output2,
-		 const StrategySupport &p_support)
-
-
+		 const StrategySupport &p_support,
+		 List<MixedStrategyProfile<Rational> > &p_equilibria,
+		 bool &p_complete)
 {
 
   lrs_dic *P2;                  /* This can get resized, cached etc. Loaded from P2orig */
@@ -421,17 +462,17 @@ long nash2_main (lrs_dic *P1, lrs_dat *Q1, lrs_dic *P2orig,
 
   if (!lrs_getfirstbasis2 (&P2, Q2, P2orig, &Lin, TRUE))
     goto sayonara;
+  if (Q2->dualdeg || Q2->unbounded)
+    p_complete = false;
   if (firstwarning && Q2->dualdeg)
      {
       firstwarning=FALSE;
-      printf("\n*Warning! Dual degenerate, ouput may be incomplete");
-      printf("\n*Recommendation: Add dualperturb option before maximize in second input file\n");
+      fprintf(stderr, "Warning: Dual degenerate, output may be incomplete\n");
      }
   if (firstunbounded && Q2->unbounded)
      {
       firstunbounded=FALSE;
-      printf("\n*Warning! Unbounded starting dictionary for p2, output may be incomplete");
-      printf("\n*Recommendation: Change/remove maximize option, or include bounds \n");
+      fprintf(stderr, "Warning: Unbounded starting dictionary for player 2, output may be incomplete\n");
      }
 
   /* Pivot to a starting dictionary                      */
@@ -472,7 +513,7 @@ long nash2_main (lrs_dic *P1, lrs_dat *Q1, lrs_dic *P2orig,
 	    (*numequilib)++;
              if (Q2->verbose)
                   prat(" \np1's obj value: ",P2->objnum,P2->objden);
-	     nashoutput(Q1, output1, Q2, output2, p_support);
+	     nashoutput(Q1, output1, Q2, output2, p_support, p_equilibria);
 	}
     }
   while (lrs_getnextbasis (&P2, Q2, prune));
@@ -952,67 +993,71 @@ hotstart:
 //                         Outputting equilibria
 //==========================================================================
 
-// This is just a modified 'prat' from lrsmp.c
-void 
-printrat (const char *name, lrs_mp Nin, lrs_mp Din)	/*reduce and print Nin/Din  */
+// This is just a modified 'prat' from lrsmp.c, which converts
+// the reduced fraction Nin/Din to a Rational
+Rational 
+torational (lrs_mp Nin, lrs_mp Din)
 {
   lrs_mp Nt, Dt;
   long i;
-  fprintf (stdout, "%s", name);
+  char digits[32];
+  std::string text;
 /* reduce fraction */
   copy (Nt, Nin);
   copy (Dt, Din);
   reduce (Nt, Dt);
-/* print out       */
   if (sign (Nin) * sign (Din) == NEG)
-    fprintf (stdout, "-");
-  //  else
-  //  fprintf (stdout, "");
-  fprintf (stdout, "%lu", Nt[length (Nt) - 1]);
-  for (i = length (Nt) - 2; i >= 1; i--)
-    fprintf (stdout, FORMAT, Nt[i]);
+    text += "-";
+  sprintf (digits, "%lu", Nt[length (Nt) - 1]);
+  text += digits;
+  for (i = length (Nt) - 2; i >= 1; i--) {
+    sprintf (digits, FORMAT, Nt[i]);
+    text += digits;
+  }
   if (!(Dt[0] == 2 && Dt[1] == 1))	/* rational */
     {
-      fprintf (stdout, "/");
-      fprintf (stdout, "%lu", Dt[length (Dt) - 1]);
-      for (i = length (Dt) - 2; i >= 1; i--)
-	fprintf (stdout, FORMAT, Dt[i]);
+      text += "/";
+      sprintf (digits, "%lu", Dt[length (Dt) - 1]);
+      text += digits;
+      for (i = length (Dt) - 2; i >= 1; i--) {
+	sprintf (digits, FORMAT, Dt[i]);
+	text += digits;
+      }
     }
+  return lexical_cast<Rational>(text);
 }
 
+//
+// The lrs driver is not reliable on degenerate games, where it has
+// been observed to report profiles which are not equilibria.  So, each
+// profile is checked before it is accepted.
+//
 void
 nashoutput(lrs_dat *Q1, lrs_mp_vector output1,
 	   lrs_dat *Q2, lrs_mp_vector output2,
-	   const StrategySupport &p_support)
+	   const StrategySupport &p_support,
+	   List<MixedStrategyProfile<Rational> > &p_equilibria)
 {
-  std::cout << "NE";
-  // The -1 is because the last entry in the vector is the payoff
-  // of the other player
-  long i = 1;
-
-  GamePlayer player1 = p_support.GetGame()->GetPlayer(1);
-  for (int j = 1; j <= player1->NumStrategies(); j++) {
-    if (p_support.Contains(player1->GetStrategy(j))) {
-      std::cout << ",";
-      printrat("", output1[i++], output1[0]);
-    }
-    else {
-      std::cout << ",0";
-    }
+  MixedStrategyProfile<Rational> profile(p_support);
+  // The last entry in each vector is the payoff of the other player,
+  // and so is not used
+  for (int j = 1; j <= p_support.NumStrategies(1); j++) {
+    profile[p_support.GetStrategy(1, j)] = torational(output1[j], output1[0]);
+  }
+  for (int j = 1; j <= p_support.NumStrategies(2); j++) {
+    profile[p_support.GetStrategy(2, j)] = torational(output2[j], output2[0]);
   }
 
-  i = 1;
-  GamePlayer player2 = p_support.GetGame()->GetPlayer(2);
-  for (int j = 1; j <= player2->NumStrategies(); j++) {
-    if (p_support.Contains(player2->GetStrategy(j))) {
-      std::cout << ",";
-      printrat("", output2[i++], output2[0]);
-    }
-    else {
-      std::cout << ",0";
+  MixedStrategyProfile<Rational> full(profile.ToFullSupport());
+  for (int pl = 1; pl <= 2; pl++) {
+    GamePlayer player = full.GetGame()->GetPlayer(pl);
+    Rational payoff = full.GetPayoff(pl);
+    for (int st = 1; st <= player->NumStrategies(); st++) {
+      if (full.GetStrategyValue(player->GetStrategy(st)) > payoff) {
+	return;
+      }
     }
   }
-  std::cout << std::endl;
-  fflush(stdout);
-}
 
+  p_equilibria.Append(profile);
+}
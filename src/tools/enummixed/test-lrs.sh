@@ -0,0 +1,72 @@
+#!/bin/sh
+#
+# This file is part of Gambit
+# Copyright (c) 1994-2010, The Gambit Project (http://www.gambit-project.org)
+#
+# FILE: src/tools/enummixed/test-lrs.sh
+# Compare the lrslib and built-in engines of gambit-enummixed
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 2 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+#
+
+#
+# Run by 'make check' from the top of the build tree.  For each of the
+# two-player games in contrib/games which can be solved in a few
+# seconds, the set of equilibria reported with -L (lrslib) must be the
+# same as the set reported by the built-in enumeration (the default).
+# The built-in enumeration may report an equilibrium more than once,
+# so duplicates are ignored.  -L may not be combined with -j.
+#
+
+srcdir=${srcdir:-.}
+program=./gambit-enummixed
+games="\
+	2x2.nfg 2x2a.nfg 2x2const.nfg 8x8.nfg cent2.nfg coord2.nfg \
+	coord3.nfg coord4.nfg csg1.nfg csg2.nfg csg3.nfg csg4.nfg \
+	deg1.nfg deg2.nfg e02.nfg e04.nfg e07.nfg loopback.nfg \
+	mixdom.nfg mixdom2.nfg oneill.nfg pd.nfg perfect1.nfg \
+	perfect2.nfg poker.nfg sh3.nfg stengel.nfg sww1.nfg todd1.nfg \
+	todd2.nfg todd3.nfg vd.nfg wink3.nfg winkels.nfg yamamoto.nfg \
+	zero.nfg 2smp.efg artist1.efg badgame1.efg badgame2.efg \
+	bagwell.efg bayes1a.efg bhg1.efg bhg2.efg bhg3.efg bhg4.efg \
+	bhg5.efg cent2.efg cent3.efg cent4.efg cent6.efg centcs10.efg \
+	centcs6.efg coord2.efg coord2ts.efg coord3.efg coord4.efg \
+	cross.efg e02.efg e04.efg e07.efg e10.efg e10a.efg e13.efg \
+	e17.efg e18.efg holdout.efg holdout7.efg hs1.efg km1.efg \
+	km2.efg km3.efg km6.efg my_2-1.efg my_2-4.efg my_3-3a.efg \
+	my_3-3b.efg my_3-3c.efg my_3-3d.efg my_3-3e.efg myerson.efg \
+	nim.efg palf.efg pbride.efg poker.efg poker2.efg pvw.efg \
+	pvw2.efg sh3.efg spence.efg sww1.efg sww2.efg sww3.efg vd.efg \
+	w_ex1.efg w_ex2.efg wilson1.efg work1.efg work2.efg work3.efg \
+"
+
+status=0
+for game in $games; do
+  file=$srcdir/contrib/games/$game
+  lrs=`$program -q -L < $file 2>/dev/null | sort -u`
+  vertenum=`$program -q < $file 2>/dev/null | sort -u`
+  if test "x$vertenum" = "x"; then
+    echo "FAIL: $game: no equilibria found"
+    status=1
+  elif test "x$lrs" != "x$vertenum"; then
+    echo "FAIL: $game: lrslib and built-in enumeration differ"
+    status=1
+  fi
+done
+if $program -q -L -j 2 < $srcdir/contrib/games/e02.nfg >/dev/null 2>&1; then
+  echo "FAIL: -L -j 2 is accepted"
+  status=1
+fi
+exit $status
@@ -40,10 +40,23 @@
 // The code is based on the reverse Pivoting algorithm of Avis 
 // and Fukuda, Discrete Computational Geom (1992) 8:295-313.
 //
+// The search tree below the starting vertex splits into independent
+// subtrees, one for each reverse pivot from the starting vertex.
+// These can be enumerated separately by passing a branch number
+// to the constructor: branch 0 gives just the starting vertex,
+// and branches 1 through NumRootBranches() give the vertices in
+// each subtree.  Concatenating these lists in order of branch gives
+// the same list as enumerating all vertices at once.  (This is only
+// supported when b has no zero entries; otherwise branch 0 gives
+// all vertices, and there are no further branches.)
+//
 
 template <class T> class VertEnum {
 private:
   int mult_opt,depth;
+  int branch;         // branch to enumerate, or -1 for all vertices
+  bool atRoot;        // true until the starting vertex is searched
+  int rootBranches;   // number of subtrees below the starting vertex
   int n;  // N is the number of columns, which is the # of dimensions.
   int k;  // K is the number of inequalities given.
     // Removed const on A and b (Geoff)
@@ -63,6 +76,7 @@ private:
   void DualSearch(LPTableau<T> &tab);
 public:
   VertEnum(const Gambit::Matrix<T> &, const Gambit::Vector<T> &);
+  VertEnum(const Gambit::Matrix<T> &, const Gambit::Vector<T> &, int branch);
   VertEnum(LPTableau<T> &);
   virtual ~VertEnum();
 
@@ -70,6 +84,7 @@ public:
   const Gambit::List<BFS<T> > &DualVertexList() const;
   void Vertices(Gambit::List<Gambit::Vector<T> > &verts) const;
   long NumPivots() const;
+  int NumRootBranches() const;
 };
 #ifdef _A
 #undef _A
@@ -327,7 +327,7 @@ Gambit::List<Gambit::BehavSupport> SortSupportsBySize(Gambit::List<Gambit::Behav
   return answer;
 }
 
-namespace { // to keep the recursive function private
+namespace { // to keep the utility function private
 
   using namespace Gambit;
 
@@ -357,32 +357,6 @@ void PrintSupport(std::ostream &p_stream,
   p_stream << std::endl;
 }
 
-
-void
-PossibleNashSubsupports(const Gambit::BehavSupport &p_support,
-			const ActionCursorForSupport &p_cursor,
-			Gambit::List<Gambit::BehavSupport> &p_list)
-{
-  ActionCursorForSupport copy(p_cursor);
-  if (!copy.GoToNext()) {
-    if (p_support.HasActiveActionsAtActiveInfosetsAndNoOthers()) {
-      p_list.Append(p_support);
-    }
-
-    Gambit::BehavSupport copySupport(p_support);
-    copySupport.RemoveAction(p_cursor.GetAction());
-    if (copySupport.HasActiveActionsAtActiveInfosetsAndNoOthers()) {
-      p_list.Append(copySupport);
-    }
-    return;
-  }
-  PossibleNashSubsupports(p_support, copy, p_list);
- 
-  Gambit::BehavSupport copySupport(p_support);
-  copySupport.RemoveAction(p_cursor.GetAction());
-  PossibleNashSubsupports(copySupport, copy, p_list);
-}
-
 }
 
 
@@ -395,14 +369,25 @@ PossibleNashSubsupports(const Gambit::BehavSupport &p_support,
 // implementation that works (but may be inefficient), and we will
 // go from there later.
 //
+// All subsupports are visited in lexicographic order, so that the
+// full support comes first, and those which have actions at exactly
+// the reachable information sets are kept.  The subsupports are
+// visited in the compact representation, and only those kept are
+// converted to a BehavSupport.
+//
 Gambit::List<Gambit::BehavSupport> 
 PossibleNashSubsupports(const Gambit::BehavSupport &p_support)
 {
-  ActionCursorForSupport cursor(p_support);
   Gambit::List<Gambit::BehavSupport> supports;
-  Gambit::BehavSupport support(p_support);
+  Gambit::PackedBehavSupport within(p_support);
+  Gambit::PackedBehavSupport support(within);
+
+  do {
+    if (support.HasActiveActionsAtActiveInfosetsAndNoOthers()) {
+      supports.Append(support.ToSupport());
+    }
+  } while (support.Next(within));
 
-  PossibleNashSubsupports(support, cursor, supports);
   return supports;
 }
  
@@ -33,9 +33,11 @@ using namespace Gambit;
 #include "rectangl.h"
 #include "quiksolv.h"
 #include "behavextend.h"
+#include "tools/workers/workers.h"
 
 extern int g_numDecimals;
 extern bool g_verbose;
+extern int g_numWorkers;
 
 //
 // A class to organize the data needed to build the polynomials
@@ -379,29 +381,51 @@ void PrintSupport(std::ostream &p_stream,
   p_stream << std::endl;
 }
 
-void SolveExtensive(const Game &p_game)
+//
+// Solves for the equilibria on one candidate support, writing the
+// equilibria found (and, in verbose mode, the support) to the stream
+//
+class ExtensiveSupportTask : public IndexedTask {
+private:
+  // Not const, so that the list can take advantage of sequential access
+  List<BehavSupport> &m_supports;
+
+public:
+  ExtensiveSupportTask(List<BehavSupport> &p_supports)
+    : m_supports(p_supports) { }
+  virtual ~ExtensiveSupportTask() { }
+
+  void Run(int p_index, std::ostream &p_stream);
+};
+
+void ExtensiveSupportTask::Run(int p_index, std::ostream &p_stream)
 {
-  List<BehavSupport> supports = PossibleNashSubsupports(p_game);
+  const BehavSupport &support = m_supports[p_index];
 
-  for (int i = 1; i <= supports.Length(); i++) {
-    if (g_verbose) {
-      PrintSupport(std::cout, "candidate", supports[i]);
-    }
+  if (g_verbose) {
+    PrintSupport(p_stream, "candidate", support);
+  }
       
-    bool isSingular = false;
-    List<MixedBehavProfile<double> > newsolns = 
-      SolveSupport(supports[i], isSingular);
-
-    for (int j = 1; j <= newsolns.Length(); j++) {
-      MixedBehavProfile<double> fullProfile = ToFullSupport(newsolns[j]);
-      if (fullProfile.GetLiapValue(true) < 1.0e-6) {
-	PrintProfile(std::cout, "NE", fullProfile);
-      }
+  bool isSingular = false;
+  List<MixedBehavProfile<double> > newsolns = 
+    SolveSupport(support, isSingular);
+
+  for (int j = 1; j <= newsolns.Length(); j++) {
+    MixedBehavProfile<double> fullProfile = ToFullSupport(newsolns[j]);
+    if (fullProfile.GetLiapValue(true) < 1.0e-6) {
+      PrintProfile(p_stream, "NE", fullProfile);
     }
+  }
       
-    if (isSingular && g_verbose) {
-      PrintSupport(std::cout, "singular", supports[i]);
-    }
+  if (isSingular && g_verbose) {
+    PrintSupport(p_stream, "singular", support);
   }
 }
 
+void SolveExtensive(const Game &p_game)
+{
+  List<BehavSupport> supports = PossibleNashSubsupports(p_game);
+  ExtensiveSupportTask task(supports);
+  RunWorkers(task, supports.Length(), g_numWorkers, std::cout);
+}
+
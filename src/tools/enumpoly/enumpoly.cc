@@ -28,6 +28,7 @@
 
 int g_numDecimals = 6;
 bool g_verbose = false;
+int g_numWorkers = 1;
 
 void PrintBanner(std::ostream &p_stream)
 {
@@ -47,6 +48,8 @@ void PrintHelp(char *progname)
   std::cerr << "Options:\n";
   std::cerr << "  -d DECIMALS      show equilibrium probabilities with DECIMALS digits\n";
   std::cerr << "  -h               print this help message\n";
+  std::cerr << "  -j PROCESSES     solve supports in PROCESSES worker processes\n";
+  std::cerr << "                   (equilibria are reported as they are found)\n";
   std::cerr << "  -S               use strategic game\n";
   std::cerr << "  -H               use heuristic search method to optimize time\n";
   std::cerr << "                   to find first equilibrium (strategic games only)\n";
@@ -67,7 +70,7 @@ int main(int argc, char *argv[])
   bool useHeuristic = false, useStrategic = false;
 
   int c;
-  while ((c = getopt(argc, argv, "d:hHSqv")) != -1) {
+  while ((c = getopt(argc, argv, "d:hHj:Sqv")) != -1) {
     switch (c) {
     case 'd':
       g_numDecimals = atoi(optarg);
@@ -78,6 +81,13 @@ int main(int argc, char *argv[])
     case 'H':
       useHeuristic = true;
       break;
+    case 'j':
+      g_numWorkers = atoi(optarg);
+      if (g_numWorkers < 1) {
+	std::cerr << argv[0] << ": Number of processes must be at least one.\n";
+	return 1;
+      }
+      break;
     case 'S':
       useStrategic = true;
       break;
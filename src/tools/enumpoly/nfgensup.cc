@@ -27,9 +27,9 @@
 // We begin by simply enumerating all subsupports.
 
 void AllSubsupportsRECURSIVE(const Gambit::StrategySupport &s,
-			     Gambit::StrategySupport *sact,
+			     Gambit::PackedStrategySupport *sact,
 			     StrategyCursorForSupport *c,
-			     Gambit::List<Gambit::StrategySupport> &p_list)
+			     Gambit::List<Gambit::PackedStrategySupport> &p_list)
 { 
   p_list.Append(*sact);
 
@@ -45,10 +45,10 @@ void AllSubsupportsRECURSIVE(const Gambit::StrategySupport &s,
   } while (c_copy.GoToNext()) ;
 }
 
-Gambit::List<Gambit::StrategySupport> AllSubsupports(const Gambit::StrategySupport &S)
+Gambit::List<Gambit::PackedStrategySupport> AllSubsupports(const Gambit::StrategySupport &S)
 {
-  Gambit::List<Gambit::StrategySupport> answer;
-  Gambit::StrategySupport SAct(S);
+  Gambit::List<Gambit::PackedStrategySupport> answer;
+  Gambit::PackedStrategySupport SAct(S);
   StrategyCursorForSupport cursor(S);
 
   AllSubsupportsRECURSIVE(S, &SAct, &cursor, answer);
@@ -60,9 +60,9 @@ Gambit::List<Gambit::StrategySupport> AllSubsupports(const Gambit::StrategySuppo
 // have at least one active strategy for each agent.
 
 void AllValidSubsupportsRECURSIVE(const Gambit::StrategySupport &s,
-				  Gambit::StrategySupport *sact,
+				  Gambit::PackedStrategySupport *sact,
 				  StrategyCursorForSupport *c,
-				  Gambit::List<Gambit::StrategySupport> &p_list)
+				  Gambit::List<Gambit::PackedStrategySupport> &p_list)
 { 
   p_list.Append(*sact);
 
@@ -78,10 +78,10 @@ void AllValidSubsupportsRECURSIVE(const Gambit::StrategySupport &s,
   } while (c_copy.GoToNext()) ;
 }
 
-Gambit::List<Gambit::StrategySupport> AllValidSubsupports(const Gambit::StrategySupport &S)
+Gambit::List<Gambit::PackedStrategySupport> AllValidSubsupports(const Gambit::StrategySupport &S)
 {
-  Gambit::List<Gambit::StrategySupport> answer;
-  Gambit::StrategySupport SAct(S);
+  Gambit::List<Gambit::PackedStrategySupport> answer;
+  Gambit::PackedStrategySupport SAct(S);
   StrategyCursorForSupport cursor(S);
 
   AllValidSubsupportsRECURSIVE(S, &SAct, &cursor, answer);
@@ -90,11 +90,11 @@ Gambit::List<Gambit::StrategySupport> AllValidSubsupports(const Gambit::Strategy
 }
 
 void AllUndominatedSubsupportsRECURSIVE(const Gambit::StrategySupport &s,
-					Gambit::StrategySupport *sact,
+					Gambit::PackedStrategySupport *sact,
 					StrategyCursorForSupport *c,
 					const bool strong,
 					const bool conditional,
-					Gambit::List<Gambit::StrategySupport> &p_list)
+					Gambit::List<Gambit::PackedStrategySupport> &p_list)
 { 
   bool abort = false;
   bool no_deletions = true;
@@ -166,12 +166,12 @@ void AllUndominatedSubsupportsRECURSIVE(const Gambit::StrategySupport &s,
   }
 }
   
-Gambit::List<Gambit::StrategySupport> AllUndominatedSubsupports(const Gambit::StrategySupport &S,
+Gambit::List<Gambit::PackedStrategySupport> AllUndominatedSubsupports(const Gambit::StrategySupport &S,
 					       bool strong,
 					       bool conditional)
 {
-  Gambit::List<Gambit::StrategySupport> answer;
-  Gambit::StrategySupport sact(S);
+  Gambit::List<Gambit::PackedStrategySupport> answer;
+  Gambit::PackedStrategySupport sact(S);
   StrategyCursorForSupport cursor(S);
 
   AllUndominatedSubsupportsRECURSIVE(S,
@@ -186,9 +186,9 @@ Gambit::List<Gambit::StrategySupport> AllUndominatedSubsupports(const Gambit::St
 
 
 void PossibleNashSubsupportsRECURSIVE(const Gambit::StrategySupport &s,
-				      Gambit::StrategySupport *sact,
+				      Gambit::PackedStrategySupport *sact,
 				      StrategyCursorForSupport *c,
-				      Gambit::List<Gambit::StrategySupport> &p_list)
+				      Gambit::List<Gambit::PackedStrategySupport> &p_list)
 { 
   bool abort = false;
   bool no_deletions = true;
@@ -241,7 +241,7 @@ void PossibleNashSubsupportsRECURSIVE(const Gambit::StrategySupport &s,
   }
 }
 
-Gambit::List<Gambit::StrategySupport> SortSupportsBySize(Gambit::List<Gambit::StrategySupport> &p_list) 
+Gambit::List<Gambit::PackedStrategySupport> SortSupportsBySize(Gambit::List<Gambit::PackedStrategySupport> &p_list) 
 {
   Gambit::Array<int> sizes(p_list.Length());
   for (int i = 1; i <= p_list.Length(); i++)
@@ -278,7 +278,7 @@ Gambit::List<Gambit::StrategySupport> SortSupportsBySize(Gambit::List<Gambit::St
       }
   }
 
-  Gambit::List<Gambit::StrategySupport> answer;
+  Gambit::List<Gambit::PackedStrategySupport> answer;
   for (int i = 1; i <= p_list.Length(); i++)
     answer.Append(p_list[listproxy[i]]);
 
@@ -287,8 +287,8 @@ Gambit::List<Gambit::StrategySupport> SortSupportsBySize(Gambit::List<Gambit::St
   
 Gambit::List<Gambit::StrategySupport> PossibleNashSubsupports(const Gambit::StrategySupport &S)
 {
-  Gambit::List<Gambit::StrategySupport> answer;
-  Gambit::StrategySupport sact(S);
+  Gambit::List<Gambit::PackedStrategySupport> answer;
+  Gambit::PackedStrategySupport sact(S);
   StrategyCursorForSupport cursor(S);
   PossibleNashSubsupportsRECURSIVE(S, &sact, &cursor, answer);
 
@@ -298,7 +298,7 @@ Gambit::List<Gambit::StrategySupport> PossibleNashSubsupports(const Gambit::Stra
   // subsupports exhibiting domination by currently inactive strategies.
 
   for (int i = answer.Length(); i >= 1; i--) {
-    Gambit::StrategySupport current(answer[i]);
+    Gambit::PackedStrategySupport current(answer[i]);
     StrategyCursorForSupport crsr(S);
     bool remove = false;
     do {
@@ -324,8 +324,15 @@ Gambit::List<Gambit::StrategySupport> PossibleNashSubsupports(const Gambit::Stra
       answer.Remove(i);
   }
     
-  return SortSupportsBySize(answer);
-  return answer;
+  answer = SortSupportsBySize(answer);
+
+  // Only the supports which survive are converted to the full
+  // representation used in computing on the restricted games
+  Gambit::List<Gambit::StrategySupport> supports;
+  for (int i = 1; i <= answer.Length(); i++) {
+    supports.Append(answer[i].ToSupport());
+  }
+  return supports;
 }
 
 
@@ -29,20 +29,20 @@ class StrategyCursorForSupport;
 // We begin by simply enumerating all subsupports.
 
 void AllSubsupportsRECURSIVE(const Gambit::StrategySupport &s,
-			     Gambit::StrategySupport *sact,
+			     Gambit::PackedStrategySupport *sact,
 			     StrategyCursorForSupport *c,
-			     Gambit::List<Gambit::StrategySupport> &list);
+			     Gambit::List<Gambit::PackedStrategySupport> &list);
 
-Gambit::List<Gambit::StrategySupport> AllSubsupports(const Gambit::StrategySupport &S);
+Gambit::List<Gambit::PackedStrategySupport> AllSubsupports(const Gambit::StrategySupport &S);
 
 // Subsupports of a given support are _valid_ if each agent has an action.
 
 void AllValidSubsupportsRECURSIVE(const Gambit::StrategySupport &s,
-				  Gambit::StrategySupport *sact,
+				  Gambit::PackedStrategySupport *sact,
 				  StrategyCursorForSupport *c,
-				  Gambit::List<Gambit::StrategySupport> &list);
+				  Gambit::List<Gambit::PackedStrategySupport> &list);
 
-Gambit::List<Gambit::StrategySupport> AllValidSubsupports(const Gambit::StrategySupport &S);
+Gambit::List<Gambit::PackedStrategySupport> AllValidSubsupports(const Gambit::StrategySupport &S);
 
 // The following routines combine to return all supports that do not 
 // exhibit particular type of domination.  This was a prototype for 
@@ -54,12 +54,12 @@ Gambit::List<Gambit::StrategySupport> AllValidSubsupports(const Gambit::Strategy
 // dominated, and thus part of an allowed subsupport.
 
 void AllUndominatedSubsupportsRECURSIVE(const Gambit::StrategySupport &s,
-					Gambit::StrategySupport *sact,
+					Gambit::PackedStrategySupport *sact,
 					StrategyCursorForSupport *c,
 					bool strong,
-					Gambit::List<Gambit::StrategySupport> &list);
+					Gambit::List<Gambit::PackedStrategySupport> &list);
   
-Gambit::List<Gambit::StrategySupport> AllUndominatedSubsupports(const Gambit::StrategySupport &S,
+Gambit::List<Gambit::PackedStrategySupport> AllUndominatedSubsupports(const Gambit::StrategySupport &S,
 					       bool strong,
 					       bool conditional);
 
@@ -75,11 +75,11 @@ Gambit::List<Gambit::StrategySupport> AllUndominatedSubsupports(const Gambit::St
 // infosets.
 
 void PossibleNashSubsupportsRECURSIVE(const Gambit::StrategySupport &s,
-				      Gambit::StrategySupport *sact,
+				      Gambit::PackedStrategySupport *sact,
 				      StrategyCursorForSupport *c,
-				      Gambit::List<Gambit::StrategySupport> &list);
+				      Gambit::List<Gambit::PackedStrategySupport> &list);
 
-Gambit::List<Gambit::StrategySupport> SortSupportsBySize(Gambit::List<Gambit::StrategySupport> &);
+Gambit::List<Gambit::PackedStrategySupport> SortSupportsBySize(Gambit::List<Gambit::PackedStrategySupport> &);
   
 Gambit::List<Gambit::StrategySupport> PossibleNashSubsupports(const Gambit::StrategySupport &S);
 
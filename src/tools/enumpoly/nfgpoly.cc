@@ -29,9 +29,11 @@
 #include "gpolylst.h"
 #include "rectangl.h"
 #include "quiksolv.h"
+#include "tools/workers/workers.h"
 
 extern int g_numDecimals;
 extern bool g_verbose; 
+extern int g_numWorkers;
 
 class PolEnumModule  {
 private:
@@ -474,35 +476,56 @@ void PrintSupport(std::ostream &p_stream,
   p_stream << std::endl;
 }
 
-void SolveStrategic(const Gambit::Game &p_nfg)
-{
-  Gambit::List<Gambit::StrategySupport> supports = PossibleNashSubsupports(p_nfg);
+//
+// Solves for the equilibria on one candidate support, writing the
+// equilibria found (and, in verbose mode, the support) to the stream
+//
+class StrategicSupportTask : public IndexedTask {
+private:
+  // Not const, so that the list can take advantage of sequential access
+  Gambit::List<Gambit::StrategySupport> &m_supports;
 
-  for (int i = 1; i <= supports.Length(); i++) {
-    long newevals = 0;
-    double newtime = 0.0;
-    Gambit::List<Gambit::MixedStrategyProfile<double> > newsolns;
-    bool is_singular = false;
+public:
+  StrategicSupportTask(Gambit::List<Gambit::StrategySupport> &p_supports)
+    : m_supports(p_supports) { }
+  virtual ~StrategicSupportTask() { }
+
+  void Run(int p_index, std::ostream &p_stream);
+};
+
+void StrategicSupportTask::Run(int p_index, std::ostream &p_stream)
+{
+  const Gambit::StrategySupport &support = m_supports[p_index];
+  long newevals = 0;
+  double newtime = 0.0;
+  Gambit::List<Gambit::MixedStrategyProfile<double> > newsolns;
+  bool is_singular = false;
     
-    if (g_verbose) {
-      PrintSupport(std::cout, "candidate", supports[i]);
-    }
+  if (g_verbose) {
+    PrintSupport(p_stream, "candidate", support);
+  }
 
-    PolEnum(supports[i], newsolns, newevals, newtime, is_singular);
+  PolEnum(support, newsolns, newevals, newtime, is_singular);
       
-    for (int j = 1; j <= newsolns.Length(); j++) {
-      Gambit::MixedStrategyProfile<double> fullProfile = ToFullSupport(newsolns[j]);
-      if (fullProfile.GetLiapValue() < 1.0e-6) {
-	PrintProfile(std::cout, "NE", fullProfile);
-      }
+  for (int j = 1; j <= newsolns.Length(); j++) {
+    Gambit::MixedStrategyProfile<double> fullProfile = ToFullSupport(newsolns[j]);
+    if (fullProfile.GetLiapValue() < 1.0e-6) {
+      PrintProfile(p_stream, "NE", fullProfile);
     }
+  }
 
-    if (is_singular && g_verbose) {
-      PrintSupport(std::cout, "singular", supports[i]);
-    }
+  if (is_singular && g_verbose) {
+    PrintSupport(p_stream, "singular", support);
   }
 }
 
+void SolveStrategic(const Gambit::Game &p_nfg)
+{
+  Gambit::List<Gambit::StrategySupport> supports = PossibleNashSubsupports(p_nfg);
+  StrategicSupportTask task(supports);
+  RunWorkers(task, supports.Length(), g_numWorkers, std::cout);
+}
+
 
 
 
@@ -25,6 +25,7 @@
 #include <iostream>
 #include "libgambit/libgambit.h"
 #include "libgambit/subgame.h"
+#include "purenash.h"
 
 using namespace Gambit;
 
@@ -43,61 +44,6 @@ void PrintProfile(std::ostream &p_stream,
   p_stream << std::endl;
 }
 
-List<MixedBehavProfile<Rational> > SolveBehav(const BehavSupport &p_support,
-					      bool p_print = false)
-{
-  List<MixedBehavProfile<Rational> > solutions;
-
-  Game efg = p_support.GetGame();
-
-  for (BehavIterator citer(p_support); !citer.AtEnd(); citer++) {
-    bool isNash = true;
-
-    for (GamePlayerIterator player = efg->Players(); 
-	 isNash && !player.AtEnd(); player++)  {
-      Rational current = citer->GetPayoff<Rational>(player);
-	
-      for (GameInfosetIterator infoset = player->Infosets();
-	   isNash && !infoset.AtEnd(); infoset++)  {
-	for (GameActionIterator action = infoset->Actions();
-	     !action.AtEnd(); action++) {
-	  if (citer->GetActionValue<Rational>(action) > current)  {
-	    isNash = false;
-	    break;
-	  }
-	}
-      }
-    }
-      
-    if (isNash)  {
-      MixedBehavProfile<Rational> temp(efg);
-      // zero out all the entries, since any equilibria are pure
-      ((Vector<Rational> &) temp).operator=(Rational(0));
-
-      for (GamePlayerIterator player = efg->Players();
-	   !player.AtEnd(); player++) {
-	for (GameInfosetIterator infoset = player->Infosets();
-	     !infoset.AtEnd(); infoset++) {
-	  temp(citer->GetAction(infoset)) = 1;
-	}
-      }
-
-      if (p_print) {
-	PrintProfile(std::cout, temp);
-      }
-      solutions.Append(temp);
-    }
-  }
-
-  return solutions;
-}
-
-List<MixedBehavProfile<Rational> > 
-SubsolveBehav(const BehavSupport &p_support)
-{
-  return SolveBehav(p_support, false);
-}
-
 template <class T>
 void PrintProfile(std::ostream &p_stream,
 		  const MixedStrategyProfile<T> &p_profile)
@@ -113,36 +59,26 @@ void PrintProfile(std::ostream &p_stream,
   p_stream << std::endl;
 }
 
-void SolveMixed(Game p_nfg)
+//
+// Prints each equilibrium to the stream as soon as it is found
+//
+class StreamObserver : public NashObserver {
+private:
+  std::ostream &m_stream;
+
+public:
+  StreamObserver(std::ostream &p_stream) : m_stream(p_stream) { }
+
+  void OnProfile(const MixedStrategyProfile<Rational> &p_profile)
+  { PrintProfile(m_stream, p_profile); }
+  void OnProfile(const MixedBehavProfile<Rational> &p_profile)
+  { PrintProfile(m_stream, p_profile); }
+};
+
+List<MixedBehavProfile<Rational> > 
+SubsolveBehav(const BehavSupport &p_support)
 {
-  for (StrategyIterator citer(p_nfg); !citer.AtEnd(); citer++) {
-    bool flag = true;
-
-    for (GamePlayerIterator player = p_nfg->Players(); 
-	 flag && !player.AtEnd(); player++)  {
-      Rational current = citer->GetPayoff<Rational>(player);
-      PureStrategyProfile p(*citer); 
-      for (GameStrategyIterator strategy = player->Strategies();
-	   !strategy.AtEnd(); strategy++) {
-	if (p.GetStrategyValue<Rational>(strategy) > current)  {
-	  flag = false;
-	  break;
-	}
-      }
-    }
-    
-    if (flag)  {
-      MixedStrategyProfile<Rational> temp(p_nfg);
-      ((Vector<Rational> &) temp).operator=(Rational(0));
-      PureStrategyProfile profile(*citer);
-      for (GamePlayerIterator player = p_nfg->Players();
-	   !player.AtEnd(); player++) {
-	temp[profile.GetStrategy(player)] = 1;
-      }
-      
-      PrintProfile(std::cout, temp);
-    }
-  }
+  return EnumPureAgentSolve(p_support, 0);
 }
 
 
@@ -210,8 +146,8 @@ int main(int argc, char *argv[])
     Game game = ReadGame(std::cin);
 
     if (!game->IsTree() || useStrategic) {
-      game->BuildComputedValues();
-      SolveMixed(game);
+      StreamObserver observer(std::cout);
+      EnumPureStrategySolve(game, observer);
     }
     else {
       if (bySubgames) {
@@ -223,7 +159,8 @@ int main(int argc, char *argv[])
 	}
       }
       else {
-	SolveBehav(game, true);
+	StreamObserver observer(std::cout);
+	EnumPureAgentSolve(game, observer);
       }
     }
     return 0;
@@ -0,0 +1,121 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2010, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/tools/enumpure/purenash.cc
+// Enumeration of pure-strategy Nash equilibria
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include "purenash.h"
+
+using namespace Gambit;
+
+List<MixedBehavProfile<Rational> > 
+EnumPureAgentSolve(const BehavSupport &p_support, NashObserver *p_observer)
+{
+  List<MixedBehavProfile<Rational> > solutions;
+
+  Game efg = p_support.GetGame();
+
+  for (BehavIterator citer(p_support); !citer.AtEnd(); citer++) {
+    if (p_observer && p_observer->IsCancelled()) {
+      break;
+    }
+
+    bool isNash = true;
+
+    for (GamePlayerIterator player = efg->Players(); 
+	 isNash && !player.AtEnd(); player++)  {
+      Rational current = citer->GetPayoff<Rational>(player);
+	
+      for (GameInfosetIterator infoset = player->Infosets();
+	   isNash && !infoset.AtEnd(); infoset++)  {
+	for (GameActionIterator action = infoset->Actions();
+	     !action.AtEnd(); action++) {
+	  if (citer->GetActionValue<Rational>(action) > current)  {
+	    isNash = false;
+	    break;
+	  }
+	}
+      }
+    }
+      
+    if (isNash)  {
+      MixedBehavProfile<Rational> temp(efg);
+      // zero out all the entries, since any equilibria are pure
+      ((Vector<Rational> &) temp).operator=(Rational(0));
+
+      for (GamePlayerIterator player = efg->Players();
+	   !player.AtEnd(); player++) {
+	for (GameInfosetIterator infoset = player->Infosets();
+	     !infoset.AtEnd(); infoset++) {
+	  temp(citer->GetAction(infoset)) = 1;
+	}
+      }
+
+      if (p_observer) {
+	p_observer->OnProfile(temp);
+      }
+      solutions.Append(temp);
+    }
+  }
+
+  return solutions;
+}
+
+void EnumPureAgentSolve(const Game &p_game, NashObserver &p_observer)
+{
+  EnumPureAgentSolve(BehavSupport(p_game), &p_observer);
+}
+
+void EnumPureStrategySolve(const Game &p_nfg, NashObserver &p_observer)
+{
+  p_nfg->BuildComputedValues();
+
+  for (StrategyIterator citer(p_nfg); !citer.AtEnd(); citer++) {
+    if (p_observer.IsCancelled()) {
+      break;
+    }
+
+    bool flag = true;
+
+    for (GamePlayerIterator player = p_nfg->Players(); 
+	 flag && !player.AtEnd(); player++)  {
+      Rational current = citer->GetPayoff<Rational>(player);
+      PureStrategyProfile p(*citer); 
+      for (GameStrategyIterator strategy = player->Strategies();
+	   !strategy.AtEnd(); strategy++) {
+	if (p.GetStrategyValue<Rational>(strategy) > current)  {
+	  flag = false;
+	  break;
+	}
+      }
+    }
+    
+    if (flag)  {
+      MixedStrategyProfile<Rational> temp(p_nfg);
+      ((Vector<Rational> &) temp).operator=(Rational(0));
+      PureStrategyProfile profile(*citer);
+      for (GamePlayerIterator player = p_nfg->Players();
+	   !player.AtEnd(); player++) {
+	temp[profile.GetStrategy(player)] = 1;
+      }
+      
+      p_observer.OnProfile(temp);
+    }
+  }
+}
@@ -0,0 +1,49 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2010, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/tools/enumpure/purenash.h
+// Enumeration of pure-strategy Nash equilibria
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef PURENASH_H
+#define PURENASH_H
+
+#include "libgambit/libgambit.h"
+#include "libgambit/nash.h"
+
+// These are the solver entry points shared by gambit-enumpure and the
+// graphical interface, which runs them on a worker thread.  Each
+// equilibrium is passed to the observer as soon as it is found; the
+// enumeration stops early if the observer is cancelled.
+
+// Enumerate the pure-strategy equilibria of the strategic form of p_game
+void EnumPureStrategySolve(const Gambit::Game &p_game,
+			   Gambit::NashObserver &p_observer);
+
+// Enumerate the pure-strategy equilibria of the agent form of p_support,
+// returning them as well as reporting them to the observer (if any)
+Gambit::List<Gambit::MixedBehavProfile<Gambit::Rational> > 
+EnumPureAgentSolve(const Gambit::BehavSupport &p_support,
+		   Gambit::NashObserver *p_observer);
+
+// Convenience form for the graphical interface, solving the agent form
+// of the whole game
+void EnumPureAgentSolve(const Gambit::Game &p_game,
+			Gambit::NashObserver &p_observer);
+
+#endif  // PURENASH_H
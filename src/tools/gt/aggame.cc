@@ -0,0 +1,292 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2010, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/tools/gt/aggame.cc
+// Action-graph game representation for Gametracer
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <string>
+#include "aggame.h"
+
+aggame::aggame(int numPlayers, int *actions,
+	       const std::vector<int> &actionNodes,
+	       const std::vector<std::vector<int> > &neighbors)
+  : gnmgame(numPlayers, actions), actionNodes(actionNodes),
+    neighbors(neighbors), position(neighbors.size()),
+    nodePayoffs(neighbors.size()), defaultPayoff(0.0)
+{
+  for (size_t k = 0; k < neighbors.size(); k++) {
+    position[k].assign(neighbors.size(), -1);
+    for (size_t p = 0; p < neighbors[k].size(); p++) {
+      position[k][neighbors[k][p]] = p;
+    }
+  }
+}
+
+aggame::~aggame()
+{ }
+
+//
+// The format is
+//   AGG
+//   <players> <nodes>
+//   <number of actions of each player>
+//   <node of each action, player by player>
+//   for each node: <neighbourhood size> <neighbouring nodes>
+//   for each node: <number of entries>, then each entry as
+//                  <count on each neighbouring node> <payoff>
+// Players' actions and nodes are numbered from 1.
+//
+aggame *aggame::read(std::istream &in)
+{
+  std::string keyword;
+  int numPlayers, numNodes;
+  if (!(in >> keyword) || keyword != "AGG" || 
+      !(in >> numPlayers >> numNodes) || numPlayers < 2 || numNodes < 1) {
+    return 0;
+  }
+
+  std::vector<int> actions(numPlayers);
+  int numActions = 0;
+  for (int pl = 0; pl < numPlayers; pl++) {
+    if (!(in >> actions[pl]) || actions[pl] < 1) return 0;
+    numActions += actions[pl];
+  }
+
+  std::vector<int> actionNodes(numActions);
+  for (int i = 0; i < numActions; i++) {
+    if (!(in >> actionNodes[i]) || 
+	actionNodes[i] < 1 || actionNodes[i] > numNodes) return 0;
+    actionNodes[i]--;
+  }
+
+  std::vector<std::vector<int> > neighbors(numNodes);
+  for (int k = 0; k < numNodes; k++) {
+    int size;
+    if (!(in >> size) || size < 0 || size > numNodes) return 0;
+    neighbors[k].resize(size);
+    for (int p = 0; p < size; p++) {
+      if (!(in >> neighbors[k][p]) ||
+	  neighbors[k][p] < 1 || neighbors[k][p] > numNodes) return 0;
+      neighbors[k][p]--;
+    }
+  }
+
+  aggame *game = new aggame(numPlayers, &actions[0], actionNodes, neighbors);
+  for (int k = 0; k < numNodes; k++) {
+    int entries;
+    if (!(in >> entries) || entries < 0) {
+      delete game;
+      return 0;
+    }
+    std::vector<int> config(neighbors[k].size());
+    for (int e = 0; e < entries; e++) {
+      int total = 0;
+      for (size_t p = 0; p < config.size(); p++) {
+	if (!(in >> config[p]) || config[p] < 0) {
+	  delete game;
+	  return 0;
+	}
+	total += config[p];
+      }
+      double value;
+      if (total > numPlayers || !(in >> value)) {
+	delete game;
+	return 0;
+      }
+      game->setNodePayoff(k, config, value);
+    }
+  }
+
+  return game;
+}
+
+void aggame::setNodePayoff(int node, const std::vector<int> &config, 
+			   double value)
+{
+  nodePayoffs[node][config] = value;
+}
+
+double aggame::getPurePayoff(int player, int *s)
+{
+  int node = actionNodes[firstAction(player) + s[player]];
+  std::vector<int> config(neighbors[node].size(), 0);
+  for (int n = 0; n < numPlayers; n++) {
+    int p = position[node][actionNodes[firstAction(n) + s[n]]];
+    if (p >= 0) config[p]++;
+  }
+  configmap::const_iterator entry = nodePayoffs[node].find(config);
+  return (entry != nodePayoffs[node].end()) ? entry->second : defaultPayoff;
+}
+
+void aggame::setPurePayoff(int player, int *s, double value)
+{
+  int node = actionNodes[firstAction(player) + s[player]];
+  std::vector<int> config(neighbors[node].size(), 0);
+  for (int n = 0; n < numPlayers; n++) {
+    int p = position[node][actionNodes[firstAction(n) + s[n]]];
+    if (p >= 0) config[p]++;
+  }
+  setNodePayoff(node, config, value);
+}
+
+void aggame::configDistribution(configmap &dest, int node, cvector &s,
+				int skip1, int skip2)
+{
+  int size = neighbors[node].size();
+  dest.clear();
+  dest[std::vector<int>(size, 0)] = 1.0;
+
+  // weight[p] is the probability the current player chooses the
+  // neighbour at position p; weight[size] collects everything else.
+  std::vector<double> weight(size + 1);
+  configmap next;
+  for (int n = 0; n < numPlayers; n++) {
+    if (n == skip1 || n == skip2) continue;
+
+    weight.assign(size + 1, 0.0);
+    bool touches = false;
+    for (int i = firstAction(n); i < lastAction(n); i++) {
+      int p = position[node][actionNodes[i]];
+      if (p >= 0 && s[i] != 0.0) {
+	weight[p] += s[i];
+	touches = true;
+      }
+      else if (p < 0) {
+	weight[size] += s[i];
+      }
+    }
+
+    if (!touches) {
+      // Player n cannot affect this neighbourhood; only the
+      // total probability mass changes.
+      if (weight[size] != 1.0) {
+	for (configmap::iterator c = dest.begin(); c != dest.end(); ++c) {
+	  c->second *= weight[size];
+	}
+      }
+      continue;
+    }
+
+    next.clear();
+    for (configmap::const_iterator c = dest.begin(); c != dest.end(); ++c) {
+      std::vector<int> config(c->first);
+      if (weight[size] != 0.0) {
+	next[config] += c->second * weight[size];
+      }
+      for (int p = 0; p < size; p++) {
+	if (weight[p] == 0.0) continue;
+	config[p]++;
+	next[config] += c->second * weight[p];
+	config[p]--;
+      }
+    }
+    dest.swap(next);
+  }
+}
+
+double aggame::expectedPayoff(const configmap &dist, int node,
+			      int pos1, int pos2)
+{
+  const configmap &payoffs = nodePayoffs[node];
+  double total = 0.0;
+  for (configmap::const_iterator c = dist.begin(); c != dist.end(); ++c) {
+    std::vector<int> config(c->first);
+    if (pos1 >= 0) config[pos1]++;
+    if (pos2 >= 0) config[pos2]++;
+    configmap::const_iterator entry = payoffs.find(config);
+    total += c->second * ((entry != payoffs.end()) ? entry->second : defaultPayoff);
+  }
+  return total;
+}
+
+double aggame::getMixedPayoff(int player, cvector &s)
+{
+  configmap dist;
+  double payoff = 0.0;
+  for (int i = firstAction(player); i < lastAction(player); i++) {
+    if (s[i] == 0.0) continue;
+    int node = actionNodes[i];
+    configDistribution(dist, node, s, player, -1);
+    payoff += s[i] * expectedPayoff(dist, node, position[node][node], -1);
+  }
+  return payoff;
+}
+
+void aggame::payoffMatrix(cmatrix &dest, cvector &s, double fuzz)
+{
+  int rown, coln, rowi, coli;
+  double fuzzcount;
+  configmap dist;
+  for(rown = 0; rown < numPlayers; rown++) {
+    fuzzcount = fuzz;
+    for(rowi=firstAction(rown); rowi < lastAction(rown); rowi++) {
+      for(coli=firstAction(rown); coli < lastAction(rown); coli++) {
+	dest[rowi][coli]=fuzzcount;
+	fuzzcount += fuzz;
+      }
+    }
+
+    for(rowi = firstAction(rown); rowi < lastAction(rown); rowi++) {
+      int node = actionNodes[rowi];
+      for(coln = 0; coln < numPlayers; coln++) {
+	if(coln == rown) continue;
+	configDistribution(dist, node, s, rown, coln);
+	for(coli = firstAction(coln); coli < lastAction(coln); coli++) {
+	  dest[rowi][coli] = expectedPayoff(dist, node, position[node][node],
+					    position[node][actionNodes[coli]]);
+	}
+      }
+    }
+  }
+}
+
+double aggame::getMaxPayoff()
+{
+  double value = defaultPayoff;
+  for (size_t k = 0; k < nodePayoffs.size(); k++) {
+    for (configmap::const_iterator c = nodePayoffs[k].begin();
+	 c != nodePayoffs[k].end(); ++c) {
+      if (c->second > value) value = c->second;
+    }
+  }
+  return value;
+}
+
+double aggame::getMinPayoff()
+{
+  double value = defaultPayoff;
+  for (size_t k = 0; k < nodePayoffs.size(); k++) {
+    for (configmap::const_iterator c = nodePayoffs[k].begin();
+	 c != nodePayoffs[k].end(); ++c) {
+      if (c->second < value) value = c->second;
+    }
+  }
+  return value;
+}
+
+void aggame::rescale(double shift, double scale)
+{
+  defaultPayoff = (defaultPayoff - shift) * scale;
+  for (size_t k = 0; k < nodePayoffs.size(); k++) {
+    for (configmap::iterator c = nodePayoffs[k].begin();
+	 c != nodePayoffs[k].end(); ++c) {
+      c->second = (c->second - shift) * scale;
+    }
+  }
+}
@@ -0,0 +1,94 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2010, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/tools/gt/aggame.h
+// Action-graph game representation for Gametracer
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef __AGGAME_H
+#define __AGGAME_H
+
+#include <map>
+#include "gnmgame.h"
+#include "cmatrix.h"
+
+// An action-graph game.  Each action of each player is mapped to a node
+// of the action graph; several players' actions may share a node.  The
+// payoff to a player choosing a node depends only on the configuration
+// on that node's neighbourhood, that is, on the number of players
+// (including himself) choosing each neighbouring node.  Payoffs for
+// configurations not explicitly set are taken to be zero.
+//
+// Expected payoffs are computed by building up the distribution of
+// configurations one player at a time, so the cost is polynomial in the
+// number of players rather than proportional to the size of the
+// equivalent normal form.
+
+class aggame : public gnmgame {
+ public:
+  // actionNodes[i] is the node of (global) action i, as laid out by
+  // firstAction(); neighbors[k] lists the neighbourhood of node k.
+  aggame(int numPlayers, int *actions, 
+	 const std::vector<int> &actionNodes,
+	 const std::vector<std::vector<int> > &neighbors);
+  ~aggame();
+
+  // Reads a game in the action-graph format documented in tools.rst,
+  // including the leading AGG keyword.  Returns 0 if the input is not
+  // a valid game in that format.
+  static aggame *read(std::istream &in);
+
+  double getPurePayoff(int player, int *s);
+  // This sets the payoff for the configuration induced by s on the
+  // neighbourhood of the node player chooses, and so also changes the
+  // payoff of every other profile inducing the same configuration.
+  void setPurePayoff(int player, int *s, double value);
+
+  inline int getNumNodes() { return neighbors.size(); }
+  void setNodePayoff(int node, const std::vector<int> &config, double value);
+
+  double getMixedPayoff(int player, cvector &s);
+  void payoffMatrix(cmatrix &dest, cvector &s, double fuzz);
+
+  // Bounds on the payoffs of the game, taken over all configurations
+  double getMaxPayoff();
+  double getMinPayoff();
+  // Replaces each payoff u by (u - shift) * scale
+  void rescale(double shift, double scale);
+
+ private:
+  typedef std::map<std::vector<int>, double> configmap;
+
+  // Stores in dest the distribution of configurations on the
+  // neighbourhood of node induced by all players except skip1 and skip2
+  void configDistribution(configmap &dest, int node, cvector &s,
+			  int skip1, int skip2);
+  // Expected payoff at node under dist, with the configuration 
+  // incremented at neighbourhood positions pos1 and pos2 (if nonnegative)
+  double expectedPayoff(const configmap &dist, int node, int pos1, int pos2);
+
+  std::vector<int> actionNodes;
+  std::vector<std::vector<int> > neighbors;
+  // position[k][m] is the index of node m in the neighbourhood of node k,
+  // or -1 if it is not a neighbour
+  std::vector<std::vector<int> > position;
+  std::vector<configmap> nodePayoffs;
+  double defaultPayoff;
+};
+
+#endif  // __AGGAME_H
@@ -23,11 +23,6 @@
 
 gnmgame::gnmgame(int numPlayers, int *actions): numPlayers(numPlayers) {
   int i;
-  numStrategies = 1;
-  for(i = 0; i < numPlayers; i++) {
-    numStrategies *= actions[i];
-  }
-
   this->actions = new int[numPlayers];
   strategyOffset = new int[numPlayers+1];
   numActions = 0;
@@ -88,7 +88,7 @@ class gnmgame {
 	    double &D);
 
   int *strategyOffset;
-  int numPlayers, numStrategies, numActions;
+  int numPlayers, numActions;
   int *actions;
   int maxActions;
 };
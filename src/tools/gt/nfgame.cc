@@ -17,10 +17,11 @@
  * Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
  */
 
+#include <algorithm>
 #include "cmatrix.h"
 #include "nfgame.h"
 
-nfgame::nfgame(int numPlayers, int *actions, const cvector &payoffs) : gnmgame(numPlayers, actions), payoffs(payoffs) {
+nfgame::nfgame(int numPlayers, int *actions, const cvector &payoffs) : gnmgame(numPlayers, actions), payoffs(payoffs), work(2 * (numPlayers + 1)) {
   blockSize = new int[numPlayers + 1];
   blockSize[0] = 1;
   for(int i = 1; i <= numPlayers; i++) {
@@ -40,119 +41,126 @@ int nfgame::findIndex(int player, int *s) {
 }
 
 double nfgame::getMixedPayoff(int player, cvector &s) {
-  double *m = new double[blockSize[numPlayers]];
-  try {
-    memcpy(m, payoffs.values() + player * blockSize[numPlayers], blockSize[numPlayers]*sizeof(double));
-    double p = localPayoff(s, m, numPlayers);
-    delete [] m;
-    return p;
-  }
-  catch (...) {
-    delete [] m;
-    throw;
-  }
+  std::vector<int> dims(numPlayers);
+  for(int n = 0; n < numPlayers; n++)
+    dims[n] = n;
+  std::vector<int> drop(dims);
+  return *contractPlayers(s, payoffs.values() + player * blockSize[numPlayers],
+			  dims, drop, 0);
 }
 
 void nfgame::payoffMatrix(cmatrix &dest, cvector &s, double fuzz) {
   int rown, coln, rowi, coli;
   double fuzzcount;
-  double *m = new double[blockSize[numPlayers]];
-  double *local = new double[maxActions*maxActions];
-  try {
-    for(rown = 0; rown < numPlayers; rown++) {
-      for(coln = 0; coln < numPlayers; coln++) {
-	if(rown == coln) {
-	  fuzzcount = fuzz;
-	  for(rowi=firstAction(rown); rowi < lastAction(rown); rowi++) {
-	    for(coli=firstAction(coln); coli < lastAction(coln); coli++) {
-	      dest[rowi][coli]=fuzzcount;
-	      fuzzcount += fuzz;
-	    }
-	  }
-	} else {
-	  // set m to be the payoffs for player rown
-	  memcpy(m, payoffs.values() + rown * blockSize[numPlayers], blockSize[numPlayers] * sizeof(double));
-	  localPayoffMatrix(local, rown, coln, s, m, numPlayers-1);
-	  for(rowi = firstAction(rown); rowi < lastAction(rown); rowi++) {
-	    for(coli = firstAction(coln); coli < lastAction(coln); coli++) {
-	      if(rown > coln) {
-		dest[rowi][coli] = *(local + (rowi - firstAction(rown))*actions[coln] + (coli - firstAction(coln)));
-	      } else {
-		dest[rowi][coli] = *(local + (coli - firstAction(coln))*actions[rown] + (rowi - firstAction(rown)));
-	      }
-	    }
-	  }
-	}
+  std::vector<int> dims(numPlayers), others;
+  for(rown = 0; rown < numPlayers; rown++)
+    dims[rown] = rown;
+
+  for(rown = 0; rown < numPlayers; rown++) {
+    fuzzcount = fuzz;
+    for(rowi=firstAction(rown); rowi < lastAction(rown); rowi++) {
+      for(coli=firstAction(rown); coli < lastAction(rown); coli++) {
+	dest[rowi][coli]=fuzzcount;
+	fuzzcount += fuzz;
       }
     }
-    delete [] local;
-    delete [] m;
-  }
-  catch (...) {
-    delete [] local;
-    delete [] m;
-    throw;
-  }
-}
-
-
-//assumes m = memcpy(m, payoffs + blockSize[numPlayers] * player1, blockSize[numPlayers]*sizeof(double)), player1 != player2
-//i.e. m points to payoff cmatrix for the desired player
 
-void nfgame::localPayoffMatrix(double *dest, int player1, int player2, cvector &s, double *m, int n) {
-  int i;
-  if(player1 == n) {
-    for(i = 0; i < actions[player1]; i++) {
-      localPayoffVector(dest+i*actions[player2], player2, s, m+i*blockSize[player1], n-1);
+    others.clear();
+    for(coln = 0; coln < numPlayers; coln++) {
+      if(coln != rown)
+	others.push_back(coln);
     }
-  } else if(player2 == n) {
-    for(i = 0; i < actions[player2]; i++) {
-      localPayoffVector(dest+i*actions[player1], player1, s, m+i*blockSize[player2], n-1);
-    }
-  } else {
-    m = scaleMatrix(s, m, n);
-    localPayoffMatrix(dest, player1, player2, s, m, n-1);
+    if(!others.empty())
+      pairBlocks(dest, s, rown, payoffs.values() + rown * blockSize[numPlayers],
+		 dims, others, 0);
   }
 }
 
-double *nfgame::scaleMatrix(cvector &s, double *m, int n) {
-  int i,j, curbase, newbase = -1;
-  double scale;
-  for(i = 0; i < actions[n]; i++) {
-    if(s[i+firstAction(n)] > 0.0) {
-      scale = s[i+firstAction(n)];
-      curbase = i*blockSize[n];
-      if(newbase < 0) {
-	newbase = curbase;
-	for(j = curbase; j < curbase+blockSize[n]; j++) {
-	  m[j] *= scale;
-	}
-      } else {
-	for(j = 0; j < blockSize[n]; j++) {
-	  m[newbase + j] += scale * m[curbase+j];
-	}
+void nfgame::pairBlocks(cmatrix &dest, cvector &s, int player, const double *m,
+			const std::vector<int> &dims, const std::vector<int> &others,
+			int level) {
+  if(others.size() == 1) {
+    // m is now the matrix of payoffs to player against coln, with the
+    // lower-numbered of the two varying fastest.
+    int coln = others[0], rowi, coli;
+    for(rowi = 0; rowi < actions[player]; rowi++) {
+      for(coli = 0; coli < actions[coln]; coli++) {
+	dest[firstAction(player)+rowi][firstAction(coln)+coli] = 
+	  (player < coln) ? m[rowi + coli*actions[player]] : m[coli + rowi*actions[coln]];
       }
     }
+    return;
   }
-  return m+newbase;
+
+  std::vector<int> lower(others.begin(), others.begin() + others.size()/2);
+  std::vector<int> upper(others.begin() + others.size()/2, others.end());
+  std::vector<int> keep;
+
+  keep = dims;
+  const double *t = contractPlayers(s, m, keep, upper, level);
+  pairBlocks(dest, s, player, t, keep, lower, level+1);
+
+  keep = dims;
+  t = contractPlayers(s, m, keep, lower, level);
+  pairBlocks(dest, s, player, t, keep, upper, level+1);
 }
 
-void nfgame::localPayoffVector(double *dest, int player, cvector &s, double *m, int n) {
-  if(player == n) {
-    for(int i = 0; i < actions[player]; i++) {
-      dest[i] = localPayoff(s, m+i*blockSize[player], n-1);
+//
+// Players are contracted one at a time, from the highest-numbered down.
+// Viewing the table as outer x actions x inner, with the contracted
+// player in the middle, each contraction is a weighted sum of contiguous
+// runs of length inner.  As in the original scaling code, strategies
+// played with probability zero (or less) are skipped.
+//
+const double *nfgame::contractPlayers(cvector &s, const double *m,
+				      std::vector<int> &dims, 
+				      const std::vector<int> &drop, int level) {
+  int size = 1;
+  for(size_t k = 0; k < dims.size(); k++)
+    size *= actions[dims[k]];
+
+  const double *src = m;
+  int buffer = 0;
+  for(int k = dims.size() - 1; k >= 0; k--) {
+    if(std::find(drop.begin(), drop.end(), dims[k]) == drop.end())
+      continue;
+
+    int n = actions[dims[k]], inner = 1;
+    for(int j = 0; j < k; j++)
+      inner *= actions[dims[j]];
+    int outer = size / (n * inner);
+    const double *w = s.values() + firstAction(dims[k]);
+
+    std::vector<double> &out = work[2*level + buffer];
+    if((int) out.size() < outer * inner)
+      out.resize(outer * inner);
+    double *dst = &out[0];
+    for(int o = 0; o < outer; o++, dst += inner, src += n * inner) {
+      bool first = true;
+      for(int j = 0; j < n; j++) {
+	double wj = w[j];
+	if(wj <= 0.0)
+	  continue;
+	const double *in = src + j * inner;
+	if(first) {
+	  for(int i = 0; i < inner; i++)
+	    dst[i] = wj * in[i];
+	  first = false;
+	} else {
+	  for(int i = 0; i < inner; i++)
+	    dst[i] += wj * in[i];
+	}
+      }
+      if(first) {
+	for(int i = 0; i < inner; i++)
+	  dst[i] = 0.0;
+      }
     }
-  } else {
-    m = scaleMatrix(s, m, n);
-    localPayoffVector(dest, player, s, m, n-1);
-  }
-}
 
-double nfgame::localPayoff(cvector &s, double *m, int n) {
-  if(n < 0)
-    return *m;
-  else {
-    m = scaleMatrix(s, m, n);
-    return localPayoff(s, m, n-1);
+    src = &out[0];
+    buffer = 1 - buffer;
+    size = outer * inner;
+    dims.erase(dims.begin() + k);
   }
+  return src;
 }
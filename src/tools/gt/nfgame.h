@@ -44,12 +44,26 @@ class nfgame : public gnmgame {
 
  private:
   int findIndex(int player, int *s);
-  void localPayoffMatrix(double *dest, int player1, int player2, cvector &s, double *m, int n);
-  void localPayoffVector(double *dest, int player, cvector &s, double *m, int n);
-  double localPayoff(cvector &s, double *m, int n);
-  double *scaleMatrix(cvector &s, double *m, int n);
+
+  // Computes the off-diagonal blocks of dest in the rows of player, for
+  // each player in others.  m is player's payoff table with all players
+  // not in dims already contracted; dims lists the remaining players in
+  // increasing order, and consists of player and others.  The others are
+  // split in halves, and each half is contracted once and shared by all
+  // the blocks of the other half.
+  void pairBlocks(cmatrix &dest, cvector &s, int player, const double *m,
+		  const std::vector<int> &dims, const std::vector<int> &others,
+		  int level);
+  // Contracts m against s over the players in drop, which are removed
+  // from dims.  The result is stored in the scratch buffers for level.
+  const double *contractPlayers(cvector &s, const double *m,
+				std::vector<int> &dims, 
+				const std::vector<int> &drop, int level);
+
   cvector payoffs;
   int *blockSize;
+  // Scratch space for contractions, two buffers per level of recursion
+  std::vector<std::vector<double> > work;
 };
 
 #endif
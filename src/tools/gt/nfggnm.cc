@@ -24,9 +24,14 @@
 #include <cmath>
 #include <iostream>
 #include <fstream>
+#include <sstream>
+#include <set>
 #include "libgambit/libgambit.h"
+#include "tools/workers/workers.h"
 
 #include "nfgame.h"
+#include "aggame.h"
+#include "polymatrixgame.h"
 #include "gnmgame.h"
 #include "gnm.h"
 
@@ -42,6 +47,7 @@ const double THRESHOLD = 1e-2;
 int g_numDecimals = 6;
 bool g_verbose = false;
 int g_numVectors = 1;
+int g_numWorkers = 1;
 std::string g_startFile;
 
 bool ReadProfile(std::istream &p_stream, cvector &p_profile)
@@ -80,10 +86,12 @@ void PrintHelp(char *progname)
   PrintBanner(std::cerr);
   std::cerr << "Usage: " << progname << " [OPTIONS]\n";
   std::cerr << "Accepts game on standard input.\n";
+  std::cerr << "Action-graph (AGG) and polymatrix (POLYMATRIX) games are also accepted.\n";
 
   std::cerr << "Options:\n";
   std::cerr << "  -d DECIMALS      show equilibria as floating point with DECIMALS digits\n";
   std::cerr << "  -h               print this help message\n";
+  std::cerr << "  -j PROCESSES     trace the rays in PROCESSES worker processes\n";
   std::cerr << "  -n COUNT         number of perturbation vectors to generate\n";
   std::cerr << "  -s FILE          file containing perturbation vectors\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
@@ -92,63 +100,140 @@ void PrintHelp(char *progname)
   exit(1);
 }
 
-void Solve(const Gambit::Game &p_game)
+//
+// Payoffs of compact games are scaled to [0,1] as for tables, using
+// the bounds computed from the compact representation.
+//
+template <class T> void Rescale(T &p_game)
 {
-  int i;
+  double maxPay = p_game.getMaxPayoff();
+  double minPay = p_game.getMinPayoff();
+  if (maxPay > minPay) {
+    p_game.rescale(minPay, 1.0 / (maxPay - minPay));
+  }
+}
 
-  Gambit::Rational maxPay = p_game->GetMaxPayoff();
-  Gambit::Rational minPay = p_game->GetMinPayoff();
-  double scale = 1.0 / (maxPay - minPay);
+//
+// Traces the ray for each of a list of perturbation vectors.  GNM writes
+// its output to std::cout, which is pointed at the task's stream while
+// the ray is traced.
+//
+class RayTask : public IndexedTask {
+private:
+  gnmgame &m_game;
+  const std::vector<cvector> &m_rays;
 
-  int *actions = new int[p_game->NumPlayers()];
-  int veclength = p_game->NumPlayers();
-  for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
-    actions[pl-1] = p_game->GetPlayer(pl)->NumStrategies();
-    veclength *= p_game->GetPlayer(pl)->NumStrategies();
-  }
-  cvector payoffs(veclength);
-  
-  gnmgame *A = new nfgame(p_game->NumPlayers(), actions, payoffs);
-  
-  int *profile = new int[p_game->NumPlayers()];
-  for (Gambit::StrategyIterator iter(p_game); !iter.AtEnd(); iter++) {
-    for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
-      profile[pl-1] = iter->GetStrategy(pl)->GetNumber() - 1;
+public:
+  RayTask(gnmgame &p_game, const std::vector<cvector> &p_rays)
+    : m_game(p_game), m_rays(p_rays) { }
+  virtual ~RayTask() { }
+
+  void Run(int p_index, std::ostream &p_stream);
+};
+
+void RayTask::Run(int p_index, std::ostream &p_stream)
+{
+  cvector g(m_rays[p_index-1]);
+  std::streambuf *saved = std::cout.rdbuf(p_stream.rdbuf());
+  try {
+    if (g_verbose) {
+      PrintProfile(std::cout, "pert", g);
     }
 
-    for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
-      A->setPurePayoff(pl-1, profile, 
-		       (double) (iter->GetPayoff<Gambit::Rational>(pl) - minPay) *
-		       scale);
+    cvector **answers;
+    int numEq = GNM(m_game, g, answers, STEPS, FUZZ, LNMFREQ, LNMMAX, 
+		    LAMBDAMIN, WOBBLE, THRESHOLD);
+    for (int i = 0; i < numEq; i++) {
+      free(answers[i]);
     }
+    free(answers);
+
+    if (g_verbose) {
+      std::cout << "ray," << p_index << "," << numEq << std::endl;
+    }
+  }
+  catch (...) {
+    std::cout.rdbuf(saved);
+    throw;
   }
+  std::cout.rdbuf(saved);
+}
 
-  cvector g(A->getNumActions()); // choose a random perturbation ray
-  int numEq;
+//
+// The same equilibrium is often found on several rays.  Output from the
+// rays passes through this filter, which drops any NE line identical to
+// one already written, that is, any equilibrium which agrees with one
+// already found to the number of decimals shown.  The summary line for
+// each ray is completed with the number of new equilibria it found.
+//
+class EquilibriumFilter : public std::streambuf {
+private:
+  std::streambuf *m_dest;
+  std::string m_line;
+  std::set<std::string> m_found;
+  int m_numNew;
+
+  void WriteLine(const std::string &p_line)
+  { m_dest->sputn(p_line.c_str(), p_line.length());  m_dest->sputc('\n'); }
+
+protected:
+  int overflow(int c);
+  int sync() { return m_dest->pubsync(); }
+
+public:
+  EquilibriumFilter(std::streambuf *p_dest) : m_dest(p_dest), m_numNew(0) { }
+};
+
+int EquilibriumFilter::overflow(int c)
+{
+  if (c == EOF) {
+    return 0;
+  }
+  else if (c != '\n') {
+    m_line += (char) c;
+    return c;
+  }
+
+  if (m_line.compare(0, 3, "NE,") == 0) {
+    if (m_found.insert(m_line).second) {
+      WriteLine(m_line);
+      m_numNew++;
+    }
+  }
+  else if (m_line.compare(0, 4, "ray,") == 0) {
+    WriteLine(m_line + "," + Gambit::lexical_cast<std::string>(m_numNew));
+    m_numNew = 0;
+  }
+  else {
+    WriteLine(m_line);
+  }
+  m_line = "";
+  return c;
+}
+
+// Runs GNM on A from each perturbation ray; A is deleted afterwards.
+// Rays are traced in g_numWorkers processes, and their output is
+// reported in order of ray, so it does not depend on the number
+// of processes.
+void Solve(gnmgame *A)
+{
+  std::vector<cvector> rays;
+  cvector g(A->getNumActions());
 
   if (g_startFile != "") {
     std::ifstream startVectors(g_startFile.c_str());
 
     while (!startVectors.eof() && !startVectors.bad()) {
-      cvector **answers;
       if (ReadProfile(startVectors, g)) {
 	g /= g.norm(); // normalized
-	if (g_verbose) {
-	  PrintProfile(std::cout, "pert", g);
-	}
-
-	numEq = GNM(*A, g, answers, STEPS, FUZZ, LNMFREQ, LNMMAX, LAMBDAMIN, WOBBLE, THRESHOLD);
-	for (i = 0; i < numEq; i++) {
-	  free(answers[i]);
-	}
-	free(answers);
+	rays.push_back(g);
       }
     }
   }
   else {
     for (int iter = 0; iter < g_numVectors; iter++) {
-      cvector **answers;
-      for(i = 0; i < A->getNumActions(); i++) {
+      // choose a random perturbation ray
+      for (int i = 0; i < A->getNumActions(); i++) {
 #if !defined(HAVE_DRAND48)
 	g[i] = rand();
 #else
@@ -156,27 +241,63 @@ void Solve(const Gambit::Game &p_game)
 #endif  // HAVE_DRAND48
       }
       g /= g.norm(); // normalized
-      if (g_verbose) {
-	PrintProfile(std::cout, "pert", g);
-      }
-      numEq = GNM(*A, g, answers, STEPS, FUZZ, LNMFREQ, LNMMAX, LAMBDAMIN, WOBBLE, THRESHOLD);
-      for (i = 0; i < numEq; i++) {
-	free(answers[i]);
-      }
-      free(answers);
+      rays.push_back(g);
     }
   }
 
+  EquilibriumFilter filter(std::cout.rdbuf());
+  std::ostream stream(&filter);
+  RayTask task(*A, rays);
+  try {
+    RunWorkers(task, rays.size(), g_numWorkers, stream, true);
+  }
+  catch (...) {
+    delete A;
+    throw;
+  }
+  stream.flush();
   delete A;
 }
 
+void Solve(const Gambit::Game &p_game)
+{
+  Gambit::Rational maxPay = p_game->GetMaxPayoff();
+  Gambit::Rational minPay = p_game->GetMinPayoff();
+  double scale = 1.0 / (maxPay - minPay);
+
+  int *actions = new int[p_game->NumPlayers()];
+  int veclength = p_game->NumPlayers();
+  for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
+    actions[pl-1] = p_game->GetPlayer(pl)->NumStrategies();
+    veclength *= p_game->GetPlayer(pl)->NumStrategies();
+  }
+  cvector payoffs(veclength);
+  
+  gnmgame *A = new nfgame(p_game->NumPlayers(), actions, payoffs);
+  
+  int *profile = new int[p_game->NumPlayers()];
+  for (Gambit::StrategyIterator iter(p_game); !iter.AtEnd(); iter++) {
+    for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
+      profile[pl-1] = iter->GetStrategy(pl)->GetNumber() - 1;
+    }
+
+    for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
+      A->setPurePayoff(pl-1, profile, 
+		       (double) (iter->GetPayoff<Gambit::Rational>(pl) - minPay) *
+		       scale);
+    }
+  }
+
+  Solve(A);
+}
+
 int main(int argc, char *argv[])
 {
   opterr = 0;
   bool quiet = false;
 
   int c;
-  while ((c = getopt(argc, argv, "d:n:s:qvhS")) != -1) {
+  while ((c = getopt(argc, argv, "d:j:n:s:qvhS")) != -1) {
     switch (c) {
     case 'q':
       quiet = true;
@@ -187,6 +308,13 @@ int main(int argc, char *argv[])
     case 'd':
       g_numDecimals = atoi(optarg);
       break;
+    case 'j':
+      g_numWorkers = atoi(optarg);
+      if (g_numWorkers < 1) {
+	std::cerr << argv[0] << ": Number of processes must be at least one.\n";
+	return 1;
+      }
+      break;
     case 'n':
       g_numVectors = atoi(optarg);
       break;
@@ -216,17 +344,42 @@ int main(int argc, char *argv[])
   }
 
   try {
-    Gambit::Game game = Gambit::ReadGame(std::cin);
+    std::stringstream input;
+    input << std::cin.rdbuf();
+    std::string keyword;
+    input >> keyword;
+    input.clear();
+    input.seekg(0);
 
-    game->BuildComputedValues();
+    if (keyword == "AGG") {
+      aggame *A = aggame::read(input);
+      if (!A) throw Gambit::InvalidFileException();
+      Rescale(*A);
+      Solve(A);
+    }
+    else if (keyword == "POLYMATRIX") {
+      polymatrixgame *A = polymatrixgame::read(input);
+      if (!A) throw Gambit::InvalidFileException();
+      Rescale(*A);
+      Solve(A);
+    }
+    else {
+      Gambit::Game game = Gambit::ReadGame(input);
+
+      game->BuildComputedValues();
 
-    Solve(game);
+      Solve(game);
+    }
     return 0;
   }
   catch (Gambit::InvalidFileException) {
     std::cerr << "Error: Game not in a recognized format.\n";
     return 1;
   }
+  catch (WorkerException &e) {
+    std::cerr << "Error: " << e.what() << ".\n";
+    return 1;
+  }
   catch (...) {
     std::cerr << "Error: An internal error occurred.\n";
     return 1;
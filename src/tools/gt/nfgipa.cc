@@ -24,9 +24,12 @@
 #include <cmath>
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include "libgambit/libgambit.h"
 
 #include "nfgame.h"
+#include "aggame.h"
+#include "polymatrixgame.h"
 #include "ipa.h"
 
 #define ALPHA 0.02
@@ -34,12 +37,11 @@
 
 int g_numDecimals = 6;
 
-void PrintProfile(std::ostream &p_stream,
-		  const Gambit::Game &p_game, cvector *p_profile)
+void PrintProfile(std::ostream &p_stream, cvector *p_profile)
 {
   p_stream.setf(std::ios::fixed);
   p_stream << "NE";
-  for (int i = 0; i < p_game->MixedProfileLength(); i++) {
+  for (int i = 0; i < p_profile->getm(); i++) {
     p_stream << "," << std::setprecision(g_numDecimals) << (*p_profile)[i];
   }
   p_stream << std::endl;
@@ -58,6 +60,7 @@ void PrintHelp(char *progname)
   PrintBanner(std::cerr);
   std::cerr << "Usage: " << progname << " [OPTIONS]\n";
   std::cerr << "Accepts game on standard input.\n";
+  std::cerr << "Action-graph (AGG) and polymatrix (POLYMATRIX) games are also accepted.\n";
 
   std::cerr << "Options:\n";
   std::cerr << "  -d DECIMALS      show equilibria as floating point with DECIMALS digits\n";
@@ -66,10 +69,32 @@ void PrintHelp(char *progname)
   exit(1);
 }
 
-void Solve(const Gambit::Game &p_game, const Gambit::Array<double> &p_pert)
+// Runs IPA on A along the ray p_pert; A is deleted afterwards.
+void Solve(gnmgame *A, const cvector &p_pert)
 {
   int i;
 
+  cvector g(A->getNumActions()); // perturbation ray
+  int numEq;
+
+  cvector ans(A->getNumActions());
+  cvector zh(A->getNumActions(),1.0);
+  do {
+    for(i = 0; i < A->getNumActions(); i++) {
+      g[i] = p_pert[i];
+    }
+    g /= g.norm(); // normalized
+    numEq = IPA(*A, g, zh, ALPHA, EQERR, ans);
+  } while(numEq == 0);
+
+
+  PrintProfile(std::cout, &ans);
+
+  delete A;
+}
+
+void Solve(const Gambit::Game &p_game)
+{
   int *actions = new int[p_game->NumPlayers()];
   int veclength = p_game->NumPlayers();
   for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
@@ -91,23 +116,7 @@ void Solve(const Gambit::Game &p_game, const Gambit::Array<double> &p_pert)
     }
   }
 
-  cvector g(A->getNumActions()); // perturbation ray
-  int numEq;
-
-  cvector ans(A->getNumActions());
-  cvector zh(A->getNumActions(),1.0);
-  do {
-    for(i = 0; i < A->getNumActions(); i++) {
-      g[i] = p_pert[i+1];
-    }
-    g /= g.norm(); // normalized
-    numEq = IPA(*A, g, zh, ALPHA, EQERR, ans);
-  } while(numEq == 0);
-
-
-  PrintProfile(std::cout, p_game, &ans);
-
-  delete A;
+  Solve(A, cvector(A->getNumActions(), 1.0));
 }
 
 
@@ -148,16 +157,30 @@ int main(int argc, char *argv[])
   }
 
   try {
-    Gambit::Game game = Gambit::ReadGame(std::cin);
-
-    game->BuildComputedValues();
-    
-    Gambit::Array<double> pert(game->MixedProfileLength());
-    for (int i = 1; i <= pert.Length(); i++) {
-      pert[i] = 1.0;
+    std::stringstream input;
+    input << std::cin.rdbuf();
+    std::string keyword;
+    input >> keyword;
+    input.clear();
+    input.seekg(0);
+
+    if (keyword == "AGG") {
+      aggame *A = aggame::read(input);
+      if (!A) throw Gambit::InvalidFileException();
+      Solve(A, cvector(A->getNumActions(), 1.0));
+    }
+    else if (keyword == "POLYMATRIX") {
+      polymatrixgame *A = polymatrixgame::read(input);
+      if (!A) throw Gambit::InvalidFileException();
+      Solve(A, cvector(A->getNumActions(), 1.0));
     }
+    else {
+      Gambit::Game game = Gambit::ReadGame(input);
 
-    Solve(game, pert);
+      game->BuildComputedValues();
+
+      Solve(game);
+    }
     return 0;
   }
   catch (Gambit::InvalidFileException) {
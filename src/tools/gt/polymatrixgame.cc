@@ -0,0 +1,237 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2010, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/tools/gt/polymatrixgame.cc
+// Polymatrix game representation for Gametracer
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <string>
+#include "polymatrixgame.h"
+
+polymatrixgame::polymatrixgame(int numPlayers, int *actions)
+  : gnmgame(numPlayers, actions), blockOffset(numPlayers * numPlayers, 0)
+{
+  int size = 0;
+  for (int i = 0; i < numPlayers; i++) {
+    for (int j = 0; j < numPlayers; j++) {
+      blockOffset[i*numPlayers+j] = size;
+      if (i != j) size += actions[i] * actions[j];
+    }
+  }
+  payoffs.assign(size, 0.0);
+}
+
+polymatrixgame::~polymatrixgame()
+{ }
+
+//
+// The format is
+//   POLYMATRIX
+//   <players>
+//   <number of actions of each player>
+// followed by any number of blocks
+//   <player i> <player j>
+//   <payoffs to i, one row for each action of i, one column for each of j>
+// Players are numbered from 1; pairs not listed contribute zero.
+//
+polymatrixgame *polymatrixgame::read(std::istream &in)
+{
+  std::string keyword;
+  int numPlayers;
+  if (!(in >> keyword) || keyword != "POLYMATRIX" ||
+      !(in >> numPlayers) || numPlayers < 2) {
+    return 0;
+  }
+
+  std::vector<int> actions(numPlayers);
+  for (int pl = 0; pl < numPlayers; pl++) {
+    if (!(in >> actions[pl]) || actions[pl] < 1) return 0;
+  }
+
+  polymatrixgame *game = new polymatrixgame(numPlayers, &actions[0]);
+  int i, j;
+  while (in >> i) {
+    if (!(in >> j) || i < 1 || i > numPlayers || j < 1 || j > numPlayers ||
+	i == j) {
+      delete game;
+      return 0;
+    }
+    i--;  j--;
+    for (int a1 = 0; a1 < actions[i]; a1++) {
+      for (int a2 = 0; a2 < actions[j]; a2++) {
+	if (!(in >> game->pairPayoff(i, j, a1, a2))) {
+	  delete game;
+	  return 0;
+	}
+      }
+    }
+  }
+  if (!in.eof()) {
+    delete game;
+    return 0;
+  }
+  return game;
+}
+
+double polymatrixgame::getPurePayoff(int player, int *s)
+{
+  double payoff = 0.0;
+  for (int n = 0; n < numPlayers; n++) {
+    if (n != player) payoff += pairPayoff(player, n, s[player], s[n]);
+  }
+  return payoff;
+}
+
+void polymatrixgame::setPurePayoff(int, int *, double)
+{
+  cerr << "setPurePayoff not supported for polymatrix games" << endl;
+  exit(1);
+}
+
+double polymatrixgame::pairValue(int player1, int player2, int a1, 
+				 cvector &s)
+{
+  double value = 0.0;
+  const double *row = &payoffs[blockOffset[player1*numPlayers+player2] + 
+			       a1*actions[player2]];
+  for (int a2 = 0; a2 < actions[player2]; a2++) {
+    value += row[a2] * s[firstAction(player2) + a2];
+  }
+  return value;
+}
+
+void polymatrixgame::actionValues(cvector &v, cvector &s)
+{
+  for (int n = 0; n < numPlayers; n++) {
+    for (int i = firstAction(n); i < lastAction(n); i++) {
+      v[i] = 0.0;
+      for (int m = 0; m < numPlayers; m++) {
+	if (m != n) v[i] += pairValue(n, m, i - firstAction(n), s);
+      }
+    }
+  }
+}
+
+double polymatrixgame::getMixedPayoff(int player, cvector &s)
+{
+  double payoff = 0.0;
+  for (int i = firstAction(player); i < lastAction(player); i++) {
+    if (s[i] == 0.0) continue;
+    for (int n = 0; n < numPlayers; n++) {
+      if (n != player) {
+	payoff += s[i] * pairValue(player, n, i - firstAction(player), s);
+      }
+    }
+  }
+  return payoff;
+}
+
+//
+// The expected payoff to rown from rowi when coln plays coli is his
+// value from rowi against everybody, with the contribution of his
+// game against coln replaced by the pure payoff against coli.
+//
+void polymatrixgame::payoffMatrix(cmatrix &dest, cvector &s, double fuzz)
+{
+  int rown, coln, rowi, coli;
+  double fuzzcount;
+  cvector v(numActions);
+  actionValues(v, s);
+
+  for(rown = 0; rown < numPlayers; rown++) {
+    for(coln = 0; coln < numPlayers; coln++) {
+      if(rown == coln) {
+	fuzzcount = fuzz;
+	for(rowi=firstAction(rown); rowi < lastAction(rown); rowi++) {
+	  for(coli=firstAction(coln); coli < lastAction(coln); coli++) {
+	    dest[rowi][coli]=fuzzcount;
+	    fuzzcount += fuzz;
+	  }
+	}
+      } else {
+	for(rowi = firstAction(rown); rowi < lastAction(rown); rowi++) {
+	  int a1 = rowi - firstAction(rown);
+	  double others = v[rowi] - pairValue(rown, coln, a1, s);
+	  for(coli = firstAction(coln); coli < lastAction(coln); coli++) {
+	    dest[rowi][coli] = others + 
+	      pairPayoff(rown, coln, a1, coli - firstAction(coln));
+	  }
+	}
+      }
+    }
+  }
+}
+
+//
+// Since each opponent's action enters only one of the pairwise games,
+// the extreme payoffs to a player are attained by choosing the best
+// (or worst) column in each game separately.
+//
+double polymatrixgame::getMaxPayoff()
+{
+  double value = 0.0;
+  bool first = true;
+  for (int n = 0; n < numPlayers; n++) {
+    for (int a1 = 0; a1 < actions[n]; a1++) {
+      double total = 0.0;
+      for (int m = 0; m < numPlayers; m++) {
+	if (m == n) continue;
+	double best = pairPayoff(n, m, a1, 0);
+	for (int a2 = 1; a2 < actions[m]; a2++) {
+	  if (pairPayoff(n, m, a1, a2) > best) best = pairPayoff(n, m, a1, a2);
+	}
+	total += best;
+      }
+      if (first || total > value) value = total;
+      first = false;
+    }
+  }
+  return value;
+}
+
+double polymatrixgame::getMinPayoff()
+{
+  double value = 0.0;
+  bool first = true;
+  for (int n = 0; n < numPlayers; n++) {
+    for (int a1 = 0; a1 < actions[n]; a1++) {
+      double total = 0.0;
+      for (int m = 0; m < numPlayers; m++) {
+	if (m == n) continue;
+	double worst = pairPayoff(n, m, a1, 0);
+	for (int a2 = 1; a2 < actions[m]; a2++) {
+	  if (pairPayoff(n, m, a1, a2) < worst) worst = pairPayoff(n, m, a1, a2);
+	}
+	total += worst;
+      }
+      if (first || total < value) value = total;
+      first = false;
+    }
+  }
+  return value;
+}
+
+void polymatrixgame::rescale(double shift, double scale)
+{
+  // Each player's payoff is a sum over numPlayers-1 pairwise games,
+  // so the shift is spread evenly across them.
+  double pairShift = shift / (double) (numPlayers - 1);
+  for (size_t k = 0; k < payoffs.size(); k++) {
+    payoffs[k] = (payoffs[k] - pairShift) * scale;
+  }
+}
@@ -0,0 +1,77 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2010, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/tools/gt/polymatrixgame.h
+// Polymatrix game representation for Gametracer
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef __POLYMATRIXGAME_H
+#define __POLYMATRIXGAME_H
+
+#include "gnmgame.h"
+#include "cmatrix.h"
+
+// A polymatrix game, in which each player plays a separate two-player
+// game against each other player, and receives the sum of the payoffs
+// from these games.  Storage and the cost of computing expected payoffs
+// are quadratic in the number of players.
+
+class polymatrixgame : public gnmgame {
+ public:
+  polymatrixgame(int numPlayers, int *actions);
+  ~polymatrixgame();
+
+  // Reads a game in the polymatrix format documented in tools.rst,
+  // including the leading POLYMATRIX keyword.  Returns 0 if the input
+  // is not a valid game in that format.
+  static polymatrixgame *read(std::istream &in);
+
+  // Payoff to player1 from his game against player2, when they choose
+  // their (player-relative) actions a1 and a2
+  inline double &pairPayoff(int player1, int player2, int a1, int a2) {
+    return payoffs[blockOffset[player1*numPlayers+player2] + 
+		   a1*actions[player2] + a2];
+  }
+
+  double getPurePayoff(int player, int *s);
+  // Payoffs to pure profiles do not determine the pairwise games
+  // uniquely, so this is not supported.
+  void setPurePayoff(int player, int *s, double value);
+
+  double getMixedPayoff(int player, cvector &s);
+  void payoffMatrix(cmatrix &dest, cvector &s, double fuzz);
+
+  // Bounds on the payoffs of the game, taken over all pure profiles
+  double getMaxPayoff();
+  double getMinPayoff();
+  // Replaces each payoff u by (u - shift) * scale
+  void rescale(double shift, double scale);
+
+ private:
+  // Stores in v[i] the expected payoff to the owner of action i from
+  // playing i against the profile s
+  void actionValues(cvector &v, cvector &s);
+  // Expected payoff to player1 from action a1 in his game against
+  // player2, when player2 plays according to s
+  double pairValue(int player1, int player2, int a1, cvector &s);
+
+  std::vector<double> payoffs;
+  std::vector<int> blockOffset;
+};
+
+#endif  // __POLYMATRIXGAME_H
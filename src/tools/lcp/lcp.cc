@@ -21,10 +21,13 @@
 //
 
 #include <iostream>
+#include <iomanip>
+#include <cstdio>
 #include <cstdlib>
 #include <unistd.h>
 #include "libgambit/libgambit.h"
 #include "libgambit/subgame.h"
+#include "nfglcp.h"
 
 using namespace Gambit;
 
@@ -32,7 +35,6 @@ template <class T>
 List<MixedBehavProfile<T> > SolveExtensive(const BehavSupport &p);
 template <class T>
 List<MixedBehavProfile<T> > SolveExtensiveSilent(const BehavSupport &p);
-template <class T> void SolveStrategic(const Game &p_game);
 
 void PrintBanner(std::ostream &p_stream)
 {
@@ -73,6 +75,90 @@ extern void PrintProfile(std::ostream &, const std::string &,
 extern void PrintProfile(std::ostream &, const std::string &,
 			 const MixedBehavProfile<Rational> &);
 
+void PrintProfile(std::ostream &p_stream,
+		  const std::string &p_label,
+		  const MixedStrategyProfile<double> &p_profile)
+{
+  p_stream << p_label;
+  for (int i = 1; i <= p_profile.Length(); i++) {
+    p_stream.setf(std::ios::fixed);
+    p_stream << "," << std::setprecision(g_numDecimals) << p_profile[i];
+  }
+
+  p_stream << std::endl;
+}
+
+void PrintProfile(std::ostream &p_stream,
+		  const std::string &p_label,
+		  const MixedStrategyProfile<Rational> &p_profile)
+{
+  p_stream << p_label;
+  for (int i = 1; i <= p_profile.Length(); i++) {
+    p_stream << "," << p_profile[i];
+  }
+
+  p_stream << std::endl;
+}
+
+template <class T>
+void PrintProfileDetail(std::ostream &p_stream,
+			const MixedStrategyProfile<T> &p_profile)
+{
+  char buffer[256];
+
+  for (int pl = 1; pl <= p_profile.GetGame()->NumPlayers(); pl++) {
+    GamePlayer player = p_profile.GetGame()->GetPlayer(pl);
+    p_stream << "Strategy profile for player " << pl << ":\n";
+    
+    p_stream << "Strategy   Prob          Value\n";
+    p_stream << "-------    -----------   -----------\n";
+
+    for (int st = 1; st <= player->NumStrategies(); st++) {
+      GameStrategy strategy = player->GetStrategy(st);
+
+      if (strategy->GetLabel() != "") {
+	sprintf(buffer, "%7s    ", strategy->GetLabel().c_str());
+      }
+      else {
+	sprintf(buffer, "%7d   ", st);
+      }
+      p_stream << buffer;
+	
+      sprintf(buffer, "%11s   ", lexical_cast<std::string>(p_profile[strategy], g_numDecimals).c_str());
+      p_stream << buffer;
+
+      sprintf(buffer, "%11s   ", lexical_cast<std::string>(p_profile.GetStrategyValue(strategy), g_numDecimals).c_str());
+      p_stream << buffer;
+
+      p_stream << "\n";
+    }
+  }
+}
+
+//
+// Prints each equilibrium of the strategic game as soon as it is found
+//
+class StreamObserver : public NashObserver {
+private:
+  std::ostream &m_stream;
+
+  template <class T> void Print(const MixedStrategyProfile<T> &p_profile)
+  {
+    PrintProfile(m_stream, "NE", p_profile);
+    if (g_printDetail) {
+      PrintProfileDetail(m_stream, p_profile);
+    }
+  }
+
+public:
+  StreamObserver(std::ostream &p_stream) : m_stream(p_stream) { }
+
+  void OnProfile(const MixedStrategyProfile<double> &p_profile)
+  { Print(p_profile); }
+  void OnProfile(const MixedStrategyProfile<Rational> &p_profile)
+  { Print(p_profile); }
+};
+
 
 int main(int argc, char *argv[])
 {
@@ -134,11 +220,12 @@ int main(int argc, char *argv[])
     if (!game->IsTree() || useStrategic) {
       game->BuildComputedValues();
 
+      StreamObserver observer(std::cout);
       if (useFloat) {
-	SolveStrategic<double>(game);
+	LcpStrategySolve<double>(game, g_stopAfter, g_maxDepth, observer);
       }
       else {
-	SolveStrategic<Rational>(game);
+	LcpStrategySolve<Rational>(game, g_stopAfter, g_maxDepth, observer);
       }
     }
     else {
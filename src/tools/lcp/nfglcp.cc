@@ -20,18 +20,12 @@
 // Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 //
 
-#include <cstdio>
-#include <unistd.h>
-#include <iostream>
-
 #include "libgambit/libgambit.h"
+#include "nfglcp.h"
 #include "lhtab.h"
 
 using namespace Gambit;
 
-extern int g_numDecimals, g_stopAfter, g_maxDepth;
-extern bool g_printDetail;
-
 namespace {
 //
 // Pseudo-exception raised when maximum number of equilibria to compute
@@ -50,67 +44,6 @@ public:
 } // end anonymous namespace
 
 
-void PrintProfile(std::ostream &p_stream,
-		  const std::string &p_label,
-		  const MixedStrategyProfile<double> &p_profile)
-{
-  p_stream << p_label;
-  for (int i = 1; i <= p_profile.Length(); i++) {
-    p_stream.setf(std::ios::fixed);
-    p_stream << "," << std::setprecision(g_numDecimals) << p_profile[i];
-  }
-
-  p_stream << std::endl;
-}
-
-void PrintProfile(std::ostream &p_stream,
-		  const std::string &p_label,
-		  const MixedStrategyProfile<Rational> &p_profile)
-{
-  p_stream << p_label;
-  for (int i = 1; i <= p_profile.Length(); i++) {
-    p_stream << "," << p_profile[i];
-  }
-
-  p_stream << std::endl;
-}
-
-template <class T>
-void PrintProfileDetail(std::ostream &p_stream,
-			const MixedStrategyProfile<T> &p_profile)
-{
-  char buffer[256];
-
-  for (int pl = 1; pl <= p_profile.GetGame()->NumPlayers(); pl++) {
-    GamePlayer player = p_profile.GetGame()->GetPlayer(pl);
-    p_stream << "Strategy profile for player " << pl << ":\n";
-    
-    p_stream << "Strategy   Prob          Value\n";
-    p_stream << "-------    -----------   -----------\n";
-
-    for (int st = 1; st <= player->NumStrategies(); st++) {
-      GameStrategy strategy = player->GetStrategy(st);
-
-      if (strategy->GetLabel() != "") {
-	sprintf(buffer, "%7s    ", strategy->GetLabel().c_str());
-      }
-      else {
-	sprintf(buffer, "%7d   ", st);
-      }
-      p_stream << buffer;
-	
-      sprintf(buffer, "%11s   ", lexical_cast<std::string>(p_profile[strategy], g_numDecimals).c_str());
-      p_stream << buffer;
-
-      sprintf(buffer, "%11s   ", lexical_cast<std::string>(p_profile.GetStrategyValue(strategy), g_numDecimals).c_str());
-      p_stream << buffer;
-
-      p_stream << "\n";
-    }
-  }
-}
-
-
 template <class T> Matrix<T> Make_A1(const StrategySupport &); 
 template <class T> Vector<T> Make_b1(const StrategySupport &);
 template <class T> Matrix<T> Make_A2(const StrategySupport &);
@@ -120,13 +53,14 @@ template <class T> Vector<T> Make_b2(const StrategySupport &);
 //
 // Function called when a CBFS is encountered.
 // If it is not already in the list p_list, it is added.
-// The corresponding equilibrium is computed and output.
+// The corresponding equilibrium is computed and passed to the observer.
 // Returns 'true' if the CBFS is new; 'false' if it already appears in the
 // list.
 //
 template <class T>
 bool OnBFS(const StrategySupport &p_support,
-	   List<BFS<T> > &p_list, LHTableau<T> &p_tableau)
+	   List<BFS<T> > &p_list, LHTableau<T> &p_tableau,
+	   int p_stopAfter, NashObserver &p_observer)
 {
   BFS<T> cbfs(p_tableau.GetBFS());
   if (p_list.Contains(cbfs)) {
@@ -173,12 +107,10 @@ bool OnBFS(const StrategySupport &p_support,
     }
   }
   
-  PrintProfile(std::cout, "NE", profile);
-  if (g_printDetail) {
-    PrintProfileDetail(std::cout, profile);
-  }
+  p_observer.OnProfile(profile);
 
-  if (g_stopAfter > 0 && p_list.Length() >= g_stopAfter) {
+  if ((p_stopAfter > 0 && p_list.Length() >= p_stopAfter) ||
+      p_observer.IsCancelled()) {
     throw EquilibriumLimitReachedNfg();
   }
 
@@ -195,15 +127,16 @@ bool OnBFS(const StrategySupport &p_support,
 template <class T> void AllLemke(const StrategySupport &p_support,
 				 int j, LHTableau<T> &B,
 				 List<BFS<T> > &p_list,
-				 int depth)
+				 int depth, int p_stopAfter, int p_maxDepth,
+				 NashObserver &p_observer)
 {
-  if (g_maxDepth != 0 && depth > g_maxDepth) {
+  if (p_maxDepth != 0 && depth > p_maxDepth) {
     return;
   }
 
   // On the initial depth=0 call, the CBFS we are at is the extraneous
   // solution.
-  if (depth > 0 && !OnBFS(p_support, p_list, B)) {
+  if (depth > 0 && !OnBFS(p_support, p_list, B, p_stopAfter, p_observer)) {
     return;
   }
   
@@ -211,13 +144,15 @@ template <class T> void AllLemke(const StrategySupport &p_support,
     if (i != j)  {
       LHTableau<T> Bcopy(B);
       Bcopy.LemkePath(i);
-      AllLemke(p_support, i, Bcopy, p_list, depth+1);
+      AllLemke(p_support, i, Bcopy, p_list, depth+1,
+	       p_stopAfter, p_maxDepth, p_observer);
     }
   }
 }
 
 template <class T>
-void SolveStrategic(const Game &p_game)
+void LcpStrategySolve(const Game &p_game, int p_stopAfter, int p_maxDepth,
+		      NashObserver &p_observer)
 {
   StrategySupport support(p_game);
   List<BFS<T> > bfsList;
@@ -229,18 +164,19 @@ void SolveStrategic(const Game &p_game)
     Vector<T> b2 = Make_b2<T>(support);
     LHTableau<T> B(A1, A2, b1, b2);
 
-    if (g_stopAfter != 1) {
-      try {
-	AllLemke(support, 0, B, bfsList, 0);
+    try {
+      if (p_stopAfter != 1) {
+	AllLemke(support, 0, B, bfsList, 0, p_stopAfter, p_maxDepth,
+		 p_observer);
       }
-      catch (EquilibriumLimitReachedNfg &) {
-	// This pseudo-exception requires no additional action;
-	// bfsList will contain the list of equilibria found
+      else  {
+	B.LemkePath(1);
+	OnBFS(support, bfsList, B, p_stopAfter, p_observer);
       }
     }
-    else  {
-      B.LemkePath(1);
-      OnBFS(support, bfsList, B);
+    catch (EquilibriumLimitReachedNfg &) {
+      // This pseudo-exception requires no additional action;
+      // bfsList will contain the list of equilibria found
     }
 
     return;
@@ -252,7 +188,9 @@ void SolveStrategic(const Game &p_game)
   }
 }
 
-template void SolveStrategic<double>(const Game &);
-template void SolveStrategic<Rational>(const Game &);
+template void LcpStrategySolve<double>(const Game &, int, int,
+				       NashObserver &);
+template void LcpStrategySolve<Rational>(const Game &, int, int,
+					 NashObserver &);
 
 
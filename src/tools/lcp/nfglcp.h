@@ -0,0 +1,40 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2010, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/tools/lcp/nfglcp.h
+// Compute Nash equilibria via Lemke-Howson algorithm
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef NFGLCP_H
+#define NFGLCP_H
+
+#include "libgambit/libgambit.h"
+#include "libgambit/nash.h"
+
+// Compute equilibria of the two-player strategic game p_game by
+// following Lemke-Howson paths, passing each to the observer as it is
+// found.  Stops after p_stopAfter equilibria (if positive), and follows
+// paths to a depth of at most p_maxDepth (if positive).  With
+// p_stopAfter equal to one, only the path from the first strategy of
+// player 1 is followed.
+template <class T>
+void LcpStrategySolve(const Gambit::Game &p_game,
+		      int p_stopAfter, int p_maxDepth,
+		      Gambit::NashObserver &p_observer);
+
+#endif  // NFGLCP_H
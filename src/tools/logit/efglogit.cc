@@ -43,8 +43,10 @@ public:
 
   virtual double Value(const LogBehavProfile<double> &p_point,
 		       double p_lambda) = 0;
+  // p_diffValues holds the derivatives of the values of the actions at
+  // the equation's information set; see LogBehavProfile::DiffActionValues()
   virtual void Gradient(const LogBehavProfile<double> &p_point, 
-			double p_lambda,
+			double p_lambda, const Matrix<double> &p_diffValues,
 			Vector<double> &p_gradient) = 0;
 };
 
@@ -67,7 +69,7 @@ public:
   double Value(const LogBehavProfile<double> &p_profile,
 	       double p_lambda);
   void Gradient(const LogBehavProfile<double> &p_profile, double p_lambda,
-		Vector<double> &p_gradient);
+		const Matrix<double> &p_diffValues, Vector<double> &p_gradient);
 };
 
 
@@ -84,6 +86,7 @@ double SumToOneEquation::Value(const LogBehavProfile<double> &p_profile,
 
 void SumToOneEquation::Gradient(const LogBehavProfile<double> &p_profile,
 				double p_lambda,
+				const Matrix<double> &p_diffValues,
 				Vector<double> &p_gradient)
 {
   int i = 1;
@@ -129,7 +132,7 @@ public:
   double Value(const LogBehavProfile<double> &p_profile, 
 	       double p_lambda);
   void Gradient(const LogBehavProfile<double> &p_profile, double p_lambda,
-		Vector<double> &p_gradient);
+		const Matrix<double> &p_diffValues, Vector<double> &p_gradient);
 };
 
 
@@ -145,6 +148,7 @@ double RatioEquation::Value(const LogBehavProfile<double> &p_profile,
 
 void RatioEquation::Gradient(const LogBehavProfile<double> &p_profile,
 			     double p_lambda,
+			     const Matrix<double> &p_diffValues,
 			     Vector<double> &p_gradient)
 {
   int i = 1;
@@ -166,11 +170,7 @@ void RatioEquation::Gradient(const LogBehavProfile<double> &p_profile,
 	}
 	else {   // infoset1 != infoset2
 	  p_gradient[i] = 
-	    -p_lambda * 
-	    (p_profile.DiffActionValue(m_infoset->GetAction(m_act),
-				       infoset->GetAction(act)) -
-	     p_profile.DiffActionValue(m_infoset->GetAction(1),
-				       infoset->GetAction(act)));
+	    -p_lambda * (p_diffValues(m_act, i) - p_diffValues(1, i));
 	}
       }
     }
@@ -186,18 +186,22 @@ void RatioEquation::Gradient(const LogBehavProfile<double> &p_profile,
 //------------------------------------------------------------------------------
 
 AgentQREPathTracer::AgentQREPathTracer(const MixedBehavProfile<double> &p_start) 
-  : m_start(p_start), m_fullGraph(true), m_decimals(6)
+  : m_start(p_start), m_stream(&std::cout), m_fullGraph(true), m_binary(false),
+    m_decimals(6), m_thinning(0.0), m_printedLength(-1.0), m_skipped(false)
 { 
   SetTargetParam(-1.0);
+  Array<int> blocks;
   for (int pl = 1; pl <= p_start.GetGame()->NumPlayers(); pl++) {
     GamePlayer player = p_start.GetGame()->GetPlayer(pl);
     for (int iset = 1; iset <= player->NumInfosets(); iset++) {
+      blocks.Append(player->GetInfoset(iset)->NumActions());
       m_equations.Append(new SumToOneEquation(p_start.GetGame(), pl, iset));
       for (int act = 2; act <= player->GetInfoset(iset)->NumActions(); act++) {
 	m_equations.Append(new RatioEquation(p_start.GetGame(), pl, iset, act));
       }
     }
   }
+  SetBlocks(blocks);
 }
 
 AgentQREPathTracer::~AgentQREPathTracer()
@@ -213,9 +217,14 @@ AgentQREPathTracer::~AgentQREPathTracer()
 
 void 
 AgentQREPathTracer::TraceAgentPath(const MixedBehavProfile<double> &p_start,
+				   std::ostream &p_stream,
 				   double p_startLambda, double p_maxLambda, 
 				   double p_omega)
 {
+  m_stream = &p_stream;
+  m_printedLength = -1.0;
+  m_skipped = false;
+
   Vector<double> x(p_start.Length() + 1);
   for (int i = 1; i <= p_start.Length(); i++) {
     x[i] = log(p_start[i]);
@@ -268,10 +277,20 @@ AgentQREPathTracer::GetJacobian(const Vector<double> &p_point,
   }
   double lambda = p_point[p_point.Length()];
 
-  for (int i = 1; i <= m_equations.Length(); i++) {
-    Vector<double> column(p_point.Length());
-    m_equations[i]->Gradient(profile, lambda, column);
-    p_matrix.SetColumn(i, column);
+  // The equations come in the order of the information sets, with
+  // one equation for each action; see the constructor
+  Vector<double> column(p_point.Length());
+  for (int pl = 1, i = 1; pl <= game->NumPlayers(); pl++) {
+    GamePlayer player = game->GetPlayer(pl);
+    for (int iset = 1; iset <= player->NumInfosets(); iset++) {
+      GameInfoset infoset = player->GetInfoset(iset);
+      Matrix<double> diffValues(infoset->NumActions(), profile.Length());
+      profile.DiffActionValues(infoset, diffValues);
+      for (int act = 1; act <= infoset->NumActions(); act++, i++) {
+	m_equations[i]->Gradient(profile, lambda, diffValues, column);
+	p_matrix.SetColumn(i, column);
+      }
+    }
   }
 }
 
@@ -285,6 +304,20 @@ AgentQREPathTracer::PrintProfile(std::ostream &p_stream,
 				 const Vector<double> &x,
 				 bool p_isTerminal)
 {
+  if (m_binary) {
+    // A record is the number of doubles following, negated for the
+    // terminal point, then lambda and the profile
+    Array<double> values(x.Length());
+    values[1] = x[x.Length()];
+    for (int i = 1; i < x.Length(); i++) {
+      values[i+1] = exp(x[i]);
+    }
+    int count = (p_isTerminal) ? -values.Length() : values.Length();
+    p_stream.write((const char *) &count, sizeof(int));
+    p_stream.write((const char *) &values[1], values.Length() * sizeof(double));
+    return;
+  }
+
   p_stream.setf(std::ios::fixed);
   // By convention, we output lambda first
   if (!p_isTerminal) {
@@ -306,9 +339,27 @@ void
 AgentQREPathTracer::OnStep(const Vector<double> &x,
 			   bool p_isTerminal = false)
 {
-  if ((m_fullGraph && !p_isTerminal) || (!m_fullGraph && p_isTerminal)) {
-    PrintProfile(std::cout, x, p_isTerminal);
+  if (!m_fullGraph) {
+    if (p_isTerminal) {
+      PrintProfile(*m_stream, x, true);
+    }
+    return;
+  }
+
+  if (!p_isTerminal) {
+    if (m_thinning > 0.0 && m_printedLength >= 0.0 &&
+	GetPathLength() - m_printedLength < m_thinning) {
+      m_skipped = true;
+      return;
+    }
+  }
+  else if (!m_skipped) {
+    return;
   }
+  // When thinning, the last point reached is always shown
+  PrintProfile(*m_stream, x, false);
+  m_printedLength = GetPathLength();
+  m_skipped = false;
 }
 
 
@@ -35,6 +35,7 @@ public:
 
   void 
   TraceAgentPath(const MixedBehavProfile<double> &p_start,
+		 std::ostream &p_stream,
 		 double p_startLambda, double p_maxLambda, double p_omega);
 
   void SetFullGraph(bool p_fullGraph) { m_fullGraph = p_fullGraph; }
@@ -43,6 +44,15 @@ public:
   void SetDecimals(int p_decimals) { m_decimals = p_decimals; }
   int GetDecimals(void) const { return m_decimals; }
 
+  // In binary mode, each point is written as a record of doubles; see
+  // PrintProfile()
+  void SetBinary(bool p_binary) { m_binary = p_binary; }
+  bool IsBinary(void) const { return m_binary; }
+
+  // Print only points at least this far apart along the path
+  void SetThinning(double p_thinning) { m_thinning = p_thinning; }
+  double GetThinning(void) const { return m_thinning; }
+
 protected:
   virtual void OnStep(const Vector<double> &, bool);
 
@@ -56,8 +66,11 @@ protected:
 private:
   MixedBehavProfile<double> m_start;
   Array<Equation *> m_equations;
-  bool m_fullGraph;
+  std::ostream *m_stream;
+  bool m_fullGraph, m_binary;
   int m_decimals;
+  double m_thinning, m_printedLength;
+  bool m_skipped;
 
   void PrintProfile(std::ostream &p_stream, const Vector<double> &x,
 		    bool p_isTerminal);
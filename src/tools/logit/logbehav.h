@@ -81,6 +81,10 @@ protected:
   //@{
   void GetPayoff(GameNodeRep *, const T &, int, T &) const;
   
+  void DiffNodeValues(const GameNode &node, int player, int row,
+		      const T &weight, const PVector<int> &first,
+		      Matrix<T> &derivs) const;
+
   void ComputeSolutionDataPass2(const GameNode &node) const;
   void ComputeSolutionDataPass1(const GameNode &node) const;
   void ComputeSolutionData(void) const;
@@ -195,6 +199,7 @@ public:
 		   const GameAction &oppAction) const;
   T DiffNodeValue(const GameNode &node, const GamePlayer &player,
 		  const GameAction &oppAction) const;
+  void DiffActionValues(const GameInfoset &infoset, Matrix<T> &derivs) const;
 
   //@}
 };
@@ -23,12 +23,29 @@
 
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <cstdlib>
 #include <unistd.h>
+#ifdef __MINGW32__
+#include <io.h>
+#include <fcntl.h>
+#endif  // __MINGW32__
 #include "libgambit/libgambit.h"
+#include "tools/workers/workers.h"
 #include "efglogit.h"
 #include "nfglogit.h"
 
+double g_maxLambda = 1000000.0;
+double g_maxDecel = 1.1;
+double g_hStart = 0.03;
+double g_targetLambda = -1.0;
+bool g_fullGraph = true;
+int g_decimals = 6;
+bool g_quasiNewton = false, g_verbose = false, g_binary = false;
+double g_thinning = 0.0;
+int g_numWorkers = 1;
+Gambit::List<double> g_queryLambdas;
+
 
 void PrintBanner(std::ostream &p_stream)
 {
@@ -49,9 +66,25 @@ void PrintHelp(char *progname)
   std::cerr << "  -s STEP          initial stepsize (default is .03)\n";
   std::cerr << "  -a ACCEL         maximum acceleration (default is 1.1)\n";
   std::cerr << "  -m MAXLAMBDA     stop when reaching MAXLAMBDA (default is 1000000)\n";
-  std::cerr << "  -l LAMBDA        compute QRE at `lambda` accurately\n";
+  std::cerr << "  -l LAMBDA        compute QRE at `lambda` accurately; with -c,\n";
+  std::cerr << "                   several values may be separated by commas\n";
+  std::cerr << "  -u               update the Jacobian by quasi-Newton (Broyden)\n";
+  std::cerr << "                   steps, instead of evaluating it at each step\n";
+  std::cerr << "  -v               report statistics on the path traced\n";
+  std::cerr << "  -b               write points as binary records\n";
+  std::cerr << "  -t DIST          print only points at least DIST apart\n";
+  std::cerr << "                   along the branch\n";
   std::cerr << "  -L FILE          compute maximum likelihood estimates;\n";
-  std::cerr << "                   read strategy frequencies from FILE\n";
+  std::cerr << "                   read strategy frequencies from FILE,\n";
+  std::cerr << "                   one data set per line\n";
+  std::cerr << "  -p FILE          trace the branch through each of the points\n";
+  std::cerr << "                   in FILE, one per line\n";
+  std::cerr << "  -j PROCESSES     trace the branches for several data sets or\n";
+  std::cerr << "                   points in PROCESSES worker processes\n";
+  std::cerr << "  -w FILE          write the path traced, with its tangents, to FILE\n";
+  std::cerr << "  -c FILE          start from the path in FILE, written by -w:\n";
+  std::cerr << "                   compute the QRE at the values given by -l,\n";
+  std::cerr << "                   or else continue the path to MAXLAMBDA\n";
   std::cerr << "  -h               print this help message\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
   std::cerr << "  -e               print only the terminal equilibrium\n";
@@ -59,6 +92,21 @@ void PrintHelp(char *progname)
   exit(1);
 }
 
+//
+// Report the effort spent in tracing the path, in particular the
+// number of evaluations of the Jacobian per unit of path length
+//
+void PrintStatistics(std::ostream &p_stream, const PathTracer &p_tracer)
+{
+  p_stream << "Steps: " << p_tracer.NumSteps() << std::endl;
+  p_stream << "Jacobian evaluations: " << p_tracer.NumJacobians() << std::endl;
+  p_stream << "Path length: " << p_tracer.GetPathLength() << std::endl;
+  if (p_tracer.GetPathLength() > 0.0) {
+    p_stream << "Jacobian evaluations per unit length: ";
+    p_stream << p_tracer.NumJacobians() / p_tracer.GetPathLength() << std::endl;
+  }
+}
+
 //
 // Read in a comma-separated values list of observed data values
 //
@@ -81,40 +129,209 @@ bool ReadProfile(std::istream &p_stream, Gambit::Array<double> &p_profile)
   return true;
 }
 
+//
+// Read in a list of profiles of the given length, one per line,
+// skipping blank lines
+//
+void ReadProfiles(std::istream &p_stream, int p_length,
+		  Gambit::List<Gambit::Array<double> > &p_profiles)
+{
+  std::string line;
+  while (std::getline(p_stream, line)) {
+    if (line.find_first_not_of(" \t\r") == std::string::npos) {
+      continue;
+    }
+    std::istringstream lineStream(line);
+    Gambit::Array<double> profile(p_length);
+    if (ReadProfile(lineStream, profile)) {
+      p_profiles.Append(profile);
+    }
+  }
+}
+
+//
+// Write out the text, prefixing each non-blank line with the tag,
+// if the tag is positive
+//
+void WriteTagged(std::ostream &p_stream, const std::string &p_text, int p_tag)
+{
+  if (p_tag <= 0) {
+    // Binary output passes through unchanged
+    p_stream.write(p_text.data(), p_text.length());
+    return;
+  }
+  std::istringstream text(p_text);
+  std::string line;
+  while (std::getline(text, line)) {
+    if (p_tag > 0 && line != "") {
+      p_stream << p_tag << ",";
+    }
+    p_stream << line << std::endl;
+  }
+}
+
+template <class Tracer> void ConfigureTracer(Tracer &p_tracer)
+{
+  p_tracer.SetMaxDecel(g_maxDecel);
+  p_tracer.SetStepsize(g_hStart);
+  p_tracer.SetFullGraph(g_fullGraph);
+  p_tracer.SetTargetParam(g_targetLambda);
+  p_tracer.SetDecimals(g_decimals);
+  p_tracer.SetQuasiNewton(g_quasiNewton);
+  p_tracer.SetBinary(g_binary);
+  p_tracer.SetThinning(g_thinning);
+}
+
+//
+// Traces the branches of the correspondence for a strategic game.
+// A batch consists either of many data sets for maximum likelihood
+// estimation, each of whose branches starts at the centroid, or of
+// many points, through each of which the branch is traced in both
+// directions.  The branches are independent, and are traced in
+// separate worker processes when more than one is requested.  When the
+// batch has more than one member, each line of output is tagged with
+// the index of the data set or point it belongs to.
+//
+class StrategicPathTask : public IndexedTask {
+private:
+  Gambit::Game m_game;
+  Gambit::List<Gambit::Array<double> > m_frequencies, m_starts;
+
+public:
+  StrategicPathTask(const Gambit::Game &p_game,
+		    const Gambit::List<Gambit::Array<double> > &p_frequencies,
+		    const Gambit::List<Gambit::Array<double> > &p_starts)
+    : m_game(p_game), m_frequencies(p_frequencies), m_starts(p_starts) { }
+  virtual ~StrategicPathTask() { }
+
+  int NumTasks(void) const
+  { return std::max(1, std::max(m_frequencies.Length(), m_starts.Length())); }
+
+  void Run(int p_index, std::ostream &p_stream);
+};
+
+void StrategicPathTask::Run(int p_index, std::ostream &p_stream)
+{
+  std::ostringstream output, statistics;
+
+  if (m_starts.Length() == 0) {
+    Gambit::MixedStrategyProfile<double> start(m_game);
+    StrategicQREPathTracer tracer(start);
+    ConfigureTracer(tracer);
+    if (m_frequencies.Length() > 0) {
+      tracer.SetMLEFrequencies(m_frequencies[p_index]);
+    }
+    tracer.TraceStrategicPath(start, output, 0.0, g_maxLambda, 1.0);
+    if (g_verbose) {
+      PrintStatistics(statistics, tracer);
+    }
+  }
+  else {
+    const Gambit::Array<double> &profile = m_starts[p_index];
+    Gambit::MixedStrategyProfile<double> start(m_game);
+    for (int i = 1; i <= start.Length(); i++) {
+      start[i] = profile[i+1];
+    }
+    StrategicQREPathTracer tracer1(start);
+    ConfigureTracer(tracer1);
+    tracer1.TraceStrategicPath(start, output, profile[1], g_maxLambda, 1.0);
+    if (g_verbose) {
+      PrintStatistics(statistics, tracer1);
+    }
+    tracer1.PrintBreak(output);
+    StrategicQREPathTracer tracer2(start);
+    ConfigureTracer(tracer2);
+    tracer2.TraceStrategicPath(start, output, profile[1], g_maxLambda, -1.0);
+    if (g_verbose) {
+      PrintStatistics(statistics, tracer2);
+    }
+  }
+
+  int tag = (NumTasks() > 1) ? p_index : 0;
+  WriteTagged(p_stream, output.str(), tag);
+  WriteTagged(std::cerr, statistics.str(), tag);
+}
+
+//
+// Traces the branch from the centroid of a strategic game, or uses a
+// path recorded by an earlier run, read from p_readFile.  A recorded path
+// is either continued, or used to compute the equilibria at the values of
+// lambda requested without tracing again.  If p_writeFile is given, the
+// path is written there at the end.
+//
+int RunRecordedPath(const Gambit::Game &p_game, const std::string &p_readFile,
+		    const std::string &p_writeFile)
+{
+  Gambit::MixedStrategyProfile<double> start(p_game);
+  StrategicQREPathTracer tracer(start);
+  ConfigureTracer(tracer);
+  tracer.SetRecordPath(true);
+
+  int status = 0;
+  if (p_readFile != "") {
+    std::ifstream pathData(p_readFile.c_str());
+    if (!tracer.ReadPath(pathData, start.Length() + 1)) {
+      std::cerr << "Error: No path for this game read from " << p_readFile << ".\n";
+      return 1;
+    }
+    if (g_queryLambdas.Length() > 0) {
+      for (int i = 1; i <= g_queryLambdas.Length(); i++) {
+	if (!tracer.EvaluateStrategicPath(std::cout, g_queryLambdas[i])) {
+	  std::cerr << "Error: Could not compute QRE at lambda = ";
+	  std::cerr << g_queryLambdas[i] << " from the path in " << p_readFile << ".\n";
+	  status = 1;
+	}
+      }
+    }
+    else {
+      tracer.ResumeStrategicPath(std::cout, g_maxLambda);
+    }
+  }
+  else {
+    tracer.TraceStrategicPath(start, std::cout, 0.0, g_maxLambda, 1.0);
+  }
+
+  if (p_writeFile != "") {
+    std::ofstream pathData(p_writeFile.c_str());
+    tracer.WritePath(pathData);
+    if (!pathData.good()) {
+      std::cerr << "Error: Could not write path to " << p_writeFile << ".\n";
+      return 1;
+    }
+  }
+  if (g_verbose) {
+    PrintStatistics(std::cerr, tracer);
+  }
+  return status;
+}
 
 int main(int argc, char *argv[])
 {
   opterr = 0;
 
   bool quiet = false, useStrategic = false;
-  double maxLambda = 1000000.0;
-  std::string mleFile = "", startFile = "";
-  double maxDecel = 1.1;
-  double hStart = 0.03;
-  double targetLambda = -1.0;
-  bool fullGraph = true;
-  int decimals = 6;
+  std::string mleFile = "", startFile = "", readPathFile = "", writePathFile = "";
 
   int c;
-  while ((c = getopt(argc, argv, "d:s:a:m:qehSL:p:l:")) != -1) {
+  while ((c = getopt(argc, argv, "d:s:a:m:qehSL:p:l:uvj:c:w:bt:")) != -1) {
     switch (c) {
     case 'q':
       quiet = true;
       break;
     case 'd':
-      decimals = atoi(optarg);
+      g_decimals = atoi(optarg);
       break;
     case 's':
-      hStart = atof(optarg);
+      g_hStart = atof(optarg);
       break;
     case 'a':
-      maxDecel = atof(optarg);
+      g_maxDecel = atof(optarg);
       break;
     case 'm':
-      maxLambda = atof(optarg);
+      g_maxLambda = atof(optarg);
       break;
     case 'e':
-      fullGraph = false;
+      g_fullGraph = false;
       break;
     case 'h':
       PrintHelp(argv[0]);
@@ -128,8 +345,41 @@ int main(int argc, char *argv[])
     case 'p':
       startFile = optarg;
       break;
-    case 'l':
-      targetLambda = atof(optarg);
+    case 'l': {
+      std::string values(optarg);
+      std::string::size_type pos = 0;
+      while (pos != std::string::npos) {
+	std::string::size_type comma = values.find(',', pos);
+	g_queryLambdas.Append(atof(values.substr(pos, comma - pos).c_str()));
+	pos = (comma == std::string::npos) ? comma : comma + 1;
+      }
+      g_targetLambda = g_queryLambdas[1];
+      break;
+    }
+    case 'c':
+      readPathFile = optarg;
+      break;
+    case 'w':
+      writePathFile = optarg;
+      break;
+    case 'b':
+      g_binary = true;
+      break;
+    case 't':
+      g_thinning = atof(optarg);
+      break;
+    case 'u':
+      g_quasiNewton = true;
+      break;
+    case 'v':
+      g_verbose = true;
+      break;
+    case 'j':
+      g_numWorkers = atoi(optarg);
+      if (g_numWorkers < 1) {
+	std::cerr << argv[0] << ": Number of processes must be at least one.\n";
+	return 1;
+      }
       break;
     case '?':
       if (isprint(optopt)) {
@@ -148,66 +398,68 @@ int main(int argc, char *argv[])
     PrintBanner(std::cerr);
   }
 
+#ifdef __MINGW32__
+  if (g_binary) {
+    _setmode(_fileno(stdout), _O_BINARY);
+  }
+#endif  // __MINGW32__
+
+  if (g_queryLambdas.Length() > 1 && readPathFile == "") {
+    std::cerr << argv[0] << ": Several values of lambda require a path (-c).\n";
+    return 1;
+  }
+
   try {
-    Gambit::Array<double> frequencies;
     Gambit::Game game = Gambit::ReadGame(std::cin);
 
-    if (mleFile != "" && (!game->IsTree() || useStrategic)) {
-      frequencies = Gambit::Array<double>(game->MixedProfileLength());
-      std::ifstream mleData(mleFile.c_str());
-      ReadProfile(mleData, frequencies);
-    }
-  
-
     if (!game->IsTree() || useStrategic) {
       game->BuildComputedValues();
 
-      if (startFile == "") {
-	Gambit::MixedStrategyProfile<double> start(game);
-	StrategicQREPathTracer tracer(start);
-	tracer.SetMaxDecel(maxDecel);
-	tracer.SetStepsize(hStart);
-	tracer.SetFullGraph(fullGraph);
-	tracer.SetTargetParam(targetLambda);
-	tracer.SetDecimals(decimals);
-	tracer.SetMLEFrequencies(frequencies);
-	tracer.TraceStrategicPath(start, 0.0, maxLambda, 1.0);
+      if (readPathFile != "" || writePathFile != "") {
+	if (mleFile != "" || startFile != "") {
+	  std::cerr << "Error: Paths cannot be read or written with -L or -p.\n";
+	  return 1;
+	}
+	return RunRecordedPath(game, readPathFile, writePathFile);
       }
-      else {
-	Gambit::Array<double> profile(game->MixedProfileLength() + 1);
+
+      Gambit::List<Gambit::Array<double> > frequencies, starts;
+      if (startFile != "") {
 	std::ifstream startData(startFile.c_str());
-	ReadProfile(startData, profile);
-	Gambit::MixedStrategyProfile<double> start(game);
-	for (int i = 1; i <= start.Length(); i++) {
-	  start[i] = profile[i+1];
+	ReadProfiles(startData, game->MixedProfileLength() + 1, starts);
+	if (starts.Length() == 0) {
+	  std::cerr << "Error: No starting points read from " << startFile << ".\n";
+	  return 1;
+	}
+      }
+      else if (mleFile != "") {
+	std::ifstream mleData(mleFile.c_str());
+	ReadProfiles(mleData, game->MixedProfileLength(), frequencies);
+	if (frequencies.Length() == 0) {
+	  std::cerr << "Error: No frequencies read from " << mleFile << ".\n";
+	  return 1;
 	}
-	StrategicQREPathTracer tracer1(start);
-	tracer1.SetMaxDecel(maxDecel);
-	tracer1.SetStepsize(hStart);
-	tracer1.SetFullGraph(fullGraph);
-	tracer1.SetTargetParam(targetLambda);
-	tracer1.SetDecimals(decimals);
-	tracer1.TraceStrategicPath(start, profile[1], maxLambda, 1.0);
-	std::cout << std::endl;
-	StrategicQREPathTracer tracer2(start);
-	tracer2.SetMaxDecel(maxDecel);
-	tracer2.SetStepsize(hStart);
-	tracer2.SetFullGraph(fullGraph);
-	tracer2.SetTargetParam(targetLambda);
-	tracer2.SetDecimals(decimals);
-	tracer2.TraceStrategicPath(start, profile[1], maxLambda, -1.0);
       }
 
+      StrategicPathTask task(game, frequencies, starts);
+      if (g_binary && task.NumTasks() > 1) {
+	std::cerr << "Error: Binary output is for one branch at a time.\n";
+	return 1;
+      }
+      RunWorkers(task, task.NumTasks(), g_numWorkers, std::cout);
     }
     else {
+      if (readPathFile != "" || writePathFile != "") {
+	std::cerr << "Error: Paths can only be read or written for strategic games (-S).\n";
+	return 1;
+      }
       MixedBehavProfile<double> start(game);
       AgentQREPathTracer tracer(start);
-      tracer.SetMaxDecel(maxDecel);
-      tracer.SetStepsize(hStart);
-      tracer.SetFullGraph(fullGraph);
-      tracer.SetTargetParam(targetLambda);
-      tracer.SetDecimals(decimals);
-      tracer.TraceAgentPath(start, 0.0, maxLambda, 1.0);
+      ConfigureTracer(tracer);
+      tracer.TraceAgentPath(start, std::cout, 0.0, g_maxLambda, 1.0);
+      if (g_verbose) {
+	PrintStatistics(std::cerr, tracer);
+      }
     }
     return 0;
   }
@@ -215,6 +467,10 @@ int main(int argc, char *argv[])
     std::cerr << "Error: Game not in a recognized format.\n";
     return 1;
   }
+  catch (WorkerException &e) {
+    std::cerr << "Error: " << e.what() << ".\n";
+    return 1;
+  }
   catch (...) {
     std::cerr << "Error: An internal error occurred.\n";
     return 1;
@@ -26,8 +26,12 @@
 #include <unistd.h>
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <iomanip>
+#include <vector>
+#include <algorithm>
 #include "libgambit/libgambit.h"
+#include "tools/workers/workers.h"
 
 //
 // This program attempts to identify the quantal response equilibria
@@ -40,30 +44,268 @@
 // -f #:  Number of decimal places to display in outputting profiles
 //        (Default is 6)
 // -n #:  Number of random starting points to generate (default is 100)
-// -l #:  Value of lambda (required)
+// -l #:  Value of lambda (required).  Several values may be given,
+//        separated by commas, and each may be a range FIRST:LAST:STEP;
+//        the dynamics are then run from each starting point for each
+//        value, and each QRE is output with its value of lambda.
 // -t #:  Tolerance for stopping criterion (parameter is exponent to
 //        10^(-k), default is 6).
+// -j #:  Number of worker processes among which to divide the
+//        random starting points (default is 1)
 // 
 
 int g_numDecimals = 6;
 
-void LogitBR(const Gambit::MixedStrategyProfile<double> &p_profile, double p_lambda,
-	     Gambit::MixedStrategyProfile<double> &p_br)
+//
+// Runs the dynamics for a batch of members, each a starting profile
+// together with a value of lambda, all at once.  The profiles are held
+// with one row per strategy and one column per member, so that the
+// innermost loops, which are over members, run over contiguous memory.
+// The strategy values of all members are obtained in one pass over the
+// payoff table, which is copied out of the game in advance.  As members
+// converge, they are swapped out of the columns still being iterated.
+//
+class LogitDynamicsBatch {
+private:
+  int m_numPlayers, m_length, m_numContingencies;
+  std::vector<int> m_first, m_numStrats;   // strategies of each player
+  std::vector<double> m_payoffs;     // payoffs, by contingency then player
+
+  int m_capacity, m_active;
+  std::vector<double> m_profiles, m_values, m_responses;
+  std::vector<double> m_lambdas;
+  std::vector<int> m_member;         // member in each column
+  std::vector<std::vector<double> > m_results;
+  std::vector<bool> m_converged;
+  double m_delta, m_tol;
+
+  double *Row(std::vector<double> &p_matrix, int p_row)
+  { return &p_matrix[p_row * m_capacity]; }
+
+  void ComputeValues(void);
+  void ComputeResponses(void);
+  void Retire(int p_column);
+
+public:
+  LogitDynamicsBatch(const Gambit::Game &p_game, double p_delta, double p_tol);
+
+  /// Add a member; returns its index, starting from zero
+  int AddMember(const Gambit::MixedStrategyProfile<double> &p_start,
+		double p_lambda);
+
+  /// Carry out one step for each member not yet converged;
+  /// returns false once all members have converged
+  bool Step(void);
+  /// Carry out steps until all members have converged
+  void Run(void) { while (Step()); }
+
+  /// The current profile of the member, or its limit once converged
+  void GetProfile(int p_member, Gambit::MixedStrategyProfile<double> &) const;
+};
+
+LogitDynamicsBatch::LogitDynamicsBatch(const Gambit::Game &p_game,
+				       double p_delta, double p_tol)
+  : m_numPlayers(p_game->NumPlayers()), m_length(p_game->MixedProfileLength()),
+    m_numContingencies(1), m_capacity(0), m_active(0),
+    m_delta(p_delta), m_tol(p_tol)
 {
-  Gambit::Game nfg = p_profile.GetGame();
+  for (int pl = 1, first = 0; pl <= m_numPlayers; pl++) {
+    m_first.push_back(first);
+    m_numStrats.push_back(p_game->GetPlayer(pl)->NumStrategies());
+    first += m_numStrats.back();
+    m_numContingencies *= m_numStrats.back();
+  }
 
-  for (int pl = 1; pl <= nfg->NumPlayers(); pl++) {
-    Gambit::Array<double> lval(nfg->GetPlayer(pl)->NumStrategies());
-    double sum = 0.0;
+  // Copy the payoffs, indexing contingencies with the first player's
+  // strategy varying fastest
+  m_payoffs.resize(m_numContingencies * m_numPlayers);
+  Gambit::StrategySupport support(p_game);
+  for (Gambit::StrategyIterator iter(support); !iter.AtEnd(); iter++) {
+    int index = 0;
+    for (int pl = m_numPlayers; pl >= 1; pl--) {
+      index = index * m_numStrats[pl-1] + (*iter).GetStrategy(pl)->GetNumber() - 1;
+    }
+    for (int pl = 1; pl <= m_numPlayers; pl++) {
+      m_payoffs[index * m_numPlayers + pl - 1] = (*iter).GetPayoff<double>(pl);
+    }
+  }
+}
 
-    for (int st = 1; st <= nfg->GetPlayer(pl)->NumStrategies(); st++) {
-      lval[st] = exp(p_lambda * p_profile.GetStrategyValue(nfg->GetPlayer(pl)->GetStrategy(st)));
-      sum += lval[st];
+int
+LogitDynamicsBatch::AddMember(const Gambit::MixedStrategyProfile<double> &p_start,
+			      double p_lambda)
+{
+  // Columns are laid out by capacity, so grow by copying into a
+  // wider layout
+  if (m_active == m_capacity) {
+    int capacity = std::max(8, 2 * m_capacity);
+    std::vector<double> profiles(m_length * capacity);
+    for (int i = 0; i < m_length; i++) {
+      std::copy(Row(m_profiles, i), Row(m_profiles, i) + m_active,
+		&profiles[i * capacity]);
     }
+    m_profiles.swap(profiles);
+    m_capacity = capacity;
+    m_values.resize(m_length * m_capacity);
+    m_responses.resize(m_length * m_capacity);
+    m_lambdas.resize(m_capacity);
+    m_member.resize(m_capacity);
+  }
+
+  int member = m_results.size();
+  for (int i = 0; i < m_length; i++) {
+    Row(m_profiles, i)[m_active] = p_start[i+1];
+  }
+  m_lambdas[m_active] = p_lambda;
+  m_member[m_active] = member;
+  m_results.push_back(std::vector<double>());
+  m_converged.push_back(false);
+  m_active++;
+  return member;
+}
 
-    for (int st = 1; st <= nfg->GetPlayer(pl)->NumStrategies(); st++) {
-      p_br[nfg->GetPlayer(pl)->GetStrategy(st)] = lval[st] / sum;
+//
+// The value of a strategy is the sum over the contingencies in which it
+// is played of the payoff times the probability of the others' strategies.
+// For each contingency, the products of the probabilities of the
+// strategies of the players before and after each player are formed
+// for all members at once.
+//
+void LogitDynamicsBatch::ComputeValues(void)
+{
+  std::fill(m_values.begin(), m_values.end(), 0.0);
+  std::vector<double> before(m_numPlayers * m_capacity), after(m_capacity);
+  std::vector<int> strat(m_numPlayers, 0);
+
+  for (int c = 0; c < m_numContingencies; c++) {
+    const double *payoff = &m_payoffs[c * m_numPlayers];
+
+    double *prod = &before[0];
+    for (int b = 0; b < m_active; b++)  prod[b] = 1.0;
+    for (int pl = 1; pl < m_numPlayers; pl++) {
+      const double *prev = &before[(pl - 1) * m_capacity];
+      const double *prob = Row(m_profiles, m_first[pl-1] + strat[pl-1]);
+      prod = &before[pl * m_capacity];
+      for (int b = 0; b < m_active; b++)  prod[b] = prev[b] * prob[b];
     }
+
+    for (int b = 0; b < m_active; b++)  after[b] = 1.0;
+    for (int pl = m_numPlayers - 1; pl >= 0; pl--) {
+      int row = m_first[pl] + strat[pl];
+      if (payoff[pl] != 0.0) {
+	double *value = Row(m_values, row);
+	const double *prev = &before[pl * m_capacity];
+	for (int b = 0; b < m_active; b++) {
+	  value[b] += payoff[pl] * prev[b] * after[b];
+	}
+      }
+      if (pl > 0) {
+	const double *prob = Row(m_profiles, row);
+	for (int b = 0; b < m_active; b++)  after[b] *= prob[b];
+      }
+    }
+
+    for (int pl = 0; pl < m_numPlayers && ++strat[pl] == m_numStrats[pl]; pl++) {
+      strat[pl] = 0;
+    }
+  }
+}
+
+//
+// The logit responses, computed by subtracting the largest exponent
+// before exponentiating, so that large values of lambda do not overflow.
+//
+void LogitDynamicsBatch::ComputeResponses(void)
+{
+  std::vector<double> largest(m_capacity), sum(m_capacity);
+
+  for (int pl = 0; pl < m_numPlayers; pl++) {
+    int first = m_first[pl], last = m_first[pl] + m_numStrats[pl];
+
+    std::copy(Row(m_values, first), Row(m_values, first) + m_active,
+	      largest.begin());
+    for (int row = first + 1; row < last; row++) {
+      const double *value = Row(m_values, row);
+      for (int b = 0; b < m_active; b++) {
+	largest[b] = std::max(largest[b], value[b]);
+      }
+    }
+
+    std::fill(sum.begin(), sum.end(), 0.0);
+    for (int row = first; row < last; row++) {
+      const double *value = Row(m_values, row);
+      double *response = Row(m_responses, row);
+      for (int b = 0; b < m_active; b++) {
+	response[b] = exp(m_lambdas[b] * (value[b] - largest[b]));
+	sum[b] += response[b];
+      }
+    }
+
+    for (int row = first; row < last; row++) {
+      double *response = Row(m_responses, row);
+      for (int b = 0; b < m_active; b++)  response[b] /= sum[b];
+    }
+  }
+}
+
+//
+// Record the profile in the column as the result for its member, and
+// replace it by the last active column
+//
+void LogitDynamicsBatch::Retire(int p_column)
+{
+  int last = m_active - 1;
+  std::vector<double> &result = m_results[m_member[p_column]];
+  result.resize(m_length);
+  for (int i = 0; i < m_length; i++) {
+    double *profile = Row(m_profiles, i);
+    result[i] = profile[p_column];
+    profile[p_column] = profile[last];
+  }
+  m_converged[m_member[p_column]] = true;
+  m_lambdas[p_column] = m_lambdas[last];
+  m_member[p_column] = m_member[last];
+  m_active--;
+}
+
+bool LogitDynamicsBatch::Step(void)
+{
+  if (m_active == 0)  return false;
+
+  ComputeValues();
+  ComputeResponses();
+
+  std::vector<double> distance(m_capacity, 0.0);
+  for (int i = 0; i < m_length; i++) {
+    double *profile = Row(m_profiles, i);
+    const double *response = Row(m_responses, i);
+    for (int b = 0; b < m_active; b++) {
+      profile[b] = profile[b] * (1.0 - m_delta) + response[b] * m_delta;
+      distance[b] = std::max(distance[b], fabs(profile[b] - response[b]));
+    }
+  }
+
+  // Retiring a column moves the last one into its place, so
+  // work downwards
+  for (int b = m_active - 1; b >= 0; b--) {
+    if (distance[b] <= m_tol)  Retire(b);
+  }
+  return (m_active > 0);
+}
+
+void LogitDynamicsBatch::GetProfile(int p_member,
+				    Gambit::MixedStrategyProfile<double> &p_profile) const
+{
+  if (m_converged[p_member]) {
+    for (int i = 0; i < m_length; i++) {
+      p_profile[i+1] = m_results[p_member][i];
+    }
+    return;
+  }
+  int column = std::find(m_member.begin(), m_member.begin() + m_active,
+			 p_member) - m_member.begin();
+  for (int i = 0; i < m_length; i++) {
+    p_profile[i+1] = m_profiles[i * m_capacity + column];
   }
 }
 
@@ -97,18 +339,6 @@ void PrintProfile(std::ostream &p_stream,
   p_stream << std::endl;
 }
 
-double Distance(const Gambit::MixedStrategyProfile<double> &a, const Gambit::MixedStrategyProfile<double> &b)
-{
-  double dist = 0.0;
-  for (int i = 1; i <= a.Length(); i++) {
-    if (fabs(a[i] - b[i]) > dist) {
-      dist = fabs(a[i] - b[i]);
-    }
-  }
-
-  return dist;
-} 
-
 bool ReadProfile(std::istream &p_stream, Gambit::Array<double> &p_profile)
 {
   for (int i = 1; i <= p_profile.Length(); i++) {
@@ -128,16 +358,107 @@ bool ReadProfile(std::istream &p_stream, Gambit::Array<double> &p_profile)
   return true;
 }
 
+//
+// Parse a comma-separated list of values of lambda, each of which may
+// be a range FIRST:LAST:STEP.  Returns false if the list is malformed.
+//
+bool ParseLambdas(const std::string &p_text, Gambit::List<double> &p_lambdas)
+{
+  std::istringstream text(p_text);
+  std::string item;
+  while (std::getline(text, item, ',')) {
+    std::istringstream fields(item);
+    double first, last, step;
+    char colon1, colon2;
+    if (!(fields >> first)) {
+      return false;
+    }
+    if (!(fields >> colon1)) {
+      p_lambdas.Append(first);
+      continue;
+    }
+    if (colon1 != ':' || !(fields >> last >> colon2 >> step) ||
+	colon2 != ':' || step <= 0.0) {
+      return false;
+    }
+    // Allow for rounding in reaching the last value
+    for (int i = 0; first + i * step <= last + 1.0e-9 * step; i++) {
+      p_lambdas.Append(first + i * step);
+    }
+  }
+  return (p_lambdas.Length() > 0);
+}
+
+//
+// Runs the dynamics from a block of the random starting points, for
+// each value of lambda.  The starting points are drawn in advance, so
+// that they do not depend on how they are divided among the workers.
+//
+class DynamicsTask : public IndexedTask {
+private:
+  Gambit::Game m_game;
+  Gambit::List<Gambit::MixedStrategyProfile<double> > m_starts;
+  Gambit::List<double> m_lambdas;
+  int m_blockSize;
+  double m_tol;
+
+public:
+  DynamicsTask(const Gambit::Game &p_game,
+	       const Gambit::List<Gambit::MixedStrategyProfile<double> > &p_starts,
+	       const Gambit::List<double> &p_lambdas,
+	       int p_blockSize, double p_tol)
+    : m_game(p_game), m_starts(p_starts), m_lambdas(p_lambdas),
+      m_blockSize(p_blockSize), m_tol(p_tol) { }
+  virtual ~DynamicsTask() { }
+
+  int NumTasks(void) const
+  { return (m_starts.Length() + m_blockSize - 1) / m_blockSize; }
+
+  void Run(int p_index, std::ostream &p_stream);
+};
+
+void DynamicsTask::Run(int p_index, std::ostream &p_stream)
+{
+  const double c_delta = .001;
+  int first = (p_index - 1) * m_blockSize + 1;
+  int last = std::min(m_starts.Length(), p_index * m_blockSize);
+
+  LogitDynamicsBatch batch(m_game, c_delta, m_tol);
+  for (int i = first; i <= last; i++) {
+    for (int j = 1; j <= m_lambdas.Length(); j++) {
+      batch.AddMember(m_starts[i], m_lambdas[j]);
+    }
+  }
+  batch.Run();
+
+  Gambit::MixedStrategyProfile<double> profile(m_game);
+  for (int i = first, member = 0; i <= last; i++) {
+    PrintProfile(p_stream, "start", m_starts[i]);
+    for (int j = 1; j <= m_lambdas.Length(); j++) {
+      batch.GetProfile(member++, profile);
+      if (m_lambdas.Length() == 1) {
+	PrintProfile(p_stream, "QRE", profile);
+      }
+      else {
+	std::ostringstream label;
+	label.setf(std::ios::fixed);
+	label << "QRE," << std::setprecision(g_numDecimals) << m_lambdas[j];
+	PrintProfile(p_stream, label.str(), profile);
+      }
+    }
+  }
+}
+
 int main(int argc, char *argv[])
 {
   int stopAfter = 100;
-  double lambda;
-  bool lambdaSpec = false;
+  Gambit::List<double> lambdas;
   double tol = 1.0e-6;
   std::string startFile = "";
+  int numWorkers = 1;
 
   int c;
-  while ((c = getopt(argc, argv, "f:n:l:t:p:")) != -1) {
+  while ((c = getopt(argc, argv, "f:n:l:t:p:j:")) != -1) {
     switch (c) {
     case 'f':
       g_numDecimals = atoi(optarg);
@@ -146,8 +467,10 @@ int main(int argc, char *argv[])
       stopAfter = atoi(optarg);
       break;
     case 'l':
-      lambda = atof(optarg);
-      lambdaSpec = true;
+      if (!ParseLambdas(optarg, lambdas)) {
+	std::cerr << argv[0] << ": Invalid value of lambda `" << optarg << "'.\n";
+	return 1;
+      }
       break;
     case 't':
       tol = pow(10.0, (double) -atoi(optarg));
@@ -155,6 +478,13 @@ int main(int argc, char *argv[])
     case 'p':
       startFile = optarg;
       break;
+    case 'j':
+      numWorkers = atoi(optarg);
+      if (numWorkers < 1) {
+	std::cerr << argv[0] << ": Number of processes must be at least one.\n";
+	return 1;
+      }
+      break;
     case '?':
       if (isprint(optopt)) {
 	std::cerr << argv[0] << ": Unknown option `-" << ((char) optopt) << "'.\n";
@@ -168,7 +498,7 @@ int main(int argc, char *argv[])
     }
   }
 
-  if (!lambdaSpec) {
+  if (lambdas.Length() == 0 && startFile == "") {
     std::cerr << argv[0] << ": Required parameter -l missing.\n";
     exit(1);
   }
@@ -183,24 +513,23 @@ int main(int argc, char *argv[])
   }
 
   if (startFile == "") {
+    Gambit::List<Gambit::MixedStrategyProfile<double> > starts;
     for (int i = 1; i <= stopAfter; i++) {
       Gambit::MixedStrategyProfile<double> profile(nfg);
       Randomize(profile);
-      
-      PrintProfile(std::cout, "start", profile);
-
-      Gambit::MixedStrategyProfile<double> br(nfg);
-    
-      double c_delta = .001;
-      
-      do {
-	LogitBR(profile, lambda, br);
-	(Gambit::Vector<double> &) profile =
-	  (((Gambit::Vector<double> &) profile) * (1.0 - c_delta) + 
-	   ((Gambit::Vector<double> &) br) * c_delta);
-      } while (Distance(profile, br) > tol);
-    
-      PrintProfile(std::cout, "QRE", profile);
+      starts.Append(profile);
+    }
+
+    // Blocks are large enough to make use of the batch, and small
+    // enough to keep the workers evenly loaded
+    int blockSize = std::max(1, std::min(64, stopAfter / (4 * numWorkers)));
+    DynamicsTask task(nfg, starts, lambdas, blockSize, tol);
+    try {
+      RunWorkers(task, task.NumTasks(), numWorkers, std::cout, true);
+    }
+    catch (WorkerException &e) {
+      std::cerr << argv[0] << ": " << e.what() << ".\n";
+      return 1;
     }
   }
   else {
@@ -214,21 +543,17 @@ int main(int argc, char *argv[])
 	profile[i] = 0.0001;
       }
     }
-    lambda = x[1];
     double c_delta = .001;
 
-    Gambit::MixedStrategyProfile<double> br(nfg);
-    
+    LogitDynamicsBatch batch(nfg, c_delta, tol);
+    batch.AddMember(profile, x[1]);
     do {
+      batch.GetProfile(0, profile);
       PrintProfile(std::cout, "step", profile);
-      LogitBR(profile, lambda, br);
-      (Gambit::Vector<double> &) profile =
-	(((Gambit::Vector<double> &) profile) * (1.0 - c_delta) + 
-	 ((Gambit::Vector<double> &) br) * c_delta);
-    } while (Distance(profile, br) > tol);
+    } while (batch.Step());
 
+    batch.GetProfile(0, profile);
     PrintProfile(std::cout, "QRE", profile);
   }
 }
 
-
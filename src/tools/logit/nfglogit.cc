@@ -30,15 +30,38 @@ using namespace Gambit;
 
 #include "nfglogit.h"
 
+//----------------------------------------------------------------------------
+//                 StrategicQREPathTracer: Lifecycle
+//----------------------------------------------------------------------------
+
+StrategicQREPathTracer::StrategicQREPathTracer(const MixedStrategyProfile<double> &p_start) 
+  : m_start(p_start), m_stream(&std::cout), m_fullGraph(true), m_binary(false),
+    m_decimals(6), m_thinning(0.0), m_printedLength(-1.0), m_skipped(false)
+{ 
+  SetTargetParam(-1.0);
+  // The equations for each player are a sum-to-one equation followed
+  // by ratio equations; see GetLHS()
+  Array<int> blocks;
+  for (int pl = 1; pl <= p_start.GetGame()->NumPlayers(); pl++) {
+    blocks.Append(p_start.GetGame()->GetPlayer(pl)->NumStrategies());
+  }
+  SetBlocks(blocks);
+}
+
 //----------------------------------------------------------------------------
 //           StrategicQREPathTracer: Wrapper to the tracing engine
 //----------------------------------------------------------------------------
 
 void 
 StrategicQREPathTracer::TraceStrategicPath(const MixedStrategyProfile<double> &p_start,
+					   std::ostream &p_stream,
 					   double p_startLambda, double p_maxLambda, 
 					   double p_omega)
 {
+  m_stream = &p_stream;
+  m_printedLength = -1.0;
+  m_skipped = false;
+
   Vector<double> x(p_start.Length() + 1);
   for (int i = 1; i <= p_start.Length(); i++) {
     x[i] = log(p_start[i]);
@@ -49,7 +72,7 @@ StrategicQREPathTracer::TraceStrategicPath(const MixedStrategyProfile<double> &p
     while (x[x.Length()] < p_maxLambda) {
       TracePath(x, p_maxLambda, p_omega);
       if (x[x.Length()] < p_maxLambda) {
-	std::cout << std::endl;
+	PrintBreak(p_stream);
       }
     }
   }
@@ -58,6 +81,29 @@ StrategicQREPathTracer::TraceStrategicPath(const MixedStrategyProfile<double> &p
   }
 }
 
+void
+StrategicQREPathTracer::ResumeStrategicPath(std::ostream &p_stream,
+					    double p_maxLambda)
+{
+  m_stream = &p_stream;
+  m_printedLength = -1.0;
+  m_skipped = false;
+  Vector<double> x(m_start.Length() + 1);
+  ResumePath(x, p_maxLambda);
+}
+
+bool
+StrategicQREPathTracer::EvaluateStrategicPath(std::ostream &p_stream,
+					      double p_lambda)
+{
+  Vector<double> x(m_start.Length() + 1);
+  if (!EvaluatePath(p_lambda, x)) {
+    return false;
+  }
+  PrintProfile(p_stream, x, false);
+  return true;
+}
+
 //----------------------------------------------------------------------------
 //             StrategicQREPathTracer: Providing virtual functions
 //----------------------------------------------------------------------------
@@ -231,6 +277,28 @@ StrategicQREPathTracer::PrintProfile(std::ostream &p_stream,
 				     const Vector<double> &x,
 				     bool p_isTerminal)
 {
+  if (m_binary) {
+    // A record is the number of doubles following, negated for the
+    // terminal point, then lambda, the profile, and in MLE mode the
+    // log-likelihood.  A record of length zero ends a branch.
+    Array<double> values(x.Length() + ((IsMLEMode()) ? 1 : 0));
+    values[1] = x[x.Length()];
+    for (int i = 1; i < x.Length(); i++) {
+      values[i+1] = exp(x[i]);
+    }
+    if (IsMLEMode()) {
+      MixedStrategyProfile<double> profile(m_start);
+      for (int i = 1; i <= profile.Length(); i++) {
+	profile[i] = exp(x[i]);
+      }
+      values[values.Length()] = LogLike(profile);
+    }
+    int count = (p_isTerminal) ? -values.Length() : values.Length();
+    p_stream.write((const char *) &count, sizeof(int));
+    p_stream.write((const char *) &values[1], values.Length() * sizeof(double));
+    return;
+  }
+
   p_stream.setf(std::ios::fixed);
   // By convention, we output lambda first
   if (!p_isTerminal) {
@@ -259,12 +327,42 @@ StrategicQREPathTracer::PrintProfile(std::ostream &p_stream,
   p_stream << std::endl;
 }
 
+void
+StrategicQREPathTracer::PrintBreak(std::ostream &p_stream)
+{
+  if (m_binary) {
+    int count = 0;
+    p_stream.write((const char *) &count, sizeof(int));
+  }
+  else {
+    p_stream << std::endl;
+  }
+}
+
 void 
 StrategicQREPathTracer::OnStep(const Vector<double> &x, bool p_isTerminal = false)
 {
-  if ((m_fullGraph && !p_isTerminal) || (!m_fullGraph && p_isTerminal)) {
-    PrintProfile(std::cout, x, p_isTerminal);
+  if (!m_fullGraph) {
+    if (p_isTerminal) {
+      PrintProfile(*m_stream, x, true);
+    }
+    return;
+  }
+
+  if (!p_isTerminal) {
+    if (m_thinning > 0.0 && m_printedLength >= 0.0 &&
+	GetPathLength() - m_printedLength < m_thinning) {
+      m_skipped = true;
+      return;
+    }
+  }
+  else if (!m_skipped) {
+    return;
   }
+  // When thinning, the last point reached is always shown
+  PrintProfile(*m_stream, x, false);
+  m_printedLength = GetPathLength();
+  m_skipped = false;
 }
 
 
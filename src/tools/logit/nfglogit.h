@@ -28,27 +28,44 @@
 
 class StrategicQREPathTracer : public PathTracer {
 public:
-  StrategicQREPathTracer(const MixedStrategyProfile<double> &p_start) 
-    : m_start(p_start), m_fullGraph(true), m_decimals(6)
-    { SetTargetParam(-1.0); }
+  StrategicQREPathTracer(const MixedStrategyProfile<double> &p_start);
   virtual ~StrategicQREPathTracer() { }
 
   void 
   TraceStrategicPath(const MixedStrategyProfile<double> &p_start,
+		     std::ostream &p_stream,
 		     double p_startLambda, double p_maxLambda, double p_omega);
 
+  // Using a recorded path (see PathTracer::ReadPath()), continue it
+  // to p_maxLambda, or compute the equilibrium at p_lambda.  The
+  // latter returns false if that lambda could not be reached.
+  void ResumeStrategicPath(std::ostream &p_stream, double p_maxLambda);
+  bool EvaluateStrategicPath(std::ostream &p_stream, double p_lambda);
+
   void SetFullGraph(bool p_fullGraph) { m_fullGraph = p_fullGraph; }
   bool GetFullGraph(void) const { return m_fullGraph; }
 
   void SetDecimals(int p_decimals) { m_decimals = p_decimals; }
   int GetDecimals(void) const { return m_decimals; }
 
+  // In binary mode, each point is written as a record of doubles; see
+  // PrintProfile()
+  void SetBinary(bool p_binary) { m_binary = p_binary; }
+  bool IsBinary(void) const { return m_binary; }
+
+  // Print only points at least this far apart along the path
+  void SetThinning(double p_thinning) { m_thinning = p_thinning; }
+  double GetThinning(void) const { return m_thinning; }
+
   void SetMLEFrequencies(const Array<double> &p_frequencies)
   { m_frequencies = p_frequencies; }
   const Array<double> &GetMLEFrequencies(void) const { return m_frequencies; }
   
   bool IsMLEMode(void) const { return (m_frequencies.Length() > 0); }
 
+  // Mark the end of a branch in the output
+  void PrintBreak(std::ostream &p_stream);
+
 
 protected:
   virtual void OnStep(const Vector<double> &, bool);
@@ -67,9 +84,12 @@ private:
   double LogLike(const Array<double> &p_point);
 
   MixedStrategyProfile<double> m_start;
-  bool m_fullGraph;
+  std::ostream *m_stream;
+  bool m_fullGraph, m_binary;
   Array<double> m_frequencies;
   int m_decimals;
+  double m_thinning, m_printedLength;
+  bool m_skipped;
   
 };
 
@@ -81,6 +81,54 @@ static void QRDecomp(Matrix<double> &b, Matrix<double> &q)
   }
 }
 
+//
+// Given the factorization q b = r of the transposed Jacobian, with r upper
+// triangular, computes the factorization of the Broyden update of the
+// Jacobian for the step du, over which the LHS changes by dy.  In terms of
+// the transposed Jacobian, this is the rank-one update b + v w^T, with
+// v = du / |du|^2 and w = dy - b^T du.  The update proceeds as in
+// Allgower and Georg, Section 16.3: q v is rotated into a multiple of
+// the first unit vector, leaving r upper Hessenberg; the update is then
+// added to the first row; and r is brought back to triangular form.
+//
+static void BroydenUpdate(Matrix<double> &b, Matrix<double> &q,
+			  const Vector<double> &du, const Vector<double> &dy)
+{
+  double norm2 = du * du;
+  if (norm2 == 0.0) {
+    return;
+  }
+
+  // z = q v, and b^T du = r^T q du = r^T z |du|^2
+  Vector<double> z(q.NumRows());
+  for (int i = 1; i <= q.NumRows(); i++) {
+    z[i] = 0.0;
+    for (int k = 1; k <= q.NumColumns(); k++) {
+      z[i] += q(i, k) * du[k];
+    }
+    z[i] /= norm2;
+  }
+
+  Vector<double> w(dy);
+  for (int j = 1; j <= b.NumColumns(); j++) {
+    for (int i = 1; i <= j; i++) {
+      w[j] -= b(i, j) * z[i] * norm2;
+    }
+  }
+
+  for (int k = b.NumRows() - 1; k >= 1; k--) {
+    Givens(b, q, z[k], z[k+1], k, k + 1, k);
+  }
+
+  for (int j = 1; j <= b.NumColumns(); j++) {
+    b(1, j) += z[1] * w[j];
+  }
+
+  for (int k = 1; k <= b.NumColumns(); k++) {
+    Givens(b, q, b(k, k), b(k+1, k), k, k + 1, k + 1);
+  }
+}
+
 static void NewtonStep(Matrix<double> &q, Matrix<double> &b,
 		       Vector<double> &u, Vector<double> &y,
 		       double &d)
@@ -105,10 +153,337 @@ static void NewtonStep(Matrix<double> &q, Matrix<double> &b,
 }
 
 
+//----------------------------------------------------------------------------
+//                 PathTracer: Block-structured linear algebra
+//----------------------------------------------------------------------------
+
+//
+// The systems traced for quantal response equilibria group the unknowns
+// into blocks (the strategies of a player, or the actions at an
+// information set), with one equation per unknown.  The first equation
+// of a block is its sum-to-one equation; the others are ratio equations,
+// whose coefficients on the unknowns of their own block are -1 on the
+// first unknown, +1 on their own, and zero otherwise.  A set of blocks
+// none of whose equations involve the unknowns of the others can be
+// eliminated in time linear in its size, leaving a dense system only
+// in the remaining unknowns and lambda.
+//
+// BlockSolver factors the Jacobian, bordered by a row vector close to
+// the tangent, in this way.  From the factorization it obtains the tangent
+// at the point, oriented as QRDecomp orients it, and the Newton step
+// orthogonal to that tangent, which is the step NewtonStep computes from
+// the QR factorization.
+//
+class BlockSolver {
+private:
+  Array<int> m_first, m_size;    // the blocks of unknowns
+  Array<bool> m_isElim;          // is the block eliminated?
+  Array<int> m_elim, m_rest;     // unknowns eliminated, and those remaining
+  Array<int> m_elimBlocks;       // blocks eliminated
+  Matrix<double> m_diag;         // coefficients of sum-to-one equations
+  Matrix<double> m_w, m_mfe;     // see Factor()
+  Matrix<double> m_lu;           // LU factors of the reduced system
+  Array<int> m_perm;             // row permutation of the reduced system
+  Vector<double> m_tangent;      // see Factor()
+
+  bool Coupled(const Matrix<double> &b, int k1, int k2) const;
+  void SolveBlocks(Vector<double> &p_rhs) const;
+  void Solve(const Vector<double> &p_rhs, Vector<double> &p_soln) const;
+
+public:
+  // The blocks have the given sizes; p_length includes lambda
+  BlockSolver(const Array<int> &p_sizes, int p_length);
+
+  // Factors the transposed Jacobian b, bordered by p_border.
+  // Returns false if the bordered matrix is (numerically) singular.
+  bool Factor(const Matrix<double> &b, const Vector<double> &p_border);
+
+  const Vector<double> &GetTangent(void) const { return m_tangent; }
+  void NewtonStep(Vector<double> &u, const Vector<double> &y, 
+		  double &d) const;
+  // When bordered by the last unit vector, the Newton step which
+  // leaves lambda unchanged
+  void FixedStep(Vector<double> &u, const Vector<double> &y,
+		 double &d) const;
+};
+
+BlockSolver::BlockSolver(const Array<int> &p_sizes, int p_length)
+  : m_first(p_sizes.Length()), m_size(p_sizes), m_isElim(p_sizes.Length()),
+    m_tangent(p_length)
+{
+  for (int k = 1, i = 1; k <= p_sizes.Length(); i += p_sizes[k++]) {
+    m_first[k] = i;
+  }
+}
+
+bool BlockSolver::Coupled(const Matrix<double> &b, int k1, int k2) const
+{
+  for (int i = m_first[k1]; i < m_first[k1] + m_size[k1]; i++) {
+    for (int j = m_first[k2]; j < m_first[k2] + m_size[k2]; j++) {
+      if (b(i, j) != 0.0 || b(j, i) != 0.0) {
+	return true;
+      }
+    }
+  }
+  return false;
+}
+
+//
+// Solves the equations of the eliminated blocks for their unknowns,
+// in place, taking the other unknowns to be zero.  The ratio equations
+// give x_j = x_1 + r_j, which are substituted into the sum-to-one equation.
+//
+void BlockSolver::SolveBlocks(Vector<double> &p_rhs) const
+{
+  for (int k = 1; k <= m_elimBlocks.Length(); k++) {
+    int first = m_first[m_elimBlocks[k]], size = m_size[m_elimBlocks[k]];
+    double sum = 0.0, x1 = p_rhs[first];
+    for (int j = 0; j < size; j++) {
+      sum += m_diag(k, j + 1);
+      if (j > 0) {
+	x1 -= m_diag(k, j + 1) * p_rhs[first + j];
+      }
+    }
+    x1 /= sum;
+    p_rhs[first] = x1;
+    for (int j = 1; j < size; j++) {
+      p_rhs[first + j] += x1;
+    }
+  }
+}
+
+//
+// Writing the bordered matrix with the eliminated unknowns and equations
+// first, as [ D  C ; E  F ] with D block diagonal, the factorization
+// consists of W = D^-1 C, and the LU factors of the Schur complement
+// F - E W.  m_mfe holds E.
+//
+bool BlockSolver::Factor(const Matrix<double> &b, 
+			 const Vector<double> &p_border)
+{
+  int n = b.NumRows();
+
+  // Choose the blocks to eliminate greedily, largest first
+  Array<int> order(m_size.Length());
+  for (int k = 1; k <= order.Length(); k++) {
+    order[k] = k;
+    m_isElim[k] = false;
+  }
+  for (int k = 2; k <= order.Length(); k++) {
+    for (int l = k; l > 1 && m_size[order[l]] > m_size[order[l-1]]; l--) {
+      std::swap(order[l], order[l-1]);
+    }
+  }
+  m_elimBlocks = Array<int>();
+  for (int k = 1; k <= order.Length(); k++) {
+    bool coupled = false;
+    for (int l = 1; !coupled && l <= m_elimBlocks.Length(); l++) {
+      coupled = Coupled(b, order[k], m_elimBlocks[l]);
+    }
+    if (!coupled) {
+      m_elimBlocks.Append(order[k]);
+      m_isElim[order[k]] = true;
+    }
+  }
+
+  m_elim = Array<int>();
+  m_rest = Array<int>();
+  for (int k = 1; k <= m_size.Length(); k++) {
+    for (int i = m_first[k]; i < m_first[k] + m_size[k]; i++) {
+      if (m_isElim[k]) {
+	m_elim.Append(i);
+      }
+      else {
+	m_rest.Append(i);
+      }
+    }
+  }
+  m_rest.Append(n);
+
+  // Orientation of the bordered matrix: the determinant of each
+  // eliminated block is the sum of its sum-to-one coefficients
+  int sign = 1;
+  int maxSize = 0;
+  for (int k = 1; k <= m_elimBlocks.Length(); k++) {
+    maxSize = std::max(maxSize, m_size[m_elimBlocks[k]]);
+  }
+  m_diag = Matrix<double>(m_elimBlocks.Length(), maxSize);
+  for (int k = 1; k <= m_elimBlocks.Length(); k++) {
+    int first = m_first[m_elimBlocks[k]];
+    double sum = 0.0;
+    for (int j = 1; j <= m_size[m_elimBlocks[k]]; j++) {
+      m_diag(k, j) = b(first + j - 1, first);
+      sum += m_diag(k, j);
+    }
+    if (sum == 0.0) {
+      return false;
+    }
+    else if (sum < 0.0) {
+      sign = -sign;
+    }
+  }
+
+  int ne = m_elim.Length(), nr = m_rest.Length();
+  m_w = Matrix<double>(ne, nr);
+  m_mfe = Matrix<double>(nr, ne);
+  Vector<double> col(n);
+  for (int j = 1; j <= nr; j++) {
+    for (int e = 1; e <= ne; e++) {
+      col[m_elim[e]] = b(m_rest[j], m_elim[e]);
+    }
+    SolveBlocks(col);
+    for (int e = 1; e <= ne; e++) {
+      m_w(e, j) = col[m_elim[e]];
+    }
+  }
+  for (int i = 1; i <= nr; i++) {
+    for (int e = 1; e <= ne; e++) {
+      m_mfe(i, e) = ((m_rest[i] == n) ? p_border[m_elim[e]] :
+		     b(m_elim[e], m_rest[i]));
+    }
+  }
+
+  m_lu = Matrix<double>(nr, nr);
+  for (int i = 1; i <= nr; i++) {
+    for (int j = 1; j <= nr; j++) {
+      m_lu(i, j) = ((m_rest[i] == n) ? p_border[m_rest[j]] :
+		    b(m_rest[j], m_rest[i]));
+    }
+    for (int e = 1; e <= ne; e++) {
+      double a = m_mfe(i, e);
+      if (a != 0.0) {
+	for (int j = 1; j <= nr; j++) {
+	  m_lu(i, j) -= a * m_w(e, j);
+	}
+      }
+    }
+  }
+
+  // LU decomposition with partial pivoting
+  m_perm = Array<int>(nr);
+  for (int i = 1; i <= nr; i++) {
+    m_perm[i] = i;
+  }
+  for (int k = 1; k <= nr; k++) {
+    int pivot = k;
+    for (int i = k + 1; i <= nr; i++) {
+      if (fabs(m_lu(i, k)) > fabs(m_lu(pivot, k))) {
+	pivot = i;
+      }
+    }
+    if (m_lu(pivot, k) == 0.0) {
+      return false;
+    }
+    if (pivot != k) {
+      m_lu.SwitchRows(pivot, k);
+      std::swap(m_perm[pivot], m_perm[k]);
+      sign = -sign;
+    }
+    if (m_lu(k, k) < 0.0) {
+      sign = -sign;
+    }
+    for (int i = k + 1; i <= nr; i++) {
+      double l = m_lu(i, k) / m_lu(k, k);
+      m_lu(i, k) = l;
+      if (l != 0.0) {
+	for (int j = k + 1; j <= nr; j++) {
+	  m_lu(i, j) -= l * m_lu(k, j);
+	}
+      }
+    }
+  }
+
+  // The tangent is the solution with the border, scaled and oriented
+  // so that the Jacobian bordered by the tangent has positive determinant
+  Vector<double> rhs(n);
+  rhs = 0.0;
+  rhs[n] = 1.0;
+  Solve(rhs, m_tangent);
+  m_tangent *= sign / sqrt(m_tangent * m_tangent);
+  return true;
+}
+
+void BlockSolver::Solve(const Vector<double> &p_rhs, 
+			Vector<double> &p_soln) const
+{
+  int ne = m_elim.Length(), nr = m_rest.Length();
+
+  p_soln = p_rhs;
+  SolveBlocks(p_soln);
+
+  Vector<double> z(nr);
+  for (int i = 1; i <= nr; i++) {
+    z[i] = p_rhs[m_rest[m_perm[i]]];
+  }
+  for (int i = 1; i <= nr; i++) {
+    for (int e = 1; e <= ne; e++) {
+      z[i] -= m_mfe(m_perm[i], e) * p_soln[m_elim[e]];
+    }
+  }
+  for (int i = 1; i <= nr; i++) {
+    for (int j = 1; j < i; j++) {
+      z[i] -= m_lu(i, j) * z[j];
+    }
+  }
+  for (int i = nr; i >= 1; i--) {
+    for (int j = i + 1; j <= nr; j++) {
+      z[i] -= m_lu(i, j) * z[j];
+    }
+    z[i] /= m_lu(i, i);
+  }
+
+  for (int e = 1; e <= ne; e++) {
+    for (int j = 1; j <= nr; j++) {
+      p_soln[m_elim[e]] -= m_w(e, j) * z[j];
+    }
+  }
+  for (int j = 1; j <= nr; j++) {
+    p_soln[m_rest[j]] = z[j];
+  }
+}
+
+void BlockSolver::NewtonStep(Vector<double> &u, const Vector<double> &y,
+			     double &d) const
+{
+  Vector<double> rhs(u.Length()), s(u.Length());
+  for (int k = 1; k < rhs.Length(); k++) {
+    rhs[k] = y[k];
+  }
+  rhs[rhs.Length()] = 0.0;
+  Solve(rhs, s);
+
+  // Project out the tangent to obtain the step of minimal norm
+  s -= m_tangent * (m_tangent * s);
+  u -= s;
+  d = sqrt(s * s);
+}
+
+void BlockSolver::FixedStep(Vector<double> &u, const Vector<double> &y,
+			    double &d) const
+{
+  Vector<double> rhs(u.Length()), s(u.Length());
+  for (int k = 1; k < rhs.Length(); k++) {
+    rhs[k] = y[k];
+  }
+  rhs[rhs.Length()] = 0.0;
+  Solve(rhs, s);
+  u -= s;
+  d = sqrt(s * s);
+}
+
 //----------------------------------------------------------------------------
 //             PathTracer: Implementation of path-following engine
 //----------------------------------------------------------------------------
 
+void
+PathTracer::NewJacobian(const Vector<double> &p_point,
+			Matrix<double> &b, Matrix<double> &q)
+{
+  GetJacobian(p_point, b);
+  QRDecomp(b, q);
+  m_numJacobians++;
+}
+
 void 
 PathTracer::TracePath(Vector<double> &x,
 		      double p_maxLambda, double &p_omega)
@@ -124,17 +499,51 @@ PathTracer::TracePath(Vector<double> &x,
   
   bool newton = false;             // using Newton steplength (for zero-finding)
 
+  // In quasi-Newton mode, set when the corrector has done poorly using
+  // an updated factorization, so that the next step starts from the
+  // true Jacobian at x
+  bool refresh = false;
+
   Vector<double> u(x.Length()), restart(x.Length());
   // t is current tangent at x; newT is tangent at u, which is the next point.
   Vector<double> t(x.Length()), newT(x.Length());
   Vector<double> y(x.Length() - 1);
   Matrix<double> b(x.Length(), x.Length() - 1);
   SquareMatrix<double> q(x.Length());
-
-  OnStep(x, false);
-  GetJacobian(x, b);
-  QRDecomp(b, q);
-  q.GetRow(q.NumRows(), t);
+  // Previous corrector point and LHS there, for Broyden updates
+  Vector<double> uOld(x.Length()), yOld(x.Length() - 1);
+
+  // When the system declares its blocks, the Jacobian is factored by
+  // block elimination, except in quasi-Newton mode, which updates the
+  // QR factorization.  If the bordered matrix turns out to be singular,
+  // the QR factorization is used for that step.
+  bool useBlocks = m_blockElimination && m_blocks.Length() > 0 && !m_quasiNewton;
+  bool blocked = false;            // is the current factorization by blocks?
+  BlockSolver solver(m_blocks, x.Length());
+
+  // When resuming, the starting point was reported by the earlier run
+  if (!m_resuming) {
+    OnStep(x, false);
+  }
+  if (useBlocks) {
+    Vector<double> border(x.Length());
+    border = 0.0;
+    border[border.Length()] = 1.0;
+    GetJacobian(x, b);
+    m_numJacobians++;
+    if (solver.Factor(b, border)) {
+      t = solver.GetTangent();
+    }
+    else {
+      QRDecomp(b, q);
+      q.GetRow(q.NumRows(), t);
+    }
+  }
+  else {
+    NewJacobian(x, b, q);
+    q.GetRow(q.NumRows(), t);
+  }
+  RecordPoint(x, t, p_omega, h);
   
   while (x[x.Length()] >= 0.0 && x[x.Length()] < p_maxLambda) {
     bool accept = true;
@@ -147,14 +556,43 @@ PathTracer::TracePath(Vector<double> &x,
       return;
     }
 
+    if (refresh) {
+      NewJacobian(x, b, q);
+      q.GetRow(q.NumRows(), newT);
+      if (t * newT < 0.0) {
+	// The updated and the true factorizations orient the curve
+	// differently; keep going in the same direction
+	p_omega = -p_omega;
+      }
+      t = newT;
+    }
+
     // Predictor step
     for (int k = 1; k <= x.Length(); k++) {
       u[k] = x[k] + h * p_omega * t[k];
     }
 
     double decel = 1.0 / m_maxDecel;  // initialize deceleration factor
-    GetJacobian(u, b);
-    QRDecomp(b, q);
+    double contrDecel = decel;        // part due to contraction rate
+    bool fresh = !m_quasiNewton || refresh;
+    if (useBlocks) {
+      GetJacobian(u, b);
+      m_numJacobians++;
+      blocked = solver.Factor(b, t);
+      if (!blocked) {
+	QRDecomp(b, q);
+      }
+    }
+    else if (!m_quasiNewton) {
+      NewJacobian(u, b, q);
+    }
+    refresh = false;
+
+    // In quasi-Newton mode, the factorization is for the point x, and
+    // the predictor step is the first step used to update it; 
+    // the LHS at x is taken as zero.
+    uOld = x;
+    yOld = 0.0;
 
     int iter = 1;
     double disto = 0.0;
@@ -162,7 +600,17 @@ PathTracer::TracePath(Vector<double> &x,
       double dist;
 
       GetLHS(u, y);
-      NewtonStep(q, b, u, y, dist); 
+      if (m_quasiNewton) {
+	BroydenUpdate(b, q, u - uOld, y - yOld);
+	uOld = u;
+	yOld = y;
+      }
+      if (blocked) {
+	solver.NewtonStep(u, y, dist);
+      }
+      else {
+	NewtonStep(q, b, u, y, dist); 
+      }
 
       if (dist >= c_maxDist) {
 	accept = false;
@@ -176,7 +624,7 @@ PathTracer::TracePath(Vector<double> &x,
 	  accept = false;
 	  break;
 	}
-	decel = std::max(decel, sqrt(contr / c_maxContr) * m_maxDecel);
+	contrDecel = std::max(contrDecel, sqrt(contr / c_maxContr) * m_maxDecel);
       }
 
       if (dist <= c_tol) {
@@ -196,6 +644,12 @@ PathTracer::TracePath(Vector<double> &x,
     }
 
     if (!accept) {
+      if (!fresh) {
+	// Try again with the same stepsize from the true Jacobian
+	refresh = true;
+	continue;
+      }
+
       h /= m_maxDecel;   // PC not accepted; change stepsize and retry
       if (fabs(h) <= c_hmin) {
 	OnStep(x, true);
@@ -209,13 +663,26 @@ PathTracer::TracePath(Vector<double> &x,
       continue;
     }
 
-    // Determine new stepsize
+    // Determine new stepsize.  Slow contraction using an updated
+    // factorization is put down to the updates, rather than to the
+    // stepsize, and the Jacobian is evaluated afresh for the next step.
+    if (!fresh && contrDecel > 1.0) {
+      refresh = true;
+    }
+    else {
+      decel = std::max(decel, contrDecel);
+    }
     if (decel > m_maxDecel) {
       decel = m_maxDecel;
     }
 
     // Obtain the tangent at the next step
-    q.GetRow(q.NumRows(), newT); 
+    if (blocked) {
+      newT = solver.GetTangent();
+    }
+    else {
+      q.GetRow(q.NumRows(), newT); 
+    }
 
     if (!newton &&
 	Criterion(x, t) * Criterion(u, newT) < 0.0) {
@@ -233,6 +700,8 @@ PathTracer::TracePath(Vector<double> &x,
     }
 
     // PC step was successful; update and iterate
+    m_numSteps++;
+    m_pathLength += sqrt((u - x) * (u - x));
     x = u;
     OnStep(x, false);
 
@@ -243,6 +712,7 @@ PathTracer::TracePath(Vector<double> &x,
       p_omega = -p_omega;
     }
     t = newT;
+    RecordPoint(x, t, p_omega, h);
   }
 
   OnStep(x, true);
@@ -251,3 +721,199 @@ PathTracer::TracePath(Vector<double> &x,
   }
 }
 
+//----------------------------------------------------------------------------
+//                   PathTracer: Recording and reusing paths
+//----------------------------------------------------------------------------
+
+void PathTracer::RecordPoint(const Vector<double> &p_x,
+			     const Vector<double> &p_t,
+			     double p_omega, double p_h)
+{
+  if (!m_recordPath) {
+    return;
+  }
+  m_omega = p_omega;
+  m_hFinal = p_h;
+  // When resuming, the starting point is already the last one recorded
+  if (m_points.Length() > 0 && m_points[m_points.Length()] == p_x) {
+    return;
+  }
+  m_points.Append(p_x);
+  m_tangents.Append(p_t * p_omega);
+}
+
+//
+// The path is written as comma-separated values.  The first line gives
+// the number of unknowns (including lambda), the orientation, and the
+// stepsize at the end of the path; each following line gives a point on
+// the path, then the tangent there.
+//
+void PathTracer::WritePath(std::ostream &p_stream)
+{
+  std::streamsize precision = p_stream.precision(17);
+  int length = (m_points.Length() > 0) ? m_points[1].Length() : 0;
+  p_stream << length << "," << m_omega << "," << m_hFinal << std::endl;
+  for (int i = 1; i <= m_points.Length(); i++) {
+    const Vector<double> &x = m_points[i], &t = m_tangents[i];
+    for (int k = 1; k <= x.Length(); k++) {
+      p_stream << x[k] << ",";
+    }
+    for (int k = 1; k <= t.Length(); k++) {
+      p_stream << t[k] << ((k < t.Length()) ? "," : "");
+    }
+    p_stream << std::endl;
+  }
+  p_stream.precision(precision);
+}
+
+bool PathTracer::ReadPath(std::istream &p_stream, int p_length)
+{
+  m_points = List<Vector<double> >();
+  m_tangents = List<Vector<double> >();
+
+  std::string line;
+  bool header = true;
+  while (std::getline(p_stream, line)) {
+    if (line.find_first_not_of(" \t\r") == std::string::npos) {
+      continue;
+    }
+    for (std::string::iterator c = line.begin(); c != line.end(); ++c) {
+      if (*c == ',') *c = ' ';
+    }
+    std::istringstream fields(line);
+    if (header) {
+      int length;
+      if (!(fields >> length >> m_omega >> m_hFinal) || length != p_length) {
+	return false;
+      }
+      header = false;
+      continue;
+    }
+
+    Vector<double> x(p_length), t(p_length);
+    for (int k = 1; k <= p_length; k++) {
+      if (!(fields >> x[k])) {
+	return false;
+      }
+    }
+    for (int k = 1; k <= p_length; k++) {
+      if (!(fields >> t[k])) {
+	return false;
+      }
+    }
+    m_points.Append(x);
+    m_tangents.Append(t);
+  }
+  return (m_points.Length() > 0);
+}
+
+void PathTracer::ResumePath(Vector<double> &p_x, double p_maxLambda)
+{
+  p_x = m_points[m_points.Length()];
+  double omega = m_omega;
+  double hStart = m_hStart;
+  m_hStart = m_hFinal;
+  bool record = m_recordPath;
+  m_recordPath = true;
+  m_resuming = true;
+  TracePath(p_x, p_maxLambda, omega);
+  m_resuming = false;
+  m_recordPath = record;
+  m_hStart = hStart;
+}
+
+//
+// Newton's method on the system with lambda held at its value in p_x.
+// The Jacobian is bordered by the last unit vector, so that the
+// correction leaves lambda unchanged.
+//
+bool PathTracer::CorrectAtLambda(Vector<double> &p_x)
+{
+  const double c_tol = 1.0e-10;    // tolerance for corrector iteration
+  const double c_maxDist = 0.4;    // maximal length of a corrector step
+  const int c_maxIter = 50;        // maximum iterations in corrector
+
+  Vector<double> y(p_x.Length() - 1), border(p_x.Length());
+  Matrix<double> b(p_x.Length(), p_x.Length() - 1);
+  BlockSolver solver(m_blocks, p_x.Length());
+  border = 0.0;
+  border[border.Length()] = 1.0;
+
+  for (int iter = 1; iter <= c_maxIter; iter++) {
+    GetLHS(p_x, y);
+    GetJacobian(p_x, b);
+    m_numJacobians++;
+    if (!solver.Factor(b, border)) {
+      return false;
+    }
+    double dist;
+    solver.FixedStep(p_x, y, dist);
+    if (dist >= c_maxDist) {
+      return false;
+    }
+    if (dist <= c_tol) {
+      return true;
+    }
+  }
+  return false;
+}
+
+//
+// Interpolates over a segment of the recorded path by the cubic Hermite
+// polynomial matching the points and tangents at its ends, in a parameter
+// scaled by the length of the chord.  Tangents are taken in the direction
+// of the chord, as the secant steps used to locate a target lambda may
+// have traversed the segment backwards.
+//
+bool PathTracer::EvaluatePath(double p_lambda, Vector<double> &p_x)
+{
+  int n = m_points.Length();
+  if (n == 0) {
+    return false;
+  }
+  int last = m_points[1].Length();
+
+  for (int i = 1; i < n; i++) {
+    Vector<double> x0(m_points[i]), x1(m_points[i+1]);
+    double f0 = x0[last] - p_lambda, f1 = x1[last] - p_lambda;
+    if (f0 * f1 > 0.0) {
+      continue;
+    }
+
+    Vector<double> chord(x1 - x0);
+    double length = sqrt(chord * chord);
+    if (length == 0.0) {
+      continue;
+    }
+    Vector<double> t0(m_tangents[i]), t1(m_tangents[i+1]);
+    if (t0 * chord < 0.0)  t0 *= -1.0;
+    if (t1 * chord < 0.0)  t1 *= -1.0;
+    t0 *= length;
+    t1 *= length;
+
+    // Locate the crossing of the interpolated lambda by bisection
+    double lo = 0.0, hi = 1.0, s = 0.0;
+    for (int iter = 0; iter < 60; iter++) {
+      s = 0.5 * (lo + hi);
+      double h00 = (2.0 * s - 3.0) * s * s + 1.0, h10 = ((s - 2.0) * s + 1.0) * s;
+      double h01 = (3.0 - 2.0 * s) * s * s, h11 = (s - 1.0) * s * s;
+      double f = (h00 * x0[last] + h10 * t0[last] + 
+		  h01 * x1[last] + h11 * t1[last]) - p_lambda;
+      if (f * f0 > 0.0) {
+	lo = s;
+      }
+      else {
+	hi = s;
+      }
+    }
+
+    double h00 = (2.0 * s - 3.0) * s * s + 1.0, h10 = ((s - 2.0) * s + 1.0) * s;
+    double h01 = (3.0 - 2.0 * s) * s * s, h11 = (s - 1.0) * s * s;
+    for (int k = 1; k <= last; k++) {
+      p_x[k] = h00 * x0[k] + h10 * t0[k] + h01 * x1[k] + h11 * t1[k];
+    }
+    p_x[last] = p_lambda;
+    return CorrectAtLambda(p_x);
+  }
+  return false;
+}
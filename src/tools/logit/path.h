@@ -30,6 +30,17 @@ using namespace Gambit;
 // It is based on the ideas and codes presented in Allgower and Georg's
 // _Numerical Continuation Methods_.
 //
+// By default, the Jacobian is evaluated and factored afresh at each
+// predicted point.  In quasi-Newton mode, the factorization is instead
+// carried along the path by Broyden rank-one updates (Allgower and Georg,
+// Chapter 7), and the Jacobian is only evaluated again when the corrector
+// fails to contract using the updated factorization.
+//
+// Systems whose unknowns fall into blocks with sum-to-one and ratio
+// equations, as the logit systems do, can declare them with SetBlocks().
+// The Jacobian is then factored by eliminating blocks which do not
+// interact, so that dense linear algebra is only needed on the remainder.
+//
 class PathTracer {
 public:
   void SetMaxDecel(double p_maxDecel) { m_maxDecel = p_maxDecel; }
@@ -41,13 +52,55 @@ public:
   void SetTargetParam(double p_targetParam) { m_targetParam = p_targetParam; }
   double GetTargetParam(void) const { return m_targetParam; }
 
+  void SetQuasiNewton(bool p_quasiNewton) { m_quasiNewton = p_quasiNewton; }
+  bool IsQuasiNewton(void) const { return m_quasiNewton; }
+
+  void SetBlockElimination(bool p_block) { m_blockElimination = p_block; }
+  bool IsBlockElimination(void) const { return m_blockElimination; }
+
+  // Statistics on the paths traced so far
+  int NumJacobians(void) const { return m_numJacobians; }
+  int NumSteps(void) const { return m_numSteps; }
+  double GetPathLength(void) const { return m_pathLength; }
+
+  // Recording the path.  When recording is on, each accepted point is
+  // kept together with its tangent, oriented in the direction of travel.
+  // A recorded path can be written out, and read back in to evaluate
+  // points on it, or to continue tracing from its last point.
+  void SetRecordPath(bool p_record) { m_recordPath = p_record; }
+  bool IsRecordPath(void) const { return m_recordPath; }
+  int NumPathPoints(void) const { return m_points.Length(); }
+  void WritePath(std::ostream &p_stream);
+  // Returns false if the stream does not hold a path of the right length
+  bool ReadPath(std::istream &p_stream, int p_length);
+
 protected:
-  PathTracer(void) : m_maxDecel(1.1), m_hStart(0.03), m_targetParam(0.0) 
+  PathTracer(void) : m_maxDecel(1.1), m_hStart(0.03), m_targetParam(0.0),
+		     m_quasiNewton(false), m_blockElimination(true),
+		     m_numJacobians(0), m_numSteps(0), m_pathLength(0.0),
+		     m_recordPath(false), m_resuming(false),
+		     m_omega(1.0), m_hFinal(0.03)
     { } 
   virtual ~PathTracer() { }
 
   void TracePath(Vector<double> &p_x, double p_maxLambda, double &p_omega);
 
+  // Continue tracing from the end of the recorded path, which must
+  // not be empty
+  void ResumePath(Vector<double> &p_x, double p_maxLambda);
+
+  // Compute the point on the recorded path at p_lambda, by interpolating
+  // between the recorded points and then applying Newton's method
+  // with lambda held fixed.  The first crossing of p_lambda along the
+  // path is found.  Returns false if the recorded path does not
+  // reach p_lambda, or if the corrector fails.
+  bool EvaluatePath(double p_lambda, Vector<double> &p_x);
+
+  // Declare the sizes of the blocks of unknowns, in order.  The first
+  // equation of each block must be its sum-to-one equation, and the
+  // rest ratio equations relative to the first unknown of the block.
+  void SetBlocks(const Array<int> &p_blocks) { m_blocks = p_blocks; }
+
   // Criterion function: path tracer attempts to compute a zero of this function.
   virtual double Criterion(const Vector<double> &p_point, 
 			   const Vector<double> &p_tangent) { return -1.0; }
@@ -62,6 +115,22 @@ protected:
 
 private:
   double m_maxDecel, m_hStart, m_targetParam;
+  bool m_quasiNewton, m_blockElimination;
+  Array<int> m_blocks;
+  int m_numJacobians, m_numSteps;
+  double m_pathLength;
+  bool m_recordPath;
+  bool m_resuming;              // is TracePath continuing a recorded path?
+  List<Vector<double> > m_points, m_tangents;
+  double m_omega, m_hFinal;     // orientation and stepsize at path end
+
+  void RecordPoint(const Vector<double> &p_x, const Vector<double> &p_t,
+		   double p_omega, double p_h);
+  bool CorrectAtLambda(Vector<double> &p_x);
+
+  // Evaluate the Jacobian at the point, and factor it into b and q
+  void NewJacobian(const Vector<double> &p_point,
+		   Matrix<double> &b, Matrix<double> &q);
 };
 
 #endif  // PATH_H
@@ -22,12 +22,13 @@
 //
 
 #include <iostream>
+#include <iomanip>
 #include <cstdlib>
 #include <unistd.h>
 #include "libgambit/libgambit.h"
+#include "nfglp.h"
 
 template <class T> void SolveExtensive(const Gambit::Game &p_game);
-template <class T> void SolveStrategic(const Gambit::Game &p_game);
 
 void PrintBanner(std::ostream &p_stream)
 {
@@ -54,6 +55,47 @@ void PrintHelp(char *progname)
 
 int g_numDecimals = 6;
 
+void PrintProfile(std::ostream &p_stream,
+		  const std::string &p_label,
+		  const Gambit::MixedStrategyProfile<double> &p_profile)
+{
+  p_stream << p_label;
+  for (int i = 1; i <= p_profile.Length(); i++) {
+    p_stream.setf(std::ios::fixed);
+    p_stream << "," << std::setprecision(g_numDecimals) << p_profile[i];
+  }
+
+  p_stream << std::endl;
+}
+
+void PrintProfile(std::ostream &p_stream,
+		  const std::string &p_label,
+		  const Gambit::MixedStrategyProfile<Gambit::Rational> &p_profile)
+{
+  p_stream << p_label;
+  for (int i = 1; i <= p_profile.Length(); i++) {
+    p_stream << "," << p_profile[i];
+  }
+
+  p_stream << std::endl;
+}
+
+//
+// Prints the equilibrium of the strategic game when it is found
+//
+class StreamObserver : public Gambit::NashObserver {
+private:
+  std::ostream &m_stream;
+
+public:
+  StreamObserver(std::ostream &p_stream) : m_stream(p_stream) { }
+
+  void OnProfile(const Gambit::MixedStrategyProfile<double> &p_profile)
+  { PrintProfile(m_stream, "NE", p_profile); }
+  void OnProfile(const Gambit::MixedStrategyProfile<Gambit::Rational> &p_profile)
+  { PrintProfile(m_stream, "NE", p_profile); }
+};
+
 int main(int argc, char *argv[])
 {
   int c;
@@ -107,11 +149,12 @@ int main(int argc, char *argv[])
     if (!game->IsTree() || useStrategic) {
       game->BuildComputedValues();
     
+      StreamObserver observer(std::cout);
       if (useFloat) {
-	SolveStrategic<double>(game);
+	LpStrategySolve<double>(game, observer);
       }
       else {
-	SolveStrategic<Gambit::Rational>(game);
+	LpStrategySolve<Gambit::Rational>(game, observer);
       }
     }
     else {
@@ -21,15 +21,12 @@
 // Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 //
 
-#include <unistd.h>
-#include <iostream>
 #include "libgambit/libgambit.h"
 #include "liblinear/lpsolve.h"
+#include "nfglp.h"
 
 using namespace Gambit;
 
-extern int g_numDecimals;
-
 //
 // The routine to actually solve the LP
 // This routine takes an LP of the form
@@ -77,32 +74,6 @@ SolveLP(const Matrix<T> &A, const Vector<T> &b, const Vector<T> &c,
   }
 }
 
-void PrintProfile(std::ostream &p_stream,
-		  const std::string &p_label,
-		  const MixedStrategyProfile<double> &p_profile)
-{
-  p_stream << p_label;
-  for (int i = 1; i <= p_profile.Length(); i++) {
-    p_stream.setf(std::ios::fixed);
-    p_stream << "," << std::setprecision(g_numDecimals) << p_profile[i];
-  }
-
-  p_stream << std::endl;
-}
-
-void PrintProfile(std::ostream &p_stream,
-		  const std::string &p_label,
-		  const MixedStrategyProfile<Rational> &p_profile)
-{
-  p_stream << p_label;
-  for (int i = 1; i <= p_profile.Length(); i++) {
-    p_stream << "," << p_profile[i];
-  }
-
-  p_stream << std::endl;
-}
-
-
 //
 // Convert the LP solution represented by the vectors
 // (p_primal, p_dual) back to a strategy profile.
@@ -111,9 +82,10 @@ void PrintProfile(std::ostream &p_stream,
 //
 
 template <class T>
-void PrintSolution(const StrategySupport &p_support,
-		   const Array<T> &p_primal,
-		   const Array<T> &p_dual)
+void ReportSolution(const StrategySupport &p_support,
+		    const Array<T> &p_primal,
+		    const Array<T> &p_dual,
+		    NashObserver &p_observer)
 {
   int n1 = p_support.NumStrategies(1);
   int n2 = p_support.NumStrategies(2);
@@ -128,16 +100,16 @@ void PrintSolution(const StrategySupport &p_support,
     profile[p_support.GetStrategy(2, j)] = p_dual[j];
   }
 
-  PrintProfile(std::cout, "NE", profile);
+  p_observer.OnProfile(profile);
 }
 
 
 //
-// Compute and print one equilibrium by solving a linear program based
+// Compute and report one equilibrium by solving a linear program based
 // on the strategic game representation.
 //
 template <class T>
-void SolveStrategic(const Game &p_game)
+void LpStrategySolve(const Game &p_game, NashObserver &p_observer)
 {
   StrategySupport support(p_game);
 
@@ -171,9 +143,9 @@ void SolveStrategic(const Game &p_game)
   
   Array<T> primal(A.NumColumns()), dual(A.NumRows());
   if (SolveLP(A, b, c, 1, primal, dual)) {
-    PrintSolution(support, primal, dual);
+    ReportSolution(support, primal, dual, p_observer);
   }
 }
 
-template void SolveStrategic<double>(const Game &);
-template void SolveStrategic<Rational>(const Game &);
+template void LpStrategySolve<double>(const Game &, NashObserver &);
+template void LpStrategySolve<Rational>(const Game &, NashObserver &);
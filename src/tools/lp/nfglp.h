@@ -0,0 +1,35 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2010, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/tools/lp/nfglp.h
+// Compute Nash equilibria via linear programming
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef NFGLP_H
+#define NFGLP_H
+
+#include "libgambit/libgambit.h"
+#include "libgambit/nash.h"
+
+// Compute one equilibrium of the two-player constant-sum strategic game
+// p_game by solving a linear program, and pass it to the observer
+template <class T>
+void LpStrategySolve(const Gambit::Game &p_game,
+		     Gambit::NashObserver &p_observer);
+
+#endif  // NFGLP_H
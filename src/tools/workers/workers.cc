@@ -0,0 +1,252 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2010, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/tools/workers/workers.cc
+// Distributing independent subproblems over worker processes
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <sstream>
+#include <string>
+#include <cstdlib>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <signal.h>
+
+#include "workers.h"
+
+//
+// Workers read the indices to work on from a pipe, as native integers,
+// until they read zero.  The output for each index is written back on
+// a second pipe, followed by a null character to mark that the worker
+// is ready for another index.
+//
+
+static bool WriteAll(int p_fd, const char *p_data, size_t p_length)
+{
+  while (p_length > 0) {
+    ssize_t n = write(p_fd, p_data, p_length);
+    if (n <= 0)  return false;
+    p_data += n;
+    p_length -= n;
+  }
+  return true;
+}
+
+static bool ReadAll(int p_fd, char *p_data, size_t p_length)
+{
+  while (p_length > 0) {
+    ssize_t n = read(p_fd, p_data, p_length);
+    if (n <= 0)  return false;
+    p_data += n;
+    p_length -= n;
+  }
+  return true;
+}
+
+static void RunWorker(IndexedTask &p_task, int p_input, int p_output)
+{
+  int index;
+  while (ReadAll(p_input, (char *) &index, sizeof(int)) && index > 0) {
+    std::ostringstream stream;
+    try {
+      p_task.Run(index, stream);
+    }
+    catch (...) {
+      std::cerr << "Error: An internal error occurred.\n";
+    }
+    std::string output = stream.str();
+    if (!WriteAll(p_output, output.c_str(), output.length() + 1))  break;
+  }
+}
+
+namespace {
+
+class Worker {
+public:
+  pid_t m_pid;
+  int m_input, m_output;
+  std::string m_buffer;
+  int m_index;
+  bool m_active, m_busy;
+};
+
+}
+
+static void ClosePipe(int p_fds[2])
+{
+  close(p_fds[0]);
+  close(p_fds[1]);
+}
+
+//
+// Stops the first p_numStarted workers, when the others cannot be
+// started.  They have not been given any work yet.
+//
+static void StopWorkers(Gambit::Array<Worker> &p_workers, int p_numStarted)
+{
+  for (int w = 1; w <= p_numStarted; w++) {
+    close(p_workers[w].m_input);
+    close(p_workers[w].m_output);
+    kill(p_workers[w].m_pid, SIGKILL);
+    waitpid(p_workers[w].m_pid, 0, 0);
+  }
+}
+
+void RunWorkers(IndexedTask &p_task, int p_numTasks, int p_numWorkers,
+		std::ostream &p_stream, bool p_inOrder)
+{
+  if (p_numWorkers > p_numTasks)  p_numWorkers = p_numTasks;
+
+  if (p_numWorkers <= 1) {
+    for (int i = 1; i <= p_numTasks; i++) {
+      p_task.Run(i, p_stream);
+    }
+    return;
+  }
+
+  // Anything still buffered would otherwise be written by each worker
+  p_stream.flush();
+  std::cout.flush();
+  std::cerr.flush();
+  // A worker which dies is detected when reading its output instead
+  signal(SIGPIPE, SIG_IGN);
+
+  Gambit::Array<Worker> workers(p_numWorkers);
+  for (int w = 1; w <= p_numWorkers; w++) {
+    int toWorker[2], fromWorker[2];
+    if (pipe(toWorker) != 0) {
+      StopWorkers(workers, w - 1);
+      throw WorkerException();
+    }
+    if (pipe(fromWorker) != 0) {
+      ClosePipe(toWorker);
+      StopWorkers(workers, w - 1);
+      throw WorkerException();
+    }
+    pid_t pid = fork();
+    if (pid < 0) {
+      ClosePipe(toWorker);
+      ClosePipe(fromWorker);
+      StopWorkers(workers, w - 1);
+      throw WorkerException();
+    }
+    else if (pid == 0) {
+      // Close the ends of the pipes of the other workers, so that they
+      // see end-of-file if the main process goes away
+      for (int v = 1; v < w; v++) {
+	close(workers[v].m_input);
+	close(workers[v].m_output);
+      }
+      close(toWorker[1]);
+      close(fromWorker[0]);
+      RunWorker(p_task, toWorker[0], fromWorker[1]);
+      _exit(0);
+    }
+    close(toWorker[0]);
+    close(fromWorker[1]);
+    workers[w].m_pid = pid;
+    workers[w].m_input = toWorker[1];
+    workers[w].m_output = fromWorker[0];
+    workers[w].m_active = true;
+    workers[w].m_busy = true;
+  }
+
+  int next = 1, numActive = p_numWorkers;
+  for (int w = 1; w <= p_numWorkers; w++, next++) {
+    workers[w].m_index = next;
+    WriteAll(workers[w].m_input, (const char *) &next, sizeof(int));
+  }
+
+  // Outputs which are finished but held back to keep them in order
+  Gambit::Array<std::string> pending(p_numTasks);
+  Gambit::Array<bool> finished(p_numTasks);
+  for (int i = 1; i <= p_numTasks; finished[i++] = false);
+  int nextOutput = 1;
+
+  Gambit::Array<struct pollfd> fds(p_numWorkers);
+  while (numActive > 0) {
+    for (int w = 1; w <= p_numWorkers; w++) {
+      fds[w].fd = (workers[w].m_active) ? workers[w].m_output : -1;
+      fds[w].events = POLLIN;
+      fds[w].revents = 0;
+    }
+    if (poll(&fds[1], p_numWorkers, -1) < 0)  continue;
+
+    for (int w = 1; w <= p_numWorkers; w++) {
+      if (!fds[w].revents)  continue;
+      Worker &worker = workers[w];
+
+      char data[4096];
+      ssize_t n = read(worker.m_output, data, sizeof(data));
+      if (n <= 0) {
+	if (worker.m_busy) {
+	  std::cerr << "Warning: A worker process exited unexpectedly; ";
+	  std::cerr << "its work will be repeated.\n";
+	}
+	worker.m_active = false;
+	numActive--;
+	continue;
+      }
+      worker.m_buffer.append(data, n);
+
+      std::string::size_type end;
+      while ((end = worker.m_buffer.find('\0')) != std::string::npos) {
+	finished[worker.m_index] = true;
+	if (p_inOrder) {
+	  pending[worker.m_index] = worker.m_buffer.substr(0, end);
+	  while (nextOutput <= p_numTasks && finished[nextOutput]) {
+	    p_stream << pending[nextOutput];
+	    pending[nextOutput++] = "";
+	  }
+	}
+	else {
+	  p_stream << worker.m_buffer.substr(0, end);
+	}
+	p_stream.flush();
+	worker.m_buffer.erase(0, end + 1);
+
+	int index = (next <= p_numTasks) ? next++ : 0;
+	worker.m_busy = (index > 0);
+	worker.m_index = index;
+	WriteAll(worker.m_input, (const char *) &index, sizeof(int));
+      }
+    }
+  }
+
+  for (int w = 1; w <= p_numWorkers; w++) {
+    close(workers[w].m_input);
+    close(workers[w].m_output);
+    waitpid(workers[w].m_pid, 0, 0);
+  }
+
+  // Should a worker have died, the index it was working on, and any
+  // indices not yet handed out if all of them did, are run here instead
+  // so that the output is still complete
+  int start = (p_inOrder) ? nextOutput : 1;
+  for (int i = start; i <= p_numTasks; i++) {
+    if (!finished[i]) {
+      p_task.Run(i, p_stream);
+    }
+    else if (p_inOrder) {
+      p_stream << pending[i];
+    }
+  }
+  p_stream.flush();
+}
@@ -0,0 +1,72 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2010, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/tools/workers/workers.h
+// Distributing independent subproblems over worker processes
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef WORKERS_H
+#define WORKERS_H
+
+#include <iostream>
+#include "libgambit/libgambit.h"
+
+//
+// The solvers are not safe to run in several threads of
+// a single process: game objects are shared through handles with
+// unsynchronized reference counts, and parts of the solvers keep
+// their state in static variables.  Instead, independent subproblems
+// (such as the candidate supports in support enumeration) are farmed
+// out to worker processes created by fork(), each of which therefore
+// has its own copy of the game and of all solver workspaces.
+//
+
+/// Exception thrown when the worker processes cannot be started
+class WorkerException : public Gambit::Exception {
+public:
+  virtual ~WorkerException() throw() { }
+  const char *what(void) const throw() 
+  { return "Unable to start worker processes"; }
+};
+
+/// A computation which is carried out for each of a range of indices
+class IndexedTask {
+public:
+  virtual ~IndexedTask() { }
+
+  /// Carry out the computation for the index, writing output to the stream
+  virtual void Run(int p_index, std::ostream &p_stream) = 0;
+};
+
+/// \brief Carry out a task for indices 1 through p_numTasks
+///
+/// The indices are handed out one at a time to p_numWorkers worker
+/// processes as they become idle.  The output for each index is
+/// written to p_stream as soon as the computation for that index is
+/// finished; outputs for different indices are not interleaved, but
+/// appear in order of completion rather than in order of index.
+/// If p_inOrder is set, outputs are instead held back as needed so
+/// that they appear in order of index.
+/// If p_numWorkers is one, the task is run in this process, in order.
+/// Should a worker process die, the index it was working on (and any
+/// not yet handed out, if no workers remain) is run in this process
+/// once the workers are finished, so the output is always complete.
+void RunWorkers(IndexedTask &p_task, int p_numTasks, int p_numWorkers,
+		std::ostream &p_stream, bool p_inOrder = false);
+
+#endif  // WORKERS_H